@@ -29,13 +29,28 @@ G_BEGIN_DECLS
 
 typedef struct                                  _HildonAnimationActorPrivate HildonAnimationActorPrivate;
 
+typedef struct                                  _HildonAnimationActorKeyframe HildonAnimationActorKeyframe;
+
+#define                                         HILDON_AA_N_PARAMS (HILDON_AA_PARAM_OPACITY + 1)
+
 #define                                         HILDON_ANIMATION_ACTOR_GET_PRIVATE(obj) \
                                                 (G_TYPE_INSTANCE_GET_PRIVATE ((obj), \
                                                 HILDON_TYPE_ANIMATION_ACTOR, HildonAnimationActorPrivate));
 
+struct                                          _HildonAnimationActorKeyframe
+{
+    guint      msecs;
+    gdouble    value;
+    HildonAnimationActorEasing easing;
+};
+
 struct                                          _HildonAnimationActorPrivate
 {
     guint      ready : 1;
+    guint      flushing : 1;
+    guint      frame_sync : 1;
+    guint      timeline_playing : 1;
+    guint      timeline_loop : 1;
 
     guint      set_show : 1;
     guint      set_position : 1;
@@ -72,8 +87,24 @@ struct                                          _HildonAnimationActorPrivate
 
     GtkWindow *parent;
     gulong     parent_map_event_cb_id;
+    gulong     parent_unmap_cb_id;
 
     gulong     map_event_cb_id;
+
+    guint      freeze_count;
+    guint      flush_tick_id;
+    guint      messages_sent;
+
+    /* Keyframes of each parameter, sorted by time */
+    GArray    *keyframes[HILDON_AA_N_PARAMS];
+    /* Copy of the keyframes taken when the timeline was started */
+    GArray    *timeline_keyframes[HILDON_AA_N_PARAMS];
+    gdouble    timeline_from[HILDON_AA_N_PARAMS];
+    guint      timeline_duration;
+    gint64     timeline_elapsed;
+    gint64     timeline_last_frame;
+    guint      timeline_tick_id;
+    GtkWidget *timeline_clock;
 };
 
 G_END_DECLS
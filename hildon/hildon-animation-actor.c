@@ -72,6 +72,18 @@
  * convenience functions for the programmer to be able to modify every
  * parameter individually.
  *
+ * Applications changing several parameters at once can group them
+ * between hildon_animation_actor_freeze_updates() and
+ * hildon_animation_actor_thaw_updates(), or let
+ * hildon_animation_actor_set_frame_sync() send them once per frame,
+ * so that a parameter changed several times is only sent once.
+ *
+ * Rather than computing the parameters from a timeout, as the example
+ * below does, an animation can also be described with keyframes, see
+ * hildon_animation_actor_add_keyframe(). The timeline then follows the
+ * frame clock of the parent window, easing every parameter once per
+ * frame, and stands still while the parent window is not mapped.
+ *
  * <example>
  * <title>Basic HildonAnimationActor example</title>
  * <programlisting>
@@ -145,6 +157,7 @@
  * </example>
  */
 
+#include                                        <math.h>
 #include                                        <gdk/gdkx.h>
 #include                                        <X11/Xatom.h>
 
@@ -161,6 +174,8 @@ static void
 hildon_animation_actor_update_ready (HildonAnimationActor *self);
 static void
 hildon_animation_actor_send_pending_messages (HildonAnimationActor *self);
+static gboolean
+hildon_animation_actor_may_send (HildonAnimationActor *self);
 static void
 hildon_animation_actor_send_all_messages (HildonAnimationActor *self);
 static gboolean
@@ -171,6 +186,21 @@ static gboolean
 hildon_animation_actor_map_event (GtkWidget *widget,
 				  GdkEvent *event,
 				  gpointer user_data);
+static void
+hildon_animation_actor_parent_unmap (GtkWidget *parent,
+                                     gpointer user_data);
+static void
+hildon_animation_actor_timeline_pause (HildonAnimationActor *self);
+static void
+hildon_animation_actor_timeline_resume (HildonAnimationActor *self);
+
+enum
+{
+    TIMELINE_FINISHED,
+    LAST_SIGNAL
+};
+
+static guint signals[LAST_SIGNAL] = { 0 };
 
 static guint32 show_atom;
 static guint32 position_atom;
@@ -282,12 +312,24 @@ hildon_animation_actor_finalize                (GObject *object)
     HildonAnimationActor        *self = HILDON_ANIMATION_ACTOR (object);
     HildonAnimationActorPrivate
 	               *priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (self);
+    guint               i;
+
+    hildon_animation_actor_timeline_pause (self);
+
+    for (i = 0; i < HILDON_AA_N_PARAMS; i++)
+    {
+	g_array_free (priv->keyframes[i], TRUE);
+	g_array_free (priv->timeline_keyframes[i], TRUE);
+    }
 
     if (priv->parent)
     {
 	if (priv->parent_map_event_cb_id)
 	    g_signal_handler_disconnect (priv->parent,
 					 priv->parent_map_event_cb_id);
+	if (priv->parent_unmap_cb_id)
+	    g_signal_handler_disconnect (priv->parent,
+					 priv->parent_unmap_cb_id);
 
 	g_object_unref (priv->parent);
     }
@@ -308,6 +350,24 @@ hildon_animation_actor_class_init              (HildonAnimationActorClass *klass
     widget_class->show              = hildon_animation_actor_show;
     widget_class->hide              = hildon_animation_actor_hide;
 
+    /**
+     * HildonAnimationActor::timeline-finished:
+     * @actor: the #HildonAnimationActor which received the signal
+     *
+     * Emitted when a timeline started with
+     * hildon_animation_actor_start_timeline() reaches its last keyframe.
+     * Looping timelines never finish.
+     *
+     * Since: 3.0
+     */
+    signals[TIMELINE_FINISHED] =
+	g_signal_new ("timeline-finished",
+		      G_TYPE_FROM_CLASS (klass),
+		      G_SIGNAL_RUN_LAST,
+		      0, NULL, NULL,
+		      g_cclosure_marshal_VOID__VOID,
+		      G_TYPE_NONE, 0);
+
     g_type_class_add_private (klass, sizeof (HildonAnimationActorPrivate));
 }
 
@@ -316,12 +376,21 @@ hildon_animation_actor_init                    (HildonAnimationActor *self)
 {
     HildonAnimationActorPrivate
 	               *priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (self);
+    guint               i;
 
     /* Default non-zero values for the private variables */
 
     priv->scale_x = 1 << 16;
     priv->scale_y = 1 << 16;
     priv->opacity = 0xff;
+
+    for (i = 0; i < HILDON_AA_N_PARAMS; i++)
+    {
+	priv->keyframes[i] = g_array_new (FALSE, FALSE,
+					  sizeof (HildonAnimationActorKeyframe));
+	priv->timeline_keyframes[i] = g_array_new (FALSE, FALSE,
+						   sizeof (HildonAnimationActorKeyframe));
+    }
 }
 
 /**
@@ -454,6 +523,9 @@ hildon_animation_actor_send_pending_messages (HildonAnimationActor *self)
     HildonAnimationActorPrivate
 	               *priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (self);
 
+    /* Let the setters send right away, whatever the update mode */
+    priv->flushing = 1;
+
     if (priv->set_anchor)
     {
 	if (priv->gravity == 0)
@@ -507,6 +579,8 @@ hildon_animation_actor_send_pending_messages (HildonAnimationActor *self)
     if (priv->set_show)
 	hildon_animation_actor_set_show_full (self,
 					      priv->show, priv->opacity);
+
+    priv->flushing = 0;
 }
 
 static void
@@ -527,6 +601,56 @@ hildon_animation_actor_send_all_messages (HildonAnimationActor *self)
     hildon_animation_actor_send_pending_messages (self);
 }
 
+static gboolean
+hildon_animation_actor_flush_tick (GtkWidget *widget,
+                                   GdkFrameClock *frame_clock,
+                                   gpointer user_data)
+{
+    HildonAnimationActor *self = HILDON_ANIMATION_ACTOR (widget);
+    HildonAnimationActorPrivate
+	               *priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (self);
+
+    priv->flush_tick_id = 0;
+    hildon_animation_actor_send_pending_messages (self);
+
+    return G_SOURCE_REMOVE;
+}
+
+/*
+ * Whether a setter may send its message right away. Outside of
+ * hildon_animation_actor_send_pending_messages(), updates are
+ * held back while frozen, and until the next frame when synchronized
+ * to the frame clock.
+ */
+static gboolean
+hildon_animation_actor_may_send (HildonAnimationActor *self)
+{
+    HildonAnimationActorPrivate
+	               *priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (self);
+    GtkWidget          *widget = GTK_WIDGET (self);
+
+    if (!gtk_widget_get_mapped (widget) || !priv->ready)
+        return FALSE;
+
+    if (priv->flushing)
+        return TRUE;
+
+    if (priv->freeze_count > 0)
+        return FALSE;
+
+    if (priv->frame_sync)
+    {
+        if (!priv->flush_tick_id)
+            priv->flush_tick_id =
+                gtk_widget_add_tick_callback (widget,
+                                              hildon_animation_actor_flush_tick,
+                                              NULL, NULL);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
 /* ------------------------------------------------------------- */
 
 /**
@@ -557,6 +681,8 @@ hildon_animation_actor_send_message (HildonAnimationActor *self,
                                      guint32 l3,
                                      guint32 l4)
 {
+    HildonAnimationActorPrivate
+	               *priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (self);
     GtkWidget          *widget = GTK_WIDGET (self);
     Display            *display = GDK_WINDOW_XDISPLAY (gtk_widget_get_window (widget));
     Window              window = GDK_WINDOW_XID (gtk_widget_get_window (widget));
@@ -593,6 +719,8 @@ hildon_animation_actor_send_message (HildonAnimationActor *self,
              window);
 #endif
 
+    priv->messages_sent++;
+
     XSendEvent (display, window, True,
                 StructureNotifyMask,
                 (XEvent *)&event);
@@ -629,7 +757,6 @@ hildon_animation_actor_set_show_full (HildonAnimationActor *self,
 {
     HildonAnimationActorPrivate
 	               *priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (self);
-    GtkWidget          *widget = GTK_WIDGET (self);
 
     if (opacity > 255)
 	opacity = 255;
@@ -641,7 +768,7 @@ hildon_animation_actor_set_show_full (HildonAnimationActor *self,
     priv->opacity = opacity;
     priv->set_show = 1;
 
-    if (gtk_widget_get_mapped (widget) && priv->ready)
+    if (hildon_animation_actor_may_send (self))
     {
 	/* Defer show messages until the animation actor is parented
 	 * and the parent window is mapped */
@@ -744,14 +871,13 @@ hildon_animation_actor_set_position_full (HildonAnimationActor *self,
 {
     HildonAnimationActorPrivate
 	               *priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (self);
-    GtkWidget          *widget = GTK_WIDGET (self);
 
     priv->position_x = x;
     priv->position_y = y;
     priv->depth = depth;
     priv->set_position = 1;
 
-    if (gtk_widget_get_mapped (widget) && priv->ready)
+    if (hildon_animation_actor_may_send (self))
     {
 	hildon_animation_actor_send_message (self,
 					     position_atom,
@@ -825,13 +951,12 @@ hildon_animation_actor_set_scalex (HildonAnimationActor *self,
 {
     HildonAnimationActorPrivate
 	               *priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (self);
-    GtkWidget          *widget = GTK_WIDGET (self);
 
     priv->scale_x = x_scale;
     priv->scale_y = y_scale;
     priv->set_scale = 1;
 
-    if (gtk_widget_get_mapped (widget) && priv->ready)
+    if (hildon_animation_actor_may_send (self))
     {
 	hildon_animation_actor_send_message (self,
 					     scale_atom,
@@ -895,7 +1020,6 @@ hildon_animation_actor_set_rotationx (HildonAnimationActor *self,
 {
     HildonAnimationActorPrivate
 	               *priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (self);
-    GtkWidget          *widget = GTK_WIDGET (self);
 
     guint mask = 0;
 
@@ -925,7 +1049,7 @@ hildon_animation_actor_set_rotationx (HildonAnimationActor *self,
 
     priv->set_rotation |= mask;
 
-    if (gtk_widget_get_mapped (widget) && priv->ready)
+    if (hildon_animation_actor_may_send (self))
     {
 	hildon_animation_actor_send_message (self,
 					     rotation_atom,
@@ -991,14 +1115,13 @@ hildon_animation_actor_set_anchor (HildonAnimationActor *self,
 {
     HildonAnimationActorPrivate
 	               *priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (self);
-    GtkWidget          *widget = GTK_WIDGET (self);
 
     priv->gravity = 0;
     priv->anchor_x = x;
     priv->anchor_y = y;
     priv->set_anchor = 1;
 
-    if (gtk_widget_get_mapped (widget) && priv->ready)
+    if (hildon_animation_actor_may_send (self))
     {
 	hildon_animation_actor_send_message (self,
 					     anchor_atom,
@@ -1040,12 +1163,11 @@ hildon_animation_actor_set_anchor_from_gravity (HildonAnimationActor *self,
 {
     HildonAnimationActorPrivate
 	               *priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (self);
-    GtkWidget          *widget = GTK_WIDGET (self);
 
     priv->gravity = gravity;
     priv->set_anchor = 1;
 
-    if (gtk_widget_get_mapped (widget) && priv->ready)
+    if (hildon_animation_actor_may_send (self))
     {
 	hildon_animation_actor_send_message (self,
 					     anchor_atom,
@@ -1068,9 +1190,22 @@ hildon_animation_actor_parent_map_event (GtkWidget *parent,
 {
     hildon_animation_actor_set_parent (HILDON_ANIMATION_ACTOR (user_data),
 				       GTK_WINDOW (parent));
+    hildon_animation_actor_timeline_resume (HILDON_ANIMATION_ACTOR (user_data));
     return FALSE;
 }
 
+/*
+ * The parent frame clock stops with the parent window, so the
+ * timeline is paused until the parent is mapped again, rather than
+ * jumping ahead by the time it was hidden.
+ */
+static void
+hildon_animation_actor_parent_unmap (GtkWidget *parent,
+                                     gpointer user_data)
+{
+    hildon_animation_actor_timeline_pause (HILDON_ANIMATION_ACTOR (user_data));
+}
+
 /*
  * This callback will be triggered by the widget re-mapping
  * itself in case of WM restarting. The point is to push all
@@ -1131,7 +1266,6 @@ hildon_animation_actor_set_parent (HildonAnimationActor *self,
 {
     HildonAnimationActorPrivate
 	               *priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (self);
-    GtkWidget          *widget = GTK_WIDGET (self);
 
     gtk_window_set_transient_for (GTK_WINDOW (self), parent);
 
@@ -1141,9 +1275,14 @@ hildon_animation_actor_set_parent (HildonAnimationActor *self,
 
 	if (priv->parent)
 	{
+	    hildon_animation_actor_timeline_pause (self);
+
 	    if (priv->parent_map_event_cb_id)
 		g_signal_handler_disconnect (priv->parent,
 					     priv->parent_map_event_cb_id);
+	    if (priv->parent_unmap_cb_id)
+		g_signal_handler_disconnect (priv->parent,
+					     priv->parent_unmap_cb_id);
 
 	    /* Might need a synchronized "parent(0)" or "parent(new parent)"
 	     * message here before we can safely decrease the reference count. */
@@ -1165,14 +1304,22 @@ hildon_animation_actor_set_parent (HildonAnimationActor *self,
 				  "map-event",
 				  G_CALLBACK(hildon_animation_actor_parent_map_event),
 				  self);
+	    priv->parent_unmap_cb_id =
+		g_signal_connect (G_OBJECT (priv->parent),
+				  "unmap",
+				  G_CALLBACK(hildon_animation_actor_parent_unmap),
+				  self);
+
+	    hildon_animation_actor_timeline_resume (self);
 	}
 	else
 	{
 	    priv->parent_map_event_cb_id = 0;
+	    priv->parent_unmap_cb_id = 0;
 	}
     }
 
-    if (gtk_widget_get_mapped (widget) && priv->ready)
+    if (hildon_animation_actor_may_send (self))
     {
 	Window win = 0;
 
@@ -1218,3 +1365,499 @@ hildon_animation_actor_set_parent (HildonAnimationActor *self,
     }
 }
 
+/**
+ * hildon_animation_actor_freeze_updates:
+ * @self: A #HildonAnimationActor
+ *
+ * Holds back the messages of the animation actor setters until
+ * hildon_animation_actor_thaw_updates() is called, so that properties changed
+ * several times in between are only sent once. Calls nest, and the
+ * messages are sent when the last freeze is thawed.
+ *
+ * Since: 3.0
+ **/
+void
+hildon_animation_actor_freeze_updates (HildonAnimationActor *self)
+{
+    HildonAnimationActorPrivate
+	               *priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (self);
+
+    g_return_if_fail (HILDON_IS_ANIMATION_ACTOR (self));
+
+    priv->freeze_count++;
+}
+
+/**
+ * hildon_animation_actor_thaw_updates:
+ * @self: A #HildonAnimationActor
+ *
+ * Reverts the effect of a previous call to
+ * hildon_animation_actor_freeze_updates(), sending the properties changed
+ * in between once the last freeze is thawed.
+ *
+ * Since: 3.0
+ **/
+void
+hildon_animation_actor_thaw_updates (HildonAnimationActor *self)
+{
+    HildonAnimationActorPrivate
+	               *priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (self);
+
+    g_return_if_fail (HILDON_IS_ANIMATION_ACTOR (self));
+    g_return_if_fail (priv->freeze_count > 0);
+
+    if (--priv->freeze_count == 0 &&
+        gtk_widget_get_mapped (GTK_WIDGET (self)) && priv->ready)
+        hildon_animation_actor_send_pending_messages (self);
+}
+
+/**
+ * hildon_animation_actor_set_frame_sync:
+ * @self: A #HildonAnimationActor
+ * @frame_sync: whether to send the messages once per frame
+ *
+ * When @frame_sync is %TRUE, the animation actor setters only record the
+ * new values, and the properties changed during a frame are sent once
+ * from the frame clock of the animation actor window. An animation updating
+ * several properties of many actors on every frame then sends a
+ * message per changed property and frame, rather than one per call.
+ *
+ * Since: 3.0
+ **/
+void
+hildon_animation_actor_set_frame_sync (HildonAnimationActor *self,
+                                       gboolean frame_sync)
+{
+    HildonAnimationActorPrivate
+	               *priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (self);
+
+    g_return_if_fail (HILDON_IS_ANIMATION_ACTOR (self));
+
+    frame_sync = frame_sync ? 1 : 0;
+    if (priv->frame_sync == frame_sync)
+        return;
+
+    priv->frame_sync = frame_sync;
+
+    if (!frame_sync && priv->flush_tick_id)
+    {
+        gtk_widget_remove_tick_callback (GTK_WIDGET (self),
+                                         priv->flush_tick_id);
+        priv->flush_tick_id = 0;
+
+        if (priv->freeze_count == 0)
+            hildon_animation_actor_send_pending_messages (self);
+    }
+}
+
+/**
+ * hildon_animation_actor_get_messages_sent:
+ * @self: A #HildonAnimationActor
+ *
+ * Returns the number of messages sent to the window manager for
+ * @self so far. Comparing it between frames tells how many
+ * messages a frame costs.
+ *
+ * Returns: the number of messages sent.
+ *
+ * Since: 3.0
+ **/
+guint
+hildon_animation_actor_get_messages_sent (HildonAnimationActor *self)
+{
+    HildonAnimationActorPrivate
+	               *priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (self);
+
+    g_return_val_if_fail (HILDON_IS_ANIMATION_ACTOR (self), 0);
+
+    return priv->messages_sent;
+}
+
+/* ------------------------------------------------------------- */
+
+static gdouble
+hildon_animation_actor_ease (HildonAnimationActorEasing easing,
+                             gdouble p)
+{
+    switch (easing)
+    {
+	case HILDON_AA_EASE_IN_QUAD:
+	    return p * p;
+	case HILDON_AA_EASE_OUT_QUAD:
+	    return p * (2 - p);
+	case HILDON_AA_EASE_IN_OUT_QUAD:
+	    return p < 0.5 ? 2 * p * p : 1 - 2 * (1 - p) * (1 - p);
+	case HILDON_AA_EASE_IN_CUBIC:
+	    return p * p * p;
+	case HILDON_AA_EASE_OUT_CUBIC:
+	    return 1 - (1 - p) * (1 - p) * (1 - p);
+	case HILDON_AA_EASE_IN_OUT_CUBIC:
+	    return p < 0.5 ? 4 * p * p * p : 1 - 4 * (1 - p) * (1 - p) * (1 - p);
+	case HILDON_AA_EASE_LINEAR:
+	default:
+	    return p;
+    }
+}
+
+static gdouble
+hildon_animation_actor_get_param (HildonAnimationActor *self,
+                                  HildonAnimationActorParam param)
+{
+    HildonAnimationActorPrivate
+	               *priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (self);
+
+    switch (param)
+    {
+	case HILDON_AA_PARAM_X:
+	    return (gint) priv->position_x;
+	case HILDON_AA_PARAM_Y:
+	    return (gint) priv->position_y;
+	case HILDON_AA_PARAM_DEPTH:
+	    return (gint) priv->depth;
+	case HILDON_AA_PARAM_SCALE_X:
+	    return (gint32) priv->scale_x / 65536.0;
+	case HILDON_AA_PARAM_SCALE_Y:
+	    return (gint32) priv->scale_y / 65536.0;
+	case HILDON_AA_PARAM_ROTATION_X:
+	    return (gint32) priv->x_rotation_angle / 65536.0;
+	case HILDON_AA_PARAM_ROTATION_Y:
+	    return (gint32) priv->y_rotation_angle / 65536.0;
+	case HILDON_AA_PARAM_ROTATION_Z:
+	    return (gint32) priv->z_rotation_angle / 65536.0;
+	case HILDON_AA_PARAM_OPACITY:
+	default:
+	    return priv->opacity;
+    }
+}
+
+/*
+ * Value of @param @msecs into the timeline: eased from the previous
+ * keyframe, or from the value at the start for the first one.
+ */
+static gdouble
+hildon_animation_actor_eval_param (HildonAnimationActor *self,
+                                   HildonAnimationActorParam param,
+                                   gdouble msecs)
+{
+    HildonAnimationActorPrivate
+	               *priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (self);
+    GArray             *keyframes = priv->timeline_keyframes[param];
+    gdouble             from_msecs = 0;
+    gdouble             from = priv->timeline_from[param];
+    guint               i;
+
+    for (i = 0; i < keyframes->len; i++)
+    {
+	HildonAnimationActorKeyframe *kf =
+	    &g_array_index (keyframes, HildonAnimationActorKeyframe, i);
+
+	if (msecs < kf->msecs)
+	{
+	    gdouble p = (msecs - from_msecs) / (kf->msecs - from_msecs);
+
+	    return from + (kf->value - from) * hildon_animation_actor_ease (kf->easing, p);
+	}
+
+	from_msecs = kf->msecs;
+	from = kf->value;
+    }
+
+    return from;
+}
+
+static void
+hildon_animation_actor_timeline_apply (HildonAnimationActor *self,
+                                       gdouble msecs)
+{
+    HildonAnimationActorPrivate
+	               *priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (self);
+    gdouble             v[HILDON_AA_N_PARAMS];
+    gboolean            set[HILDON_AA_N_PARAMS];
+    guint               i;
+
+    for (i = 0; i < HILDON_AA_N_PARAMS; i++)
+    {
+	set[i] = priv->timeline_keyframes[i]->len > 0;
+	v[i] = set[i] ? hildon_animation_actor_eval_param (self, i, msecs)
+		      : hildon_animation_actor_get_param (self, i);
+    }
+
+    /* Parameters sharing a message are sent together, once per frame */
+    hildon_animation_actor_freeze_updates (self);
+
+    if (set[HILDON_AA_PARAM_X] || set[HILDON_AA_PARAM_Y] || set[HILDON_AA_PARAM_DEPTH])
+	hildon_animation_actor_set_position_full (self,
+						  floor (v[HILDON_AA_PARAM_X] + 0.5),
+						  floor (v[HILDON_AA_PARAM_Y] + 0.5),
+						  floor (v[HILDON_AA_PARAM_DEPTH] + 0.5));
+
+    if (set[HILDON_AA_PARAM_SCALE_X] || set[HILDON_AA_PARAM_SCALE_Y])
+	hildon_animation_actor_set_scale (self,
+					  v[HILDON_AA_PARAM_SCALE_X],
+					  v[HILDON_AA_PARAM_SCALE_Y]);
+
+    if (set[HILDON_AA_PARAM_ROTATION_X])
+	hildon_animation_actor_set_rotation (self, HILDON_AA_X_AXIS,
+					     v[HILDON_AA_PARAM_ROTATION_X],
+					     0, priv->x_rotation_y,
+					     priv->x_rotation_z);
+
+    if (set[HILDON_AA_PARAM_ROTATION_Y])
+	hildon_animation_actor_set_rotation (self, HILDON_AA_Y_AXIS,
+					     v[HILDON_AA_PARAM_ROTATION_Y],
+					     priv->y_rotation_x, 0,
+					     priv->y_rotation_z);
+
+    if (set[HILDON_AA_PARAM_ROTATION_Z])
+	hildon_animation_actor_set_rotation (self, HILDON_AA_Z_AXIS,
+					     v[HILDON_AA_PARAM_ROTATION_Z],
+					     priv->z_rotation_x,
+					     priv->z_rotation_y, 0);
+
+    if (set[HILDON_AA_PARAM_OPACITY])
+	hildon_animation_actor_set_opacity (self,
+					    floor (v[HILDON_AA_PARAM_OPACITY] + 0.5));
+
+    hildon_animation_actor_thaw_updates (self);
+}
+
+static gboolean
+hildon_animation_actor_timeline_tick (GtkWidget *parent,
+                                      GdkFrameClock *frame_clock,
+                                      gpointer user_data)
+{
+    HildonAnimationActor *self = HILDON_ANIMATION_ACTOR (user_data);
+    HildonAnimationActorPrivate
+	               *priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (self);
+    gint64              now = gdk_frame_clock_get_frame_time (frame_clock);
+    gdouble             msecs;
+    gboolean            finished = FALSE;
+
+    /* Only count the time the parent was ticking */
+    if (priv->timeline_last_frame)
+	priv->timeline_elapsed += now - priv->timeline_last_frame;
+    priv->timeline_last_frame = now;
+
+    msecs = priv->timeline_elapsed / 1000.0;
+
+    if (msecs >= priv->timeline_duration)
+    {
+	if (priv->timeline_loop && priv->timeline_duration > 0)
+	{
+	    msecs = fmod (msecs, priv->timeline_duration);
+	}
+	else
+	{
+	    msecs = priv->timeline_duration;
+	    finished = TRUE;
+	}
+    }
+
+    hildon_animation_actor_timeline_apply (self, msecs);
+
+    if (!finished)
+	return G_SOURCE_CONTINUE;
+
+    priv->timeline_tick_id = 0;
+    priv->timeline_clock = NULL;
+    priv->timeline_playing = 0;
+
+    g_signal_emit (self, signals[TIMELINE_FINISHED], 0);
+
+    return G_SOURCE_REMOVE;
+}
+
+static void
+hildon_animation_actor_timeline_pause (HildonAnimationActor *self)
+{
+    HildonAnimationActorPrivate
+	               *priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (self);
+
+    if (!priv->timeline_tick_id)
+	return;
+
+    gtk_widget_remove_tick_callback (priv->timeline_clock,
+				     priv->timeline_tick_id);
+    priv->timeline_tick_id = 0;
+    priv->timeline_clock = NULL;
+}
+
+static void
+hildon_animation_actor_timeline_resume (HildonAnimationActor *self)
+{
+    HildonAnimationActorPrivate
+	               *priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (self);
+
+    if (!priv->timeline_playing || priv->timeline_tick_id)
+	return;
+
+    /* An unparented actor is not shown, and has no clock to follow */
+    if (!priv->parent || !gtk_widget_get_mapped (GTK_WIDGET (priv->parent)))
+	return;
+
+    priv->timeline_last_frame = 0;
+    priv->timeline_clock = GTK_WIDGET (priv->parent);
+    priv->timeline_tick_id =
+	gtk_widget_add_tick_callback (priv->timeline_clock,
+				      hildon_animation_actor_timeline_tick,
+				      self, NULL);
+}
+
+/**
+ * hildon_animation_actor_add_keyframe:
+ * @self: A #HildonAnimationActor
+ * @param: The parameter to animate.
+ * @msecs: Time of the keyframe, in milliseconds from the start of the timeline.
+ * @value: Value of @param at @msecs.
+ * @easing: How @param moves to @value from the previous keyframe.
+ *
+ * Adds a keyframe to the timeline of the animation actor. Between two
+ * keyframes of a parameter, its value follows the @easing curve of the
+ * later one. Before the first keyframe of a parameter, it moves from
+ * the value the parameter had when the timeline was started, and after
+ * the last one it keeps its value. Adding a keyframe at the time of an
+ * existing one of the same parameter replaces it.
+ *
+ * Positions and depths are in pixels, rotations in degrees and the
+ * opacity ranges from 0 to 255, as for the setters of the parameters.
+ * Rotations keep the center set with hildon_animation_actor_set_rotation().
+ *
+ * Keyframes added while the timeline is playing are used from the
+ * next call to hildon_animation_actor_start_timeline().
+ *
+ * Since: 3.0
+ **/
+void
+hildon_animation_actor_add_keyframe (HildonAnimationActor *self,
+                                     HildonAnimationActorParam param,
+                                     guint msecs,
+                                     gdouble value,
+                                     HildonAnimationActorEasing easing)
+{
+    HildonAnimationActorPrivate
+	               *priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (self);
+    HildonAnimationActorKeyframe kf = { msecs, value, easing };
+    GArray             *keyframes;
+    guint               i;
+
+    g_return_if_fail (HILDON_IS_ANIMATION_ACTOR (self));
+    g_return_if_fail (param < HILDON_AA_N_PARAMS);
+
+    keyframes = priv->keyframes[param];
+
+    for (i = 0; i < keyframes->len; i++)
+    {
+	HildonAnimationActorKeyframe *other =
+	    &g_array_index (keyframes, HildonAnimationActorKeyframe, i);
+
+	if (other->msecs == msecs)
+	{
+	    *other = kf;
+	    return;
+	}
+
+	if (other->msecs > msecs)
+	    break;
+    }
+
+    g_array_insert_val (keyframes, i, kf);
+}
+
+/**
+ * hildon_animation_actor_clear_keyframes:
+ * @self: A #HildonAnimationActor
+ *
+ * Stops the timeline of the animation actor and removes all of its
+ * keyframes.
+ *
+ * Since: 3.0
+ **/
+void
+hildon_animation_actor_clear_keyframes (HildonAnimationActor *self)
+{
+    HildonAnimationActorPrivate
+	               *priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (self);
+    guint               i;
+
+    g_return_if_fail (HILDON_IS_ANIMATION_ACTOR (self));
+
+    hildon_animation_actor_stop_timeline (self);
+
+    for (i = 0; i < HILDON_AA_N_PARAMS; i++)
+	g_array_set_size (priv->keyframes[i], 0);
+}
+
+/**
+ * hildon_animation_actor_start_timeline:
+ * @self: A #HildonAnimationActor
+ * @loop: Whether to start over after the last keyframe.
+ *
+ * Plays the keyframes added with hildon_animation_actor_add_keyframe()
+ * from the start. The timeline advances with the frame clock of the
+ * parent window, so the parameters are updated once per frame, and
+ * it is paused while the animation actor is unparented or its parent
+ * is not mapped.
+ *
+ * When @loop is %FALSE, the #HildonAnimationActor::timeline-finished
+ * signal is emitted after the last keyframe.
+ *
+ * Since: 3.0
+ **/
+void
+hildon_animation_actor_start_timeline (HildonAnimationActor *self,
+                                       gboolean loop)
+{
+    HildonAnimationActorPrivate
+	               *priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (self);
+    guint               i;
+
+    g_return_if_fail (HILDON_IS_ANIMATION_ACTOR (self));
+
+    hildon_animation_actor_timeline_pause (self);
+
+    /* Play a copy, so keyframes added meanwhile wait for the next start */
+    priv->timeline_duration = 0;
+    for (i = 0; i < HILDON_AA_N_PARAMS; i++)
+    {
+	GArray *keyframes = priv->timeline_keyframes[i];
+
+	g_array_set_size (keyframes, 0);
+	g_array_append_vals (keyframes, priv->keyframes[i]->data,
+			     priv->keyframes[i]->len);
+
+	priv->timeline_from[i] = hildon_animation_actor_get_param (self, i);
+
+	if (keyframes->len > 0)
+	    priv->timeline_duration =
+		MAX (priv->timeline_duration,
+		     g_array_index (keyframes, HildonAnimationActorKeyframe,
+				    keyframes->len - 1).msecs);
+    }
+
+    priv->timeline_elapsed = 0;
+    priv->timeline_loop = loop ? 1 : 0;
+    priv->timeline_playing = 1;
+
+    hildon_animation_actor_timeline_resume (self);
+}
+
+/**
+ * hildon_animation_actor_stop_timeline:
+ * @self: A #HildonAnimationActor
+ *
+ * Stops the timeline of the animation actor, leaving the parameters
+ * at their current values.
+ *
+ * Since: 3.0
+ **/
+void
+hildon_animation_actor_stop_timeline (HildonAnimationActor *self)
+{
+    HildonAnimationActorPrivate
+	               *priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (self);
+
+    g_return_if_fail (HILDON_IS_ANIMATION_ACTOR (self));
+
+    hildon_animation_actor_timeline_pause (self);
+    priv->timeline_playing = 0;
+}
@@ -88,6 +88,63 @@ struct                                          _HildonAnimationActor
 #define HILDON_AA_NW_GRAVITY	    8
 #define HILDON_AA_CENTER_GRAVITY    9
 
+/**
+ * HildonAnimationActorParam:
+ * @HILDON_AA_PARAM_X: X coordinate of the position, in pixels.
+ * @HILDON_AA_PARAM_Y: Y coordinate of the position, in pixels.
+ * @HILDON_AA_PARAM_DEPTH: Depth (Z coordinate) of the position.
+ * @HILDON_AA_PARAM_SCALE_X: Scale factor along the X-axis.
+ * @HILDON_AA_PARAM_SCALE_Y: Scale factor along the Y-axis.
+ * @HILDON_AA_PARAM_ROTATION_X: Rotation around the X-axis, in degrees.
+ * @HILDON_AA_PARAM_ROTATION_Y: Rotation around the Y-axis, in degrees.
+ * @HILDON_AA_PARAM_ROTATION_Z: Rotation around the Z-axis, in degrees.
+ * @HILDON_AA_PARAM_OPACITY: Opacity, from 0 to 255.
+ *
+ * Animation actor parameters that keyframes can animate, see
+ * hildon_animation_actor_add_keyframe().
+ *
+ * Since: 3.0
+ */
+typedef enum
+{
+    HILDON_AA_PARAM_X = 0,
+    HILDON_AA_PARAM_Y,
+    HILDON_AA_PARAM_DEPTH,
+    HILDON_AA_PARAM_SCALE_X,
+    HILDON_AA_PARAM_SCALE_Y,
+    HILDON_AA_PARAM_ROTATION_X,
+    HILDON_AA_PARAM_ROTATION_Y,
+    HILDON_AA_PARAM_ROTATION_Z,
+    HILDON_AA_PARAM_OPACITY
+}                                               HildonAnimationActorParam;
+
+/**
+ * HildonAnimationActorEasing:
+ * @HILDON_AA_EASE_LINEAR: Constant speed.
+ * @HILDON_AA_EASE_IN_QUAD: Quadratic, accelerating from zero speed.
+ * @HILDON_AA_EASE_OUT_QUAD: Quadratic, decelerating to zero speed.
+ * @HILDON_AA_EASE_IN_OUT_QUAD: Quadratic, accelerating until halfway,
+ * then decelerating.
+ * @HILDON_AA_EASE_IN_CUBIC: Cubic, accelerating from zero speed.
+ * @HILDON_AA_EASE_OUT_CUBIC: Cubic, decelerating to zero speed.
+ * @HILDON_AA_EASE_IN_OUT_CUBIC: Cubic, accelerating until halfway,
+ * then decelerating.
+ *
+ * How a parameter moves from the previous keyframe to the next one.
+ *
+ * Since: 3.0
+ */
+typedef enum
+{
+    HILDON_AA_EASE_LINEAR = 0,
+    HILDON_AA_EASE_IN_QUAD,
+    HILDON_AA_EASE_OUT_QUAD,
+    HILDON_AA_EASE_IN_OUT_QUAD,
+    HILDON_AA_EASE_IN_CUBIC,
+    HILDON_AA_EASE_OUT_CUBIC,
+    HILDON_AA_EASE_IN_OUT_CUBIC
+}                                               HildonAnimationActorEasing;
+
 GType
 hildon_animation_actor_get_type                (void) G_GNUC_CONST;
 
@@ -157,6 +214,30 @@ void
 hildon_animation_actor_set_parent (HildonAnimationActor *self,
 				   GtkWindow *parent);
 
+void
+hildon_animation_actor_freeze_updates (HildonAnimationActor *self);
+void
+hildon_animation_actor_thaw_updates (HildonAnimationActor *self);
+void
+hildon_animation_actor_set_frame_sync (HildonAnimationActor *self,
+                                       gboolean frame_sync);
+guint
+hildon_animation_actor_get_messages_sent (HildonAnimationActor *self);
+
+void
+hildon_animation_actor_add_keyframe (HildonAnimationActor *self,
+                                     HildonAnimationActorParam param,
+                                     guint msecs,
+                                     gdouble value,
+                                     HildonAnimationActorEasing easing);
+void
+hildon_animation_actor_clear_keyframes (HildonAnimationActor *self);
+void
+hildon_animation_actor_start_timeline (HildonAnimationActor *self,
+                                       gboolean loop);
+void
+hildon_animation_actor_stop_timeline (HildonAnimationActor *self);
+
 G_END_DECLS
 
 #endif                                 /* __HILDON_ANIMATION_ACTOR_H__ */
@@ -0,0 +1,75 @@
+/*
+ * This file is a part of hildon
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+/*
+ * The date arithmetic of HildonCalendar: plain integer computations
+ * on the number of days since the epoch, which give the same days of
+ * the week and week numbers as GDateTime without building one for
+ * every day shown. Months go from 1 to 12.
+ */
+
+#ifdef                                          HAVE_CONFIG_H
+#include                                        <config.h>
+#endif
+
+#include                                        "hildon-calendar-dates.h"
+
+/* Days since 1970-01-01 in the proleptic Gregorian calendar, see
+   http://howardhinnant.github.io/date_algorithms.html */
+gint64
+hildon_calendar_days_from_civil (gint64 year, guint mm, guint dd)
+{
+  gint64 era, yoe, doy, doe;
+
+  year -= mm <= 2;
+  era = (year >= 0 ? year : year - 399) / 400;
+  yoe = year - era * 400;
+  doy = (153 * (mm > 2 ? mm - 3 : mm + 9) + 2) / 5 + dd - 1;
+  doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+  return era * 146097 + doe - 719468;
+}
+
+/* From 1 for Monday to 7 for Sunday, like g_date_time_get_day_of_week() */
+guint
+hildon_calendar_day_of_week (guint year, guint mm, guint dd)
+{
+  /* 1970-01-01 was a Thursday */
+  return (hildon_calendar_days_from_civil (year, mm, dd) % 7 + 10) % 7 + 1;
+}
+
+/* The ISO 8601 week, like g_date_time_get_week_of_year() */
+guint
+hildon_calendar_week_of_year (guint year, guint mm, guint dd)
+{
+  gint64 days, thursday, first;
+
+  /* A week belongs to the year of its Thursday */
+  days = hildon_calendar_days_from_civil (year, mm, dd);
+  thursday = days + 4 - hildon_calendar_day_of_week (year, mm, dd);
+
+  first = hildon_calendar_days_from_civil (year, 1, 1);
+  if (thursday < first)
+    first = hildon_calendar_days_from_civil ((gint64) year - 1, 1, 1);
+  else if (thursday >= hildon_calendar_days_from_civil ((gint64) year + 1, 1, 1))
+    first = hildon_calendar_days_from_civil ((gint64) year + 1, 1, 1);
+
+  return (thursday - first) / 7 + 1;
+}
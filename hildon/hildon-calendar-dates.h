@@ -0,0 +1,45 @@
+/*
+ * This file is a part of hildon
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+#ifndef                                         __HILDON_CALENDAR_DATES_H__
+#define                                         __HILDON_CALENDAR_DATES_H__
+
+#include                                        <glib.h>
+
+G_BEGIN_DECLS
+
+G_GNUC_INTERNAL gint64
+hildon_calendar_days_from_civil                 (gint64 year,
+                                                 guint mm,
+                                                 guint dd);
+
+G_GNUC_INTERNAL guint
+hildon_calendar_day_of_week                     (guint year,
+                                                 guint mm,
+                                                 guint dd);
+
+G_GNUC_INTERNAL guint
+hildon_calendar_week_of_year                    (guint year,
+                                                 guint mm,
+                                                 guint dd);
+
+G_END_DECLS
+
+#endif                                          /* __HILDON_CALENDAR_DATES_H__ */
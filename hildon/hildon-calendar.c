@@ -91,6 +91,7 @@
 #include <glib.h>
 
 #include "hildon-calendar.h"
+#include "hildon-calendar-dates.h"
 #include "hildon-marshalers.h"
 
 // Define to remain compatible with GtkCalendar source:
@@ -125,38 +126,6 @@ leap (guint year)
   return ((((year % 4) == 0) && ((year % 100) != 0)) || ((year % 400) == 0));
 }
 
-static guint
-day_of_week (guint year, guint mm, guint dd)
-{
-  GDateTime *dt;
-  guint days;
-
-  dt = g_date_time_new_local (year, mm, dd, 1, 1, 1);
-  if (dt == NULL)
-    return 0;
-
-  days = g_date_time_get_day_of_week (dt);
-  g_date_time_unref (dt);
-
-  return days;
-}
-
-static guint
-week_of_year (guint year, guint mm, guint dd)
-{
-  GDateTime *dt;
-  guint week;
-
-  dt = g_date_time_new_local (year, mm, dd, 1, 1, 1);
-  if (dt == NULL)
-    return 1;
-
-  week = g_date_time_get_week_of_year (dt);
-  g_date_time_unref (dt);
-
-  return week;
-}
-
 /* Spacing around day/week headers and main area, inside those windows */
 #define CALENDAR_MARGIN          0
 
@@ -210,6 +179,64 @@ enum
 
 static guint hildon_calendar_signals[LAST_SIGNAL] = { 0 };
 
+/* What is drawn in a day cell, kept between draws */
+typedef struct
+{
+  gchar *detail;
+  PangoLayout *detail_layout;
+
+  guint has_detail : 1;         /* detail is the one of the current month */
+  guint pending : 1;            /* detail not received yet */
+  guint stripped : 1;           /* colors removed from detail_layout */
+} HildonCalendarCell;
+
+/* The details of a month given with hildon_calendar_set_month_details() */
+typedef struct
+{
+  gchar *detail[31];
+  guint age;                    /* for the eviction of the oldest months */
+
+  guint received : 1;
+  guint requested : 1;          /* waiting for an answer */
+  guint stale : 1;              /* to be asked again */
+} HildonCalendarMonthDetails;
+
+#define MAX_CACHED_MONTHS 12
+
+/* The days shown for a month, see calendar_compute_days() */
+typedef struct
+{
+  gint  year;
+  gint  month;
+  gint  week_start;
+  guint age;                    /* 0 for an unused entry */
+
+  gint  day_month[6][7];
+  gint  day[6][7];
+  guint week[6];
+} HildonCalendarGrid;
+
+/* Enough for a few months around the one shown, and the same months
+   of the years around it */
+#define MAX_CACHED_GRIDS 8
+
+/* Sizes of the texts of the calendar in its font, see
+   calendar_measure() */
+typedef struct
+{
+  gint month_name_width;
+  gint month_name_height;
+  gint year_width;
+  gint year_height;
+  gint day_width;
+  gint day_ascent;
+  gint day_descent;
+  gint day_name_width;
+  gint day_name_ascent;
+  gint day_name_descent;
+  gint week_width;
+} HildonCalendarMetrics;
+
 struct _HildonCalendarPrivate
 {
   HildonCalendarDisplayOptions display_flags;
@@ -225,6 +252,13 @@ struct _HildonCalendarPrivate
 
   gint  day_month[6][7];
   gint  day[6][7];
+  guint week[6];
+
+  HildonCalendarGrid grids[MAX_CACHED_GRIDS];
+  guint grids_age;
+
+  HildonCalendarMetrics metrics;
+  gboolean metrics_valid;
 
   gint  num_marked_dates;
   gint  marked_date[31];
@@ -276,10 +310,25 @@ struct _HildonCalendarPrivate
   gpointer              detail_func_user_data;
   GDestroyNotify        detail_func_destroy;
 
+  /* Optional callback, asking for the details of a whole month, and
+     the details received, by year * 12 + month */
+  HildonCalendarDetailsRequestFunc details_request_func;
+  gpointer              details_request_func_user_data;
+  GDestroyNotify        details_request_func_destroy;
+  GHashTable           *month_details;
+  guint                 month_details_age;
+  guint                 details_request_id;
+
   /* Size requistion for details provided by the hook. */
   gint detail_height_rows;
   gint detail_width_chars;
   gint detail_overflow[6];
+
+  /* Layouts of the day numbers, by day, and contents of the cells */
+  PangoLayout *day_layout[31];
+  gint day_layout_width[31];
+  PangoLayout *placeholder_layout;
+  HildonCalendarCell cells[6][7];
 };
 
 static void hildon_calendar_finalize     (GObject      *calendar);
@@ -325,6 +374,9 @@ static gboolean hildon_calendar_focus_out      (GtkWidget        *widget,
                                              GdkEventFocus    *event);
 static void     hildon_calendar_grab_notify    (GtkWidget        *widget,
                                              gboolean          was_grabbed);
+static void     hildon_calendar_style_updated  (GtkWidget        *widget);
+static void     hildon_calendar_direction_changed (GtkWidget     *widget,
+                                                   GtkTextDirection previous_direction);
 static void     hildon_calendar_state_flags_changed  (GtkWidget     *widget,
                                                    GtkStateFlags  previous_state);
 static gboolean hildon_calendar_query_tooltip  (GtkWidget        *widget,
@@ -373,6 +425,9 @@ static void calendar_invalidate_arrow   (HildonCalendar *widget,
                                          guint      arrow);
 
 static void calendar_compute_days      (HildonCalendar *calendar);
+static void calendar_clear_cells       (HildonCalendar *calendar);
+static void calendar_clear_day_layouts (HildonCalendar *calendar);
+static void calendar_month_details_free (HildonCalendarMonthDetails *details);
 static gint calendar_get_xsep          (HildonCalendar *calendar);
 static gint calendar_get_ysep          (HildonCalendar *calendar);
 static gint calendar_get_inner_border  (HildonCalendar *calendar);
@@ -411,6 +466,8 @@ hildon_calendar_class_init (HildonCalendarClass *class)
   widget_class->leave_notify_event = hildon_calendar_leave_notify;
   widget_class->key_press_event = hildon_calendar_key_press;
   widget_class->scroll_event = hildon_calendar_scroll;
+  widget_class->style_updated = hildon_calendar_style_updated;
+  widget_class->direction_changed = hildon_calendar_direction_changed;
   widget_class->state_flags_changed = hildon_calendar_state_flags_changed;
   widget_class->grab_notify = hildon_calendar_grab_notify;
   widget_class->focus_out_event = hildon_calendar_focus_out;
@@ -917,6 +974,9 @@ hildon_calendar_init (HildonCalendar *calendar)
   priv->min_year = 0;
   priv->max_year = 0;
 
+  priv->month_details = g_hash_table_new_full (NULL, NULL, NULL,
+                                               (GDestroyNotify) calendar_month_details_free);
+
   calendar_compute_days (calendar);
 }
 
@@ -925,12 +985,18 @@ hildon_calendar_init (HildonCalendar *calendar)
  *          Utility Functions           *
  ****************************************/
 
+static gboolean
+calendar_has_details (HildonCalendarPrivate *priv)
+{
+  return priv->detail_func != NULL || priv->details_request_func != NULL;
+}
+
 static void
 calendar_queue_refresh (HildonCalendar *calendar)
 {
   HildonCalendarPrivate *priv = calendar->priv;
 
-  if (!(priv->detail_func) ||
+  if (!calendar_has_details (priv) ||
       !(priv->display_flags & HILDON_CALENDAR_SHOW_DETAILS) ||
        (priv->detail_width_chars && priv->detail_height_rows))
     gtk_widget_queue_draw (GTK_WIDGET (calendar));
@@ -1038,9 +1104,8 @@ calendar_set_year_next (HildonCalendar *calendar)
 }
 
 static void
-calendar_compute_days (HildonCalendar *calendar)
+calendar_compute_grid (HildonCalendarGrid *grid)
 {
-  HildonCalendarPrivate *priv = calendar->priv;
   gint month;
   gint year;
   gint ndays_in_month;
@@ -1050,13 +1115,13 @@ calendar_compute_days (HildonCalendar *calendar)
   gint col;
   gint day;
 
-  year = priv->year;
-  month = priv->month + 1;
+  year = grid->year;
+  month = grid->month + 1;
 
   ndays_in_month = month_length[leap (year)][month];
 
-  first_day = day_of_week (year, month, 1);
-  first_day = (first_day + 7 - priv->week_start) % 7;
+  first_day = hildon_calendar_day_of_week (year, month, 1);
+  first_day = (first_day + 7 - grid->week_start) % 7;
   if (first_day == 0)
     first_day = 7;
 
@@ -1069,8 +1134,8 @@ calendar_compute_days (HildonCalendar *calendar)
 
   for (col = 0; col < first_day; col++)
     {
-      priv->day[0][col] = day;
-      priv->day_month[0][col] = MONTH_PREV;
+      grid->day[0][col] = day;
+      grid->day_month[0][col] = MONTH_PREV;
       day++;
     }
 
@@ -1079,8 +1144,8 @@ calendar_compute_days (HildonCalendar *calendar)
   col = first_day % 7;
   for (day = 1; day <= ndays_in_month; day++)
     {
-      priv->day[row][col] = day;
-      priv->day_month[row][col] = MONTH_CURRENT;
+      grid->day[row][col] = day;
+      grid->day_month[row][col] = MONTH_CURRENT;
 
       col++;
       if (col == 7)
@@ -1096,12 +1161,78 @@ calendar_compute_days (HildonCalendar *calendar)
     {
       for (; col <= 6; col++)
         {
-          priv->day[row][col] = day;
-          priv->day_month[row][col] = MONTH_NEXT;
+          grid->day[row][col] = day;
+          grid->day_month[row][col] = MONTH_NEXT;
           day++;
         }
       col = 0;
     }
+
+  /* The week numbers are the ones of the last day of each row */
+  for (row = 0; row < 6; row++)
+    {
+      gint week_year = year;
+      gint week_month = month + grid->day_month[row][6] - MONTH_CURRENT;
+
+      if (week_month < 1)
+        {
+          week_month += 12;
+          week_year -= 1;
+        }
+      else if (week_month > 12)
+        {
+          week_month -= 12;
+          week_year += 1;
+        }
+
+      grid->week[row] = hildon_calendar_week_of_year (week_year, week_month, grid->day[row][6]);
+    }
+}
+
+static void
+calendar_compute_days (HildonCalendar *calendar)
+{
+  HildonCalendarPrivate *priv = calendar->priv;
+  HildonCalendarGrid *grid = NULL;
+  gint i;
+
+  /* Going back and forth between months, or spinning through them,
+     finds the grids already computed */
+  for (i = 0; i < MAX_CACHED_GRIDS; i++)
+    {
+      HildonCalendarGrid *cached = &priv->grids[i];
+
+      if (cached->age != 0 &&
+          cached->year == priv->year &&
+          cached->month == priv->month &&
+          cached->week_start == priv->week_start)
+        {
+          grid = cached;
+          break;
+        }
+    }
+
+  if (grid == NULL)
+    {
+      grid = &priv->grids[0];
+      for (i = 1; i < MAX_CACHED_GRIDS; i++)
+        if (priv->grids[i].age < grid->age)
+          grid = &priv->grids[i];
+
+      grid->year = priv->year;
+      grid->month = priv->month;
+      grid->week_start = priv->week_start;
+      calendar_compute_grid (grid);
+    }
+
+  grid->age = ++priv->grids_age;
+
+  memcpy (priv->day, grid->day, sizeof (priv->day));
+  memcpy (priv->day_month, grid->day_month, sizeof (priv->day_month));
+  memcpy (priv->week, grid->week, sizeof (priv->week));
+
+  /* The day numbers are kept, the details are not */
+  calendar_clear_cells (calendar);
 }
 
 static void
@@ -1419,6 +1550,12 @@ calendar_set_month_prev (HildonCalendar *calendar)
 static void
 hildon_calendar_finalize (GObject *object)
 {
+  HildonCalendar *calendar = HILDON_CALENDAR (object);
+
+  calendar_clear_cells (calendar);
+  calendar_clear_day_layouts (calendar);
+  g_hash_table_destroy (calendar->priv->month_details);
+
   G_OBJECT_CLASS (hildon_calendar_parent_class)->finalize (object);
 }
 
@@ -1437,6 +1574,20 @@ hildon_calendar_destroy (GtkWidget *widget)
       priv->detail_func_destroy = NULL;
     }
 
+  if (priv->details_request_id)
+    {
+      g_source_remove (priv->details_request_id);
+      priv->details_request_id = 0;
+    }
+
+  if (priv->details_request_func_destroy)
+    {
+      priv->details_request_func_destroy (priv->details_request_func_user_data);
+      priv->details_request_func_user_data = NULL;
+      priv->details_request_func_destroy = NULL;
+    }
+  priv->details_request_func = NULL;
+
   GTK_WIDGET_CLASS (hildon_calendar_parent_class)->destroy (widget);
 }
 
@@ -1847,29 +1998,163 @@ hildon_calendar_unmap (GtkWidget *widget)
   GTK_WIDGET_CLASS (hildon_calendar_parent_class)->unmap (widget);
 }
 
+static void
+calendar_cell_month (HildonCalendar *calendar,
+                     gint            row,
+                     gint            column,
+                     gint           *year,
+                     gint           *month)
+{
+  HildonCalendarPrivate *priv = calendar->priv;
+
+  *year = priv->year;
+  *month = priv->month + priv->day_month[row][column] - MONTH_CURRENT;
+
+  if (*month < 0)
+    {
+      *month += 12;
+      *year -= 1;
+    }
+  else if (*month > 11)
+    {
+      *month -= 12;
+      *year += 1;
+    }
+}
+
+static void
+calendar_month_details_free (HildonCalendarMonthDetails *details)
+{
+  gint i;
+
+  for (i = 0; i < 31; i++)
+    g_free (details->detail[i]);
+  g_slice_free (HildonCalendarMonthDetails, details);
+}
+
+static HildonCalendarMonthDetails *
+calendar_lookup_month_details (HildonCalendar *calendar,
+                               gint            year,
+                               gint            month,
+                               gboolean        create)
+{
+  HildonCalendarPrivate *priv = calendar->priv;
+  HildonCalendarMonthDetails *details;
+  gpointer key = GINT_TO_POINTER (year * 12 + month);
+
+  details = g_hash_table_lookup (priv->month_details, key);
+
+  if (details == NULL && create)
+    {
+      /* Forget the month seen the longest time ago, even if it is
+         still waiting for its details: the answer is then ignored */
+      if (g_hash_table_size (priv->month_details) >= MAX_CACHED_MONTHS)
+        {
+          HildonCalendarMonthDetails *oldest = NULL, *value;
+          gpointer oldest_key = NULL, k;
+          GHashTableIter iter;
+
+          g_hash_table_iter_init (&iter, priv->month_details);
+          while (g_hash_table_iter_next (&iter, &k, (gpointer *) &value))
+            if (oldest == NULL || value->age < oldest->age)
+              {
+                oldest = value;
+                oldest_key = k;
+              }
+
+          if (oldest)
+            g_hash_table_remove (priv->month_details, oldest_key);
+        }
+
+      details = g_slice_new0 (HildonCalendarMonthDetails);
+      g_hash_table_insert (priv->month_details, key, details);
+    }
+
+  if (details)
+    details->age = ++priv->month_details_age;
+
+  return details;
+}
+
+/* Asks for the details of the months shown which are missing or
+   stale, one request for each month */
+static gboolean
+calendar_request_details (gpointer data)
+{
+  /* The first and last cells are in the previous and next months,
+     the middle one in the current month */
+  static const gint cells[3][2] = { { 0, 0 }, { 2, 3 }, { 5, 6 } };
+  HildonCalendar *calendar = HILDON_CALENDAR (data);
+  HildonCalendarPrivate *priv = calendar->priv;
+  gint i;
+
+  priv->details_request_id = 0;
+
+  if (priv->details_request_func == NULL)
+    return FALSE;
+
+  for (i = 0; i < 3; i++)
+    {
+      HildonCalendarMonthDetails *details;
+      gint year, month;
+
+      calendar_cell_month (calendar, cells[i][0], cells[i][1], &year, &month);
+      details = calendar_lookup_month_details (calendar, year, month, TRUE);
+
+      if (!details->requested && (!details->received || details->stale))
+        {
+          details->requested = TRUE;
+          details->stale = FALSE;
+          priv->details_request_func (calendar, year, month,
+                                      priv->details_request_func_user_data);
+        }
+    }
+
+  return FALSE;
+}
+
+static void
+calendar_queue_details_request (HildonCalendar *calendar)
+{
+  HildonCalendarPrivate *priv = calendar->priv;
+
+  if (priv->details_request_id == 0)
+    priv->details_request_id = gdk_threads_add_idle (calendar_request_details, calendar);
+}
+
 static gchar*
 hildon_calendar_get_detail (HildonCalendar *calendar,
                          gint         row,
-                         gint         column)
+                         gint         column,
+                         gboolean    *pending)
 {
   HildonCalendarPrivate *priv = HILDON_CALENDAR (calendar)->priv;
   gint year, month;
 
-  if (priv->detail_func == NULL)
+  *pending = FALSE;
+
+  if (!calendar_has_details (priv))
     return NULL;
 
-  year = priv->year;
-  month = priv->month + priv->day_month[row][column] - MONTH_CURRENT;
+  calendar_cell_month (calendar, row, column, &year, &month);
 
-  if (month < 0)
+  if (priv->details_request_func)
     {
-      month += 12;
-      year -= 1;
-    }
-  else if (month > 11)
-    {
-      month -= 12;
-      year += 1;
+      HildonCalendarMonthDetails *details;
+
+      details = calendar_lookup_month_details (calendar, year, month, FALSE);
+
+      if (details == NULL || !details->received || details->stale)
+        calendar_queue_details_request (calendar);
+
+      /* Stale details are shown until the new ones arrive */
+      if (details == NULL || !details->received)
+        {
+          *pending = TRUE;
+          return NULL;
+        }
+
+      return g_strdup (details->detail[priv->day[row][column] - 1]);
     }
 
   return priv->detail_func (calendar,
@@ -1878,6 +2163,108 @@ hildon_calendar_get_detail (HildonCalendar *calendar,
                             priv->detail_func_user_data);
 }
 
+static void
+calendar_clear_cell (HildonCalendar *calendar,
+                     gint            row,
+                     gint            col)
+{
+  HildonCalendarCell *cell = &calendar->priv->cells[row][col];
+
+  g_clear_object (&cell->detail_layout);
+  g_free (cell->detail);
+  memset (cell, 0, sizeof (HildonCalendarCell));
+}
+
+static void
+calendar_clear_cells (HildonCalendar *calendar)
+{
+  gint r, c;
+
+  for (r = 0; r < 6; r++)
+    for (c = 0; c < 7; c++)
+      calendar_clear_cell (calendar, r, c);
+}
+
+static void
+calendar_clear_day_layouts (HildonCalendar *calendar)
+{
+  HildonCalendarPrivate *priv = calendar->priv;
+  gint i;
+
+  for (i = 0; i < 31; i++)
+    g_clear_object (&priv->day_layout[i]);
+  g_clear_object (&priv->placeholder_layout);
+}
+
+/* The detail of a cell, only asked once for each month */
+static const gchar *
+calendar_get_cell_detail (HildonCalendar *calendar,
+                          gint            row,
+                          gint            col)
+{
+  HildonCalendarCell *cell = &calendar->priv->cells[row][col];
+
+  if (!cell->has_detail)
+    {
+      gboolean pending;
+
+      cell->detail = hildon_calendar_get_detail (calendar, row, col, &pending);
+      cell->has_detail = TRUE;
+      cell->pending = pending;
+    }
+
+  return cell->detail;
+}
+
+static PangoLayout *
+calendar_get_day_layout (HildonCalendar *calendar,
+                         gint            day,
+                         gint           *width)
+{
+  HildonCalendarPrivate *priv = calendar->priv;
+
+  if (priv->day_layout[day - 1] == NULL)
+    {
+      PangoRectangle logical_rect;
+      gchar buffer[32];
+
+      /* Translators: this defines whether the day numbers should use
+       * localized digits or the ones used in English (0123...).
+       *
+       * Translate to "%Id" if you want to use localized digits, or
+       * translate to "%d" otherwise.
+       *
+       * Note that translating this doesn't guarantee that you get localized
+       * digits. That needs support from your system and locale definition
+       * too.
+       */
+      g_snprintf (buffer, sizeof (buffer), C_("calendar:day:digits", "%d"), day);
+
+      priv->day_layout[day - 1] = gtk_widget_create_pango_layout (GTK_WIDGET (calendar), buffer);
+      pango_layout_set_alignment (priv->day_layout[day - 1], PANGO_ALIGN_CENTER);
+      pango_layout_get_pixel_extents (priv->day_layout[day - 1], NULL, &logical_rect);
+      priv->day_layout_width[day - 1] = logical_rect.width;
+    }
+
+  *width = priv->day_layout_width[day - 1];
+
+  return priv->day_layout[day - 1];
+}
+
+/* Asks the detail of @day of the current month again */
+static void
+calendar_invalidate_cell_detail (HildonCalendar *calendar,
+                                 gint            day)
+{
+  HildonCalendarPrivate *priv = calendar->priv;
+  gint r, c;
+
+  for (r = 0; r < 6; r++)
+    for (c = 0; c < 7; c++)
+      if (priv->day_month[r][c] == MONTH_CURRENT && priv->day[r][c] == day)
+        calendar_clear_cell (calendar, r, c);
+}
+
 static gboolean
 hildon_calendar_query_tooltip (GtkWidget  *widget,
                             gint        x,
@@ -1887,7 +2274,7 @@ hildon_calendar_query_tooltip (GtkWidget  *widget,
 {
   HildonCalendar *calendar = HILDON_CALENDAR (widget);
   HildonCalendarPrivate *priv = calendar->priv;
-  gchar *detail = NULL;
+  const gchar *detail = NULL;
   GdkRectangle day_rect;
   gint row, col;
 
@@ -1898,7 +2285,7 @@ hildon_calendar_query_tooltip (GtkWidget  *widget,
       (0 != (priv->detail_overflow[row] & (1 << col)) ||
       0 == (priv->display_flags & HILDON_CALENDAR_SHOW_DETAILS)))
     {
-      detail = hildon_calendar_get_detail (calendar, row, col);
+      detail = calendar_get_cell_detail (calendar, row, col);
       calendar_day_rectangle (calendar, row, col, &day_rect);
     }
 
@@ -1907,8 +2294,6 @@ hildon_calendar_query_tooltip (GtkWidget  *widget,
       gtk_tooltip_set_tip_area (tooltip, &day_rect);
       gtk_tooltip_set_markup (tooltip, detail);
 
-      g_free (detail);
-
       return TRUE;
     }
 
@@ -1922,6 +2307,88 @@ hildon_calendar_query_tooltip (GtkWidget  *widget,
  *       Size Request and Allocate      *
  ****************************************/
 
+/* The sizes of the month names, year, day numbers, day names and week
+   numbers only depend on the font, so they are measured once and kept
+   until the style changes */
+static const HildonCalendarMetrics *
+calendar_measure (HildonCalendar *calendar)
+{
+  HildonCalendarPrivate *priv = calendar->priv;
+  HildonCalendarMetrics *metrics = &priv->metrics;
+  PangoLayout *layout;
+  PangoRectangle logical_rect;
+  gint i;
+
+  if (priv->metrics_valid)
+    return metrics;
+
+  memset (metrics, 0, sizeof (HildonCalendarMetrics));
+
+  layout = gtk_widget_create_pango_layout (GTK_WIDGET (calendar), NULL);
+
+  for (i = 0; i < 12; i++)
+    {
+      pango_layout_set_text (layout, default_monthname[i], -1);
+      pango_layout_get_pixel_extents (layout, NULL, &logical_rect);
+      metrics->month_name_width = MAX (metrics->month_name_width,
+                                       logical_rect.width + 8);
+      metrics->month_name_height = MAX (metrics->month_name_height,
+                                        logical_rect.height);
+    }
+
+  /* Translators:  This is a text measurement template.
+   * Translate it to the widest year text
+   *
+   * If you don't understand this, leave it as "2000"
+   */
+  pango_layout_set_text (layout, C_("year measurement template", "2000"), -1);
+  pango_layout_get_pixel_extents (layout, NULL, &logical_rect);
+  metrics->year_width = logical_rect.width + 8;
+  metrics->year_height = logical_rect.height;
+
+  for (i = 0; i < 9; i++)
+    {
+      gchar buffer[32];
+      g_snprintf (buffer, sizeof (buffer), C_("calendar:day:digits", "%d"), i * 11);
+      pango_layout_set_text (layout, buffer, -1);
+      pango_layout_get_pixel_extents (layout, NULL, &logical_rect);
+      metrics->day_width = MAX (metrics->day_width, logical_rect.width);
+      metrics->day_ascent = MAX (metrics->day_ascent,
+                                 PANGO_ASCENT (logical_rect));
+      metrics->day_descent = MAX (metrics->day_descent,
+                                  PANGO_DESCENT (logical_rect));
+    }
+
+  for (i = 0; i < 7; i++)
+    {
+      pango_layout_set_text (layout, default_abbreviated_dayname[i], -1);
+      pango_layout_line_get_pixel_extents (pango_layout_get_lines_readonly (layout)->data, NULL, &logical_rect);
+
+      metrics->day_name_width = MAX (metrics->day_name_width,
+                                     logical_rect.width);
+      metrics->day_name_ascent = MAX (metrics->day_name_ascent,
+                                      PANGO_ASCENT (logical_rect));
+      metrics->day_name_descent = MAX (metrics->day_name_descent,
+                                       PANGO_DESCENT (logical_rect));
+    }
+
+  for (i = 0; i < 9; i++)
+    {
+      gchar buffer[32];
+      g_snprintf (buffer, sizeof (buffer), C_("calendar:week:digits", "%d"), i * 11);
+      pango_layout_set_text (layout, buffer, -1);
+      pango_layout_get_pixel_extents (layout, NULL, &logical_rect);
+      metrics->week_width = MAX (metrics->week_width,
+                                 logical_rect.width / 2);
+    }
+
+  g_object_unref (layout);
+
+  priv->metrics_valid = TRUE;
+
+  return metrics;
+}
+
 static void
 hildon_calendar_size_request (GtkWidget      *widget,
                            GtkRequisition *requisition)
@@ -1929,11 +2396,10 @@ hildon_calendar_size_request (GtkWidget      *widget,
   HildonCalendar *calendar = HILDON_CALENDAR (widget);
   HildonCalendarPrivate *priv = calendar->priv;
   GtkBorder padding, day_padding, day_name_padding, week_padding;
-  PangoLayout *layout;
-  PangoRectangle logical_rect;
+  const HildonCalendarMetrics *metrics;
 
   gint height;
-  gint i, r, c;
+  gint r, c;
   gint calendar_margin = CALENDAR_MARGIN;
   gint header_width, main_width;
   gint max_header_height = 0;
@@ -1944,7 +2410,7 @@ hildon_calendar_size_request (GtkWidget      *widget,
 
   gboolean show_week_numbers = (priv->display_flags & HILDON_CALENDAR_SHOW_WEEK_NUMBERS);
 
-  layout = gtk_widget_create_pango_layout (widget, NULL);
+  metrics = calendar_measure (calendar);
 
   /*
    * Calculate the requisition  width for the widget.
@@ -1954,27 +2420,10 @@ hildon_calendar_size_request (GtkWidget      *widget,
 
   if (priv->display_flags & HILDON_CALENDAR_SHOW_HEADING)
     {
-      priv->max_month_width = 0;
-      for (i = 0; i < 12; i++)
-        {
-          pango_layout_set_text (layout, default_monthname[i], -1);
-          pango_layout_get_pixel_extents (layout, NULL, &logical_rect);
-          priv->max_month_width = MAX (priv->max_month_width,
-                                               logical_rect.width + 8);
-          max_header_height = MAX (max_header_height, logical_rect.height);
-        }
-
-      priv->max_year_width = 0;
-      /* Translators:  This is a text measurement template.
-       * Translate it to the widest year text
-       *
-       * If you don't understand this, leave it as "2000"
-       */
-      pango_layout_set_text (layout, C_("year measurement template", "2000"), -1);
-      pango_layout_get_pixel_extents (layout, NULL, &logical_rect);
-      priv->max_year_width = MAX (priv->max_year_width,
-                                  logical_rect.width + 8);
-      max_header_height = MAX (max_header_height, logical_rect.height);
+      priv->max_month_width = metrics->month_name_width;
+      priv->max_year_width = metrics->year_width;
+      max_header_height = MAX (metrics->month_name_height,
+                               metrics->year_height);
     }
   else
     {
@@ -1993,61 +2442,39 @@ hildon_calendar_size_request (GtkWidget      *widget,
 
   /* Mainwindow labels width */
 
-  priv->max_day_char_width = 0;
-  priv->max_day_char_ascent = 0;
-  priv->max_day_char_descent = 0;
-  priv->min_day_width = 0;
+  priv->min_day_width = metrics->day_width;
+  priv->max_day_char_ascent = metrics->day_ascent;
+  priv->max_day_char_descent = metrics->day_descent;
 
-  for (i = 0; i < 9; i++)
+  if (priv->display_flags & HILDON_CALENDAR_SHOW_DAY_NAMES)
     {
-      gchar buffer[32];
-      g_snprintf (buffer, sizeof (buffer), C_("calendar:day:digits", "%d"), i * 11);
-      pango_layout_set_text (layout, buffer, -1);
-      pango_layout_get_pixel_extents (layout, NULL, &logical_rect);
-      priv->min_day_width = MAX (priv->min_day_width,
-                                         logical_rect.width);
-
-      priv->max_day_char_ascent = MAX (priv->max_day_char_ascent,
-                                               PANGO_ASCENT (logical_rect));
-      priv->max_day_char_descent = MAX (priv->max_day_char_descent,
-                                                PANGO_DESCENT (logical_rect));
+      priv->min_day_width = MAX (priv->min_day_width, metrics->day_name_width);
+      priv->max_label_char_ascent = metrics->day_name_ascent;
+      priv->max_label_char_descent = metrics->day_name_descent;
+    }
+  else
+    {
+      priv->max_label_char_ascent = 0;
+      priv->max_label_char_descent = 0;
     }
 
-  priv->max_label_char_ascent = 0;
-  priv->max_label_char_descent = 0;
-  if (priv->display_flags & HILDON_CALENDAR_SHOW_DAY_NAMES)
-    for (i = 0; i < 7; i++)
-      {
-        pango_layout_set_text (layout, default_abbreviated_dayname[i], -1);
-        pango_layout_line_get_pixel_extents (pango_layout_get_lines_readonly (layout)->data, NULL, &logical_rect);
-
-        priv->min_day_width = MAX (priv->min_day_width, logical_rect.width);
-        priv->max_label_char_ascent = MAX (priv->max_label_char_ascent,
-                                                   PANGO_ASCENT (logical_rect));
-        priv->max_label_char_descent = MAX (priv->max_label_char_descent,
-                                                    PANGO_DESCENT (logical_rect));
-      }
-
-  priv->max_week_char_width = 0;
   if (show_week_numbers)
-    for (i = 0; i < 9; i++)
-      {
-        gchar buffer[32];
-        g_snprintf (buffer, sizeof (buffer), C_("calendar:week:digits", "%d"), i * 11);
-        pango_layout_set_text (layout, buffer, -1);
-        pango_layout_get_pixel_extents (layout, NULL, &logical_rect);
-        priv->max_week_char_width = MAX (priv->max_week_char_width,
-                                           logical_rect.width / 2);
-      }
+    priv->max_week_char_width = metrics->week_width;
+  else
+    priv->max_week_char_width = 0;
 
   /* Calculate detail extents. Do this as late as possible since
    * pango_layout_set_markup is called which alters font settings. */
   max_detail_height = 0;
 
-  if (priv->detail_func && (priv->display_flags & HILDON_CALENDAR_SHOW_DETAILS))
+  if (calendar_has_details (priv) && (priv->display_flags & HILDON_CALENDAR_SHOW_DETAILS))
     {
+      PangoLayout *layout;
+      PangoRectangle logical_rect;
       gchar *markup, *tail;
 
+      layout = gtk_widget_create_pango_layout (widget, NULL);
+
       if (priv->detail_width_chars || priv->detail_height_rows)
         {
           gint rows = MAX (1, priv->detail_height_rows) - 1;
@@ -2082,7 +2509,7 @@ hildon_calendar_size_request (GtkWidget      *widget,
         for (r = 0; r < 6; r++)
           for (c = 0; c < 7; c++)
             {
-              gchar *detail = hildon_calendar_get_detail (calendar, r, c);
+              const gchar *detail = calendar_get_cell_detail (calendar, r, c);
 
               if (detail)
                 {
@@ -2103,9 +2530,10 @@ hildon_calendar_size_request (GtkWidget      *widget,
                     max_detail_height = MAX (max_detail_height, logical_rect.height);
 
                   g_free (markup);
-                  g_free (detail);
                 }
             }
+
+      g_object_unref (layout);
     }
 
   get_component_paddings (calendar, &padding, &day_padding, &day_name_padding, &week_padding);
@@ -2160,8 +2588,6 @@ hildon_calendar_size_request (GtkWidget      *widget,
   height = priv->header_h + priv->day_name_h + priv->main_h;
 
   requisition->height = height + padding.top + padding.bottom + (inner_border * 2);
-
-  g_object_unref (layout);
 }
 
 static void
@@ -2533,25 +2959,7 @@ calendar_paint_week_numbers (HildonCalendar *calendar,
 
   for (row = 0; row < 6; row++)
     {
-      gint year, month, week;
-
-      year = priv->year;
-      month = priv->month + priv->day_month[row][6] - MONTH_CURRENT;
-
-      if (month < 0)
-        {
-          month += 12;
-          year -= 1;
-        }
-      else if (month > 11)
-        {
-          month -= 12;
-          year += 1;
-        }
-
-      month += 1;
-
-      week = week_of_year (year, month, priv->day[row][6]);
+      gint week = priv->week[row];
 
       /* Translators: this defines whether the week numbers should use
        * localized digits or the ones used in English (0123...).
@@ -2638,16 +3046,16 @@ calendar_paint_day (HildonCalendar *calendar,
 {
   GtkWidget *widget = GTK_WIDGET (calendar);
   HildonCalendarPrivate *priv = calendar->priv;
+  HildonCalendarCell *cell = &priv->cells[row][col];
   GtkStyleContext *context;
   GtkStateFlags state = 0;
-  gchar *detail;
-  gchar buffer[32];
+  const gchar *detail;
   gint day;
   gint x_loc, y_loc;
+  gint day_layout_width;
   GdkRectangle day_rect;
 
   PangoLayout *layout;
-  PangoRectangle logical_rect;
   gboolean overflow = FALSE;
   gboolean show_details;
 
@@ -2687,27 +3095,13 @@ calendar_paint_day (HildonCalendar *calendar,
 
   gtk_style_context_set_state (context, state);
 
-  /* Translators: this defines whether the day numbers should use
-   * localized digits or the ones used in English (0123...).
-   *
-   * Translate to "%Id" if you want to use localized digits, or
-   * translate to "%d" otherwise.
-   *
-   * Note that translating this doesn't guarantee that you get localized
-   * digits. That needs support from your system and locale definition
-   * too.
-   */
-  g_snprintf (buffer, sizeof (buffer), C_("calendar:day:digits", "%d"), day);
-
   /* Get extra information to show, if any: */
 
-  detail = hildon_calendar_get_detail (calendar, row, col);
+  detail = calendar_get_cell_detail (calendar, row, col);
 
-  layout = gtk_widget_create_pango_layout (widget, buffer);
-  pango_layout_set_alignment (layout, PANGO_ALIGN_CENTER);
-  pango_layout_get_pixel_extents (layout, NULL, &logical_rect);
+  layout = calendar_get_day_layout (calendar, day, &day_layout_width);
 
-  x_loc = day_rect.x + (day_rect.width - logical_rect.width) / 2;
+  x_loc = day_rect.x + (day_rect.width - day_layout_width) / 2;
   y_loc = day_rect.y;
 
   gtk_render_layout (context, cr, x_loc, y_loc, layout);
@@ -2718,7 +3112,7 @@ calendar_paint_day (HildonCalendar *calendar,
 
   y_loc += priv->max_day_char_descent;
 
-  if (priv->detail_func && show_details)
+  if (calendar_has_details (priv) && show_details)
     {
       GdkRGBA color;
 
@@ -2739,35 +3133,80 @@ calendar_paint_day (HildonCalendar *calendar,
 
   if (detail && show_details)
     {
-      gchar *markup = g_strconcat ("<small>", detail, "</small>", NULL);
-      pango_layout_set_markup (layout, markup, -1);
-      g_free (markup);
+      gboolean strip = (day == priv->selected_day);
+
+      /* The colors of the selected day are removed, so its layout is
+         made again when the selection moves */
+      if (cell->detail_layout && cell->stripped != strip)
+        g_clear_object (&cell->detail_layout);
 
-      if (day == priv->selected_day)
+      if (cell->detail_layout == NULL)
         {
-          /* Stripping colors as they conflict with selection marking. */
+          gchar *markup = g_strconcat ("<small>", detail, "</small>", NULL);
+
+          cell->detail_layout = gtk_widget_create_pango_layout (widget, NULL);
+          pango_layout_set_markup (cell->detail_layout, markup, -1);
+          pango_layout_set_wrap (cell->detail_layout, PANGO_WRAP_WORD_CHAR);
+          g_free (markup);
 
-          PangoAttrList *attrs = pango_layout_get_attributes (layout);
-          PangoAttrList *colors = NULL;
+          if (strip)
+            {
+              /* Stripping colors as they conflict with selection marking. */
+
+              PangoAttrList *attrs = pango_layout_get_attributes (cell->detail_layout);
+              PangoAttrList *colors = NULL;
 
-          if (attrs)
-            colors = pango_attr_list_filter (attrs, is_color_attribute, NULL);
-          if (colors)
-            pango_attr_list_unref (colors);
+              if (attrs)
+                {
+                  attrs = pango_attr_list_copy (attrs);
+                  colors = pango_attr_list_filter (attrs, is_color_attribute, NULL);
+                  if (colors)
+                    {
+                      pango_layout_set_attributes (cell->detail_layout, attrs);
+                      pango_attr_list_unref (colors);
+                    }
+                  pango_attr_list_unref (attrs);
+                }
+            }
+
+          cell->stripped = strip;
         }
 
-      pango_layout_set_wrap (layout, PANGO_WRAP_WORD_CHAR);
-      pango_layout_set_width (layout, PANGO_SCALE * day_rect.width);
+      /* Pango only lays the text out again if the size changes */
+      pango_layout_set_width (cell->detail_layout, PANGO_SCALE * day_rect.width);
 
       if (priv->detail_height_rows)
         {
           gint dy = day_rect.height - (y_loc - day_rect.y);
-          pango_layout_set_height (layout, PANGO_SCALE * dy);
-          pango_layout_set_ellipsize (layout, PANGO_ELLIPSIZE_END);
+          pango_layout_set_height (cell->detail_layout, PANGO_SCALE * dy);
+          pango_layout_set_ellipsize (cell->detail_layout, PANGO_ELLIPSIZE_END);
+        }
+      else
+        {
+          pango_layout_set_height (cell->detail_layout, -1);
+          pango_layout_set_ellipsize (cell->detail_layout, PANGO_ELLIPSIZE_NONE);
         }
 
       cairo_move_to (cr, day_rect.x, y_loc);
-      pango_cairo_show_layout (cr, layout);
+      pango_cairo_show_layout (cr, cell->detail_layout);
+    }
+  else if (cell->pending && show_details)
+    {
+      PangoRectangle logical_rect;
+
+      /* The details are on their way */
+      if (priv->placeholder_layout == NULL)
+        {
+          priv->placeholder_layout = gtk_widget_create_pango_layout (widget, NULL);
+          pango_layout_set_markup (priv->placeholder_layout, "<small>\xe2\x80\xa6</small>", -1);
+        }
+
+      pango_layout_get_pixel_extents (priv->placeholder_layout, NULL, &logical_rect);
+      gtk_style_context_set_state (context, state | GTK_STATE_FLAG_INSENSITIVE);
+      gtk_render_layout (context, cr,
+                         day_rect.x + (day_rect.width - logical_rect.width) / 2, y_loc,
+                         priv->placeholder_layout);
+      gtk_style_context_set_state (context, state);
     }
 
   if (gtk_widget_has_visible_focus (widget) &&
@@ -2782,21 +3221,29 @@ calendar_paint_day (HildonCalendar *calendar,
     priv->detail_overflow[row] &= ~(1 << col);
 
   gtk_style_context_restore (context);
-  g_object_unref (layout);
-  g_free (detail);
 }
 
 static void
 calendar_paint_main (HildonCalendar *calendar,
                      cairo_t     *cr)
 {
+  GdkRectangle clip, day_rect;
   gint row, col;
 
+  /* Only the days in the damaged area are painted, for instance the
+     two days invalidated when the selection moves */
+  if (!gdk_cairo_get_clip_rectangle (cr, &clip))
+    return;
+
   cairo_save (cr);
 
   for (col = 0; col < 7; col++)
     for (row = 0; row < 6; row++)
-      calendar_paint_day (calendar, cr, row, col);
+      {
+        calendar_day_rectangle (calendar, row, col, &day_rect);
+        if (gdk_rectangle_intersect (&clip, &day_rect, NULL))
+          calendar_paint_day (calendar, cr, row, col);
+      }
 
   cairo_restore (cr);
 }
@@ -3450,6 +3897,31 @@ hildon_calendar_key_press (GtkWidget   *widget,
  *           Misc widget methods        *
  ****************************************/
 
+static void
+hildon_calendar_style_updated (GtkWidget *widget)
+{
+  HildonCalendar *calendar = HILDON_CALENDAR (widget);
+
+  GTK_WIDGET_CLASS (hildon_calendar_parent_class)->style_updated (widget);
+
+  /* The layouts and sizes were made with the old font */
+  calendar->priv->metrics_valid = FALSE;
+  calendar_clear_day_layouts (calendar);
+  calendar_clear_cells (calendar);
+}
+
+static void
+hildon_calendar_direction_changed (GtkWidget        *widget,
+                                   GtkTextDirection  previous_direction)
+{
+  HildonCalendar *calendar = HILDON_CALENDAR (widget);
+
+  GTK_WIDGET_CLASS (hildon_calendar_parent_class)->direction_changed (widget, previous_direction);
+
+  calendar_clear_day_layouts (calendar);
+  calendar_clear_cells (calendar);
+}
+
 static void
 hildon_calendar_state_flags_changed (GtkWidget     *widget,
                                   GtkStateFlags  previous_state)
@@ -3915,6 +4387,7 @@ hildon_calendar_clear_marks (HildonCalendar *calendar)
     }
 
   priv->num_marked_dates = 0;
+  calendar_clear_cells (calendar);
   calendar_queue_refresh (calendar);
 }
 
@@ -3939,6 +4412,7 @@ hildon_calendar_mark_day (HildonCalendar *calendar,
     {
       priv->marked_date[day - 1] = TRUE;
       priv->num_marked_dates++;
+      calendar_invalidate_cell_detail (calendar, day);
       calendar_invalidate_day_num (calendar, day);
     }
 }
@@ -3991,6 +4465,7 @@ hildon_calendar_unmark_day (HildonCalendar *calendar,
     {
       priv->marked_date[day - 1] = FALSE;
       priv->num_marked_dates--;
+      calendar_invalidate_cell_detail (calendar, day);
       calendar_invalidate_day_num (calendar, day);
     }
 }
@@ -4047,6 +4522,15 @@ hildon_calendar_get_date (HildonCalendar *calendar,
  * #HildonCalendar:detail-width-chars and #HildonCalendar:detail-height-rows
  * properties.
  *
+ * @func is called once for each day shown: the details are kept until
+ * another month is shown, or a day is marked or unmarked. Call
+ * hildon_calendar_invalidate_details() when they change.
+ *
+ * @func is called while @calendar is drawn or measured, so it must not
+ * block. Use hildon_calendar_set_details_request_func() instead when
+ * the details take time to be found. Setting a @func replaces the
+ * function set with hildon_calendar_set_details_request_func().
+ *
  * Since: 2.14
  */
 void
@@ -4068,11 +4552,220 @@ hildon_calendar_set_detail_func (HildonCalendar           *calendar,
   priv->detail_func_user_data = data;
   priv->detail_func_destroy = destroy;
 
+  if (func)
+    hildon_calendar_set_details_request_func (calendar, NULL, NULL, NULL);
+
+  calendar_clear_cells (calendar);
+
+  gtk_widget_set_has_tooltip (GTK_WIDGET (calendar),
+                              calendar_has_details (priv));
+  gtk_widget_queue_resize (GTK_WIDGET (calendar));
+}
+
+/**
+ * hildon_calendar_invalidate_details:
+ * @calendar: a #HildonCalendar.
+ *
+ * Drops the details kept by @calendar, so that the function installed
+ * with hildon_calendar_set_detail_func() is called again for each day
+ * shown. With hildon_calendar_set_details_request_func(), the details
+ * of every month are asked again when it is shown, and the old ones
+ * are shown until the new ones are given.
+ *
+ * Since: 3.0
+ */
+void
+hildon_calendar_invalidate_details (HildonCalendar *calendar)
+{
+  HildonCalendarPrivate *priv;
+  HildonCalendarMonthDetails *details;
+  GHashTableIter iter;
+
+  g_return_if_fail (HILDON_IS_CALENDAR (calendar));
+
+  priv = calendar->priv;
+
+  g_hash_table_iter_init (&iter, priv->month_details);
+  while (g_hash_table_iter_next (&iter, NULL, (gpointer *) &details))
+    details->stale = TRUE;
+
+  calendar_clear_cells (calendar);
+  calendar_queue_refresh (calendar);
+}
+
+/**
+ * hildon_calendar_invalidate_detail:
+ * @calendar: a #HildonCalendar.
+ * @year: the year of the day.
+ * @month: the month of the day, between 0 and 11.
+ * @day: the day of @month, between 1 and 31.
+ *
+ * Tells @calendar that the details of a day changed. With
+ * hildon_calendar_set_details_request_func(), the whole month is asked
+ * again if it is shown, once for all the days invalidated before the
+ * next main loop iteration.
+ *
+ * Since: 3.0
+ */
+void
+hildon_calendar_invalidate_detail (HildonCalendar *calendar,
+                                   guint           year,
+                                   guint           month,
+                                   guint           day)
+{
+  HildonCalendarPrivate *priv;
+  HildonCalendarMonthDetails *details;
+  gint r, c;
+
+  g_return_if_fail (HILDON_IS_CALENDAR (calendar));
+  g_return_if_fail (month <= 11);
+  g_return_if_fail (day >= 1 && day <= 31);
+
+  priv = calendar->priv;
+
+  details = g_hash_table_lookup (priv->month_details,
+                                 GINT_TO_POINTER (year * 12 + month));
+  if (details)
+    details->stale = TRUE;
+
+  for (r = 0; r < 6; r++)
+    for (c = 0; c < 7; c++)
+      {
+        gint cell_year, cell_month;
+
+        calendar_cell_month (calendar, r, c, &cell_year, &cell_month);
+        if (cell_year == (gint) year && cell_month == (gint) month && priv->day[r][c] == day)
+          {
+            calendar_clear_cell (calendar, r, c);
+            calendar_invalidate_day (calendar, r, c);
+          }
+      }
+}
+
+/**
+ * hildon_calendar_set_details_request_func:
+ * @calendar: a #HildonCalendar.
+ * @func: (allow-none): a function asking for the details of a month.
+ * @data: data to pass to @func invokations.
+ * @destroy: a function for releasing @data.
+ *
+ * Installs a function which asks for the details of all the days of a
+ * month at once, for details which take time to be found, like the
+ * appointments stored in a database. @func should start the search
+ * and return, the details are then given with
+ * hildon_calendar_set_month_details().
+ *
+ * @func is called from an idle handler, for each month with days
+ * shown whose details are missing or were invalidated. Until the
+ * details of a month are given, its days show a placeholder. The
+ * details of the last months shown are kept, see
+ * hildon_calendar_invalidate_detail().
+ *
+ * Setting a @func replaces the function set with
+ * hildon_calendar_set_detail_func().
+ *
+ * Since: 3.0
+ */
+void
+hildon_calendar_set_details_request_func (HildonCalendar                   *calendar,
+                                          HildonCalendarDetailsRequestFunc  func,
+                                          gpointer                          data,
+                                          GDestroyNotify                    destroy)
+{
+  HildonCalendarPrivate *priv;
+
+  g_return_if_fail (HILDON_IS_CALENDAR (calendar));
+
+  priv = calendar->priv;
+
+  if (priv->details_request_func_destroy)
+    priv->details_request_func_destroy (priv->details_request_func_user_data);
+
+  priv->details_request_func = func;
+  priv->details_request_func_user_data = data;
+  priv->details_request_func_destroy = destroy;
+
+  /* The details given before were asked by another function */
+  g_hash_table_remove_all (priv->month_details);
+
+  if (func)
+    hildon_calendar_set_detail_func (calendar, NULL, NULL, NULL);
+
+  calendar_clear_cells (calendar);
+
   gtk_widget_set_has_tooltip (GTK_WIDGET (calendar),
-                              NULL != priv->detail_func);
+                              calendar_has_details (priv));
   gtk_widget_queue_resize (GTK_WIDGET (calendar));
 }
 
+/**
+ * hildon_calendar_set_month_details:
+ * @calendar: a #HildonCalendar.
+ * @year: the year of the month.
+ * @month: the month, between 0 and 11.
+ * @details: (array length=n_details) (allow-none): Pango markup with the
+ *     details of each day of @month, starting with the first one, or
+ *     %NULL for the days without details.
+ * @n_details: the number of elements of @details, up to 31.
+ *
+ * Gives the details of a month asked by the function installed with
+ * hildon_calendar_set_details_request_func(). The days past
+ * @n_details have no details. The strings are copied.
+ *
+ * The details of a month that @calendar does not keep are ignored.
+ * This happens when they come after the month was forgotten, because
+ * it was not shown for a while.
+ *
+ * Since: 3.0
+ */
+void
+hildon_calendar_set_month_details (HildonCalendar      *calendar,
+                                   guint                year,
+                                   guint                month,
+                                   const gchar * const *details,
+                                   guint                n_details)
+{
+  HildonCalendarPrivate *priv;
+  HildonCalendarMonthDetails *month_details;
+  gint i, r, c;
+
+  g_return_if_fail (HILDON_IS_CALENDAR (calendar));
+  g_return_if_fail (month <= 11);
+  g_return_if_fail (details != NULL || n_details == 0);
+  g_return_if_fail (n_details <= 31);
+
+  priv = calendar->priv;
+
+  month_details = calendar_lookup_month_details (calendar, year, month, FALSE);
+  if (month_details == NULL)
+    return;
+
+  for (i = 0; i < 31; i++)
+    {
+      g_free (month_details->detail[i]);
+      month_details->detail[i] = i < n_details ? g_strdup (details[i]) : NULL;
+    }
+
+  month_details->received = TRUE;
+  month_details->requested = FALSE;
+
+  /* Asked again while this answer was on its way */
+  if (month_details->stale)
+    calendar_queue_details_request (calendar);
+
+  for (r = 0; r < 6; r++)
+    for (c = 0; c < 7; c++)
+      {
+        gint cell_year, cell_month;
+
+        calendar_cell_month (calendar, r, c, &cell_year, &cell_month);
+        if (cell_year == (gint) year && cell_month == (gint) month)
+          calendar_clear_cell (calendar, r, c);
+      }
+
+  calendar_queue_refresh (calendar);
+}
+
 /**
  * hildon_calendar_set_detail_width_chars:
  * @calendar: a #HildonCalendar.
@@ -99,6 +99,24 @@ typedef gchar* (*HildonCalendarDetailFunc) (HildonCalendar *calendar,
                                             guint        day,
                                             gpointer     user_data);
 
+/**
+ * HildonCalendarDetailsRequestFunc:
+ * @calendar: a #HildonCalendar.
+ * @year: the year for which details are needed.
+ * @month: the month for which details are needed.
+ * @user_data: the data passed with hildon_calendar_set_details_request_func().
+ *
+ * This kind of functions start the search of the details of all the
+ * days of @month, and return without waiting for it. The details are
+ * then given with hildon_calendar_set_month_details().
+ *
+ * Since: 3.0
+ */
+typedef void (*HildonCalendarDetailsRequestFunc) (HildonCalendar *calendar,
+                                                  guint        year,
+                                                  guint        month,
+                                                  gpointer     user_data);
+
 struct _HildonCalendar
 {
   GtkWidget widget;
@@ -168,6 +186,24 @@ void       hildon_calendar_set_detail_func (HildonCalendar           *calendar,
                                          gpointer               data,
                                          GDestroyNotify         destroy);
 
+void       hildon_calendar_invalidate_details (HildonCalendar    *calendar);
+
+void       hildon_calendar_invalidate_detail (HildonCalendar    *calendar,
+                                           guint              year,
+                                           guint              month,
+                                           guint              day);
+
+void       hildon_calendar_set_details_request_func (HildonCalendar                   *calendar,
+                                                  HildonCalendarDetailsRequestFunc  func,
+                                                  gpointer                          data,
+                                                  GDestroyNotify                    destroy);
+
+void       hildon_calendar_set_month_details (HildonCalendar      *calendar,
+                                           guint                year,
+                                           guint                month,
+                                           const gchar * const *details,
+                                           guint                n_details);
+
 
 void       hildon_calendar_set_detail_width_chars (HildonCalendar    *calendar,
                                                 gint            chars);
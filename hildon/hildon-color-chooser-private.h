@@ -51,13 +51,38 @@ struct                                          _HildonColorChooserPrivate
     GdkPixbuf *dimmed_plane;
     GdkPixbuf *dimmed_bar;
 
+    /* The hue bar for the size of hba, and the SV plane for the size of
+       spa and sv_plane_hue, see inline_draw_hue_bar() and
+       inline_draw_sv_plane() */
+    cairo_surface_t *hue_bar;
+    cairo_surface_t *sv_plane;
+    unsigned short sv_plane_hue;
+
+    cairo_surface_t *crosshair;
+
+    /* The colour last invalidated for, and the tick callback doing
+       it, see inline_limited_expose() */
     struct {
         unsigned short last_expose_hue;
+        unsigned short last_expose_sat;
+        unsigned short last_expose_val;
 
-        GTimeVal last_expose_time;
-
-        int expose_queued;
+        guint tick_id;
     } expose_info;
 };
 
+G_GNUC_INTERNAL void
+hildon_color_chooser_raster_sv_plane            (const unsigned long *hue_rgb,
+                                                 unsigned char *data,
+                                                 int stride,
+                                                 int w,
+                                                 int h);
+
+G_GNUC_INTERNAL void
+hildon_color_chooser_raster_sv_plane_scalar     (const unsigned long *hue_rgb,
+                                                 unsigned char *data,
+                                                 int stride,
+                                                 int w,
+                                                 int h);
+
 #endif                                          /* __HILDON_COLOR_CHOOSER_H__ */
@@ -0,0 +1,224 @@
+/*
+ * This file is a part of hildon
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+/*
+ * The SV plane of HildonColorChooser, rendered straight into the
+ * pixels of a CAIRO_FORMAT_RGB24 surface.
+ *
+ * The plane goes from white at the top to the hue at the bottom, and
+ * from black on the left to full value on the right. Each row is a
+ * 16.16 fixed point step per channel, and each pixel is that step
+ * times its column, shifted down 16 bits. These are the values the
+ * chooser has always drawn, the SIMD versions only compute 4 pixels
+ * at a time.
+ */
+
+#undef                                          HILDON_DISABLE_DEPRECATED
+
+#ifdef                                          HAVE_CONFIG_H
+#include                                        <config.h>
+#endif
+
+#include                                        "hildon-color-chooser.h"
+#include                                        "hildon-color-chooser-private.h"
+
+#if defined(__SSE2__)
+#include                                        <emmintrin.h>
+#define                                         HILDON_COLOR_CHOOSER_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include                                        <arm_neon.h>
+#define                                         HILDON_COLOR_CHOOSER_NEON
+#endif
+
+/* Steps of the first row, and from one row to the next */
+static void
+sv_plane_steps                                  (const unsigned long *hue_rgb,
+                                                 int w,
+                                                 int h,
+                                                 guint32 *rgbx,
+                                                 gint32 *rgby)
+{
+    int c;
+
+    for (c = 0; c < 3; c++) {
+        rgbx[c] = 0x00ffffff / w;
+        rgby[c] = ((signed long) hue_rgb[c] - 0x00ffffff) / (w * h);
+    }
+}
+
+/* An RGB24 pixel from the three 16.16 channels, all below 1 << 24 */
+static inline guint32
+sv_plane_pixel                                  (guint32 r,
+                                                 guint32 g,
+                                                 guint32 b)
+{
+    return (r & 0x00ff0000) | ((g >> 8) & 0x0000ff00) | (b >> 16);
+}
+
+void
+hildon_color_chooser_raster_sv_plane_scalar     (const unsigned long *hue_rgb,
+                                                 unsigned char *data,
+                                                 int stride,
+                                                 int w,
+                                                 int h)
+{
+    guint32 rgbx[3], rgbtmp[3];
+    gint32 rgby[3];
+    int i, j;
+
+    sv_plane_steps (hue_rgb, w, h, rgbx, rgby);
+
+    for (i = 0; i < h; i++) {
+        guint32 *row = (guint32 *) (data + i * stride);
+
+        rgbtmp[0] = 0;
+        rgbtmp[1] = 0;
+        rgbtmp[2] = 0;
+
+        for (j = 0; j < w; j++) {
+            row[j] = sv_plane_pixel (rgbtmp[0], rgbtmp[1], rgbtmp[2]);
+            rgbtmp[0] += rgbx[0];
+            rgbtmp[1] += rgbx[1];
+            rgbtmp[2] += rgbx[2];
+        }
+
+        rgbx[0] += rgby[0];
+        rgbx[1] += rgby[1];
+        rgbx[2] += rgby[2];
+    }
+}
+
+#if defined(HILDON_COLOR_CHOOSER_SSE2)
+
+/* Pixels j to j + 3 of a row, and the step to the next 4 */
+static inline int
+sv_plane_row_simd                               (guint32 *row,
+                                                 const guint32 *rgbx,
+                                                 int w)
+{
+    __m128i r, g, b, r4, g4, b4;
+    __m128i mask_r = _mm_set1_epi32 (0x00ff0000);
+    __m128i mask_g = _mm_set1_epi32 (0x0000ff00);
+    int j;
+
+    r = _mm_set_epi32 (rgbx[0] * 3, rgbx[0] * 2, rgbx[0], 0);
+    g = _mm_set_epi32 (rgbx[1] * 3, rgbx[1] * 2, rgbx[1], 0);
+    b = _mm_set_epi32 (rgbx[2] * 3, rgbx[2] * 2, rgbx[2], 0);
+    r4 = _mm_set1_epi32 (rgbx[0] * 4);
+    g4 = _mm_set1_epi32 (rgbx[1] * 4);
+    b4 = _mm_set1_epi32 (rgbx[2] * 4);
+
+    for (j = 0; j + 4 <= w; j += 4) {
+        __m128i px = _mm_or_si128 (_mm_and_si128 (r, mask_r),
+                                   _mm_or_si128 (_mm_and_si128 (_mm_srli_epi32 (g, 8), mask_g),
+                                                 _mm_srli_epi32 (b, 16)));
+
+        _mm_storeu_si128 ((__m128i *) (row + j), px);
+
+        r = _mm_add_epi32 (r, r4);
+        g = _mm_add_epi32 (g, g4);
+        b = _mm_add_epi32 (b, b4);
+    }
+
+    return j;
+}
+
+#elif defined(HILDON_COLOR_CHOOSER_NEON)
+
+static inline int
+sv_plane_row_simd                               (guint32 *row,
+                                                 const guint32 *rgbx,
+                                                 int w)
+{
+    static const guint32 lanes[4] = { 0, 1, 2, 3 };
+    uint32x4_t index = vld1q_u32 (lanes);
+    uint32x4_t r, g, b, r4, g4, b4;
+    uint32x4_t mask_r = vdupq_n_u32 (0x00ff0000);
+    uint32x4_t mask_g = vdupq_n_u32 (0x0000ff00);
+    int j;
+
+    r = vmulq_n_u32 (index, rgbx[0]);
+    g = vmulq_n_u32 (index, rgbx[1]);
+    b = vmulq_n_u32 (index, rgbx[2]);
+    r4 = vdupq_n_u32 (rgbx[0] * 4);
+    g4 = vdupq_n_u32 (rgbx[1] * 4);
+    b4 = vdupq_n_u32 (rgbx[2] * 4);
+
+    for (j = 0; j + 4 <= w; j += 4) {
+        uint32x4_t px = vorrq_u32 (vandq_u32 (r, mask_r),
+                                   vorrq_u32 (vandq_u32 (vshrq_n_u32 (g, 8), mask_g),
+                                              vshrq_n_u32 (b, 16)));
+
+        vst1q_u32 (row + j, px);
+
+        r = vaddq_u32 (r, r4);
+        g = vaddq_u32 (g, g4);
+        b = vaddq_u32 (b, b4);
+    }
+
+    return j;
+}
+
+#endif
+
+/*
+ * Renders the SV plane of @hue_rgb, as filled by inline_h2rgb(), into
+ * the @data of a w x h CAIRO_FORMAT_RGB24 surface, 4 pixels at a time
+ * when the compiler targets SSE2 or NEON. The pixels are the ones of
+ * hildon_color_chooser_raster_sv_plane_scalar().
+ */
+void
+hildon_color_chooser_raster_sv_plane            (const unsigned long *hue_rgb,
+                                                 unsigned char *data,
+                                                 int stride,
+                                                 int w,
+                                                 int h)
+{
+#if defined(HILDON_COLOR_CHOOSER_SSE2) || defined(HILDON_COLOR_CHOOSER_NEON)
+    guint32 rgbx[3], rgbtmp[3];
+    gint32 rgby[3];
+    int i, j;
+
+    sv_plane_steps (hue_rgb, w, h, rgbx, rgby);
+
+    for (i = 0; i < h; i++) {
+        guint32 *row = (guint32 *) (data + i * stride);
+
+        j = sv_plane_row_simd (row, rgbx, w);
+
+        rgbtmp[0] = rgbx[0] * j;
+        rgbtmp[1] = rgbx[1] * j;
+        rgbtmp[2] = rgbx[2] * j;
+
+        for (; j < w; j++) {
+            row[j] = sv_plane_pixel (rgbtmp[0], rgbtmp[1], rgbtmp[2]);
+            rgbtmp[0] += rgbx[0];
+            rgbtmp[1] += rgbx[1];
+            rgbtmp[2] += rgbx[2];
+        }
+
+        rgbx[0] += rgby[0];
+        rgbx[1] += rgby[1];
+        rgbx[2] += rgby[2];
+    }
+#else
+    hildon_color_chooser_raster_sv_plane_scalar (hue_rgb, data, stride, w, h);
+#endif
+}
@@ -119,35 +119,31 @@ init_borders                                    (GtkWidget *w,
                                                  GtkBorder *inner, 
                                                  GtkBorder *outer);
 
-static void
-draw_rgb_image                                  (cairo_t *cr,
-                                                 unsigned char *data,
-                                                 int x,
-                                                 int y,
-                                                 int width,
-                                                 int height);
-
 static inline void 
 inline_clip_to_alloc                            (void *s, 
                                                  GtkAllocation *a);
 
-static inline void 
-inline_sub_times                                (GTimeVal *result, 
-                                                 GTimeVal *greater, 
-                                                 GTimeVal *lesser);
-
 static inline void 
 inline_limited_expose                           (HildonColorChooser *self);
 
+static cairo_surface_t *
+create_hue_bar_surface                          (int w,
+                                                 int h);
+
+static cairo_surface_t *
+create_sv_plane_surface                         (unsigned short hue,
+                                                 int w,
+                                                 int h);
+
+static cairo_surface_t *
+create_crosshair_surface                        (void);
+
+static void
+clear_surfaces                                  (HildonColorChooser *self);
+
 static inline void 
 inline_draw_hue_bar                             (GtkWidget *widget,
-                                                 cairo_t *cr,
-                                                 int x, 
-                                                 int y, 
-                                                 int w, 
-                                                 int h, 
-                                                 int sy, 
-                                                 int sh);
+                                                 cairo_t *cr);
 
 static inline void
 inline_draw_hue_bar_dimmed                      (GtkWidget *widget, 
@@ -161,11 +157,7 @@ inline_draw_hue_bar_dimmed                      (GtkWidget *widget,
 
 static inline void 
 inline_draw_sv_plane                            (HildonColorChooser *self,
-                                                 cairo_t *cr, 
-                                                 int x, 
-                                                 int y, 
-                                                 int w, 
-                                                 int h);
+                                                 cairo_t *cr);
 
 static inline void 
 inline_draw_sv_plane_dimmed                     (HildonColorChooser *self,
@@ -176,18 +168,17 @@ inline_draw_sv_plane_dimmed                     (HildonColorChooser *self,
                                                  int h);
 
 static inline void 
-inline_draw_crosshair                           (unsigned char *buf, 
-                                                 int x, 
-                                                 int y, 
-                                                 int w, 
-                                                 int h);
+inline_draw_crosshair                           (HildonColorChooser *self,
+                                                 cairo_t *cr);
 
 static inline void 
 inline_h2rgb                                    (unsigned short hue, 
                                                  unsigned long *rgb);
 
 static gboolean
-hildon_color_chooser_expose_timer               (gpointer data);
+hildon_color_chooser_expose_tick                (GtkWidget *widget,
+                                                 GdkFrameClock *frame_clock,
+                                                 gpointer data);
 
 static void
 hildon_color_chooser_set_property               (GObject *object, 
@@ -201,8 +192,6 @@ hildon_color_chooser_get_property               (GObject *object,
                                                  GValue *value, 
                                                  GParamSpec *pspec);
 
-#define                                         EXPOSE_INTERVAL 50000
-
 #define                                         FULL_COLOR8 0xff
 
 #define                                         FULL_COLOR 0x00ffffff
@@ -238,13 +227,18 @@ hildon_color_chooser_init                       (HildonColorChooser *sel)
     priv->mousestate = 0;
     priv->mousein = FALSE;
 
-    g_get_current_time (&priv->expose_info.last_expose_time);
-
     priv->expose_info.last_expose_hue = priv->currhue;
-    priv->expose_info.expose_queued = 0;
+    priv->expose_info.last_expose_sat = priv->currsat;
+    priv->expose_info.last_expose_val = priv->currval;
+    priv->expose_info.tick_id = 0;
 
     priv->dimmed_plane = NULL;
     priv->dimmed_bar = NULL;
+
+    priv->hue_bar = NULL;
+    priv->sv_plane = NULL;
+    priv->sv_plane_hue = 0;
+    priv->crosshair = NULL;
 }
 
 static void
@@ -323,14 +317,11 @@ hildon_color_chooser_dispose                    (HildonColorChooser *sel)
     HildonColorChooserPrivate *priv = HILDON_COLOR_CHOOSER_GET_PRIVATE (sel);
     g_assert (priv);
 
-    if (priv->dimmed_bar != NULL) {
-        g_object_unref (priv->dimmed_bar);
-        priv->dimmed_bar = NULL;
-    }
+    clear_surfaces (sel);
 
-    if (priv->dimmed_plane != NULL) {
-        g_object_unref (priv->dimmed_plane);
-        priv->dimmed_plane = NULL;
+    if (priv->crosshair != NULL) {
+        cairo_surface_destroy (priv->crosshair);
+        priv->crosshair = NULL;
     }
 
     G_OBJECT_CLASS (parent_class)->dispose (G_OBJECT (sel));
@@ -378,6 +369,7 @@ hildon_color_chooser_size_allocate              (GtkWidget *widget,
 {
     HildonColorChooserPrivate *priv = HILDON_COLOR_CHOOSER_GET_PRIVATE (widget);
     GtkBorder outer, inner;
+    GtkAllocation hba, spa;
 
     g_assert (priv);
 
@@ -385,6 +377,9 @@ hildon_color_chooser_size_allocate              (GtkWidget *widget,
     
     init_borders(widget, &inner, &outer);
 
+    hba = priv->hba;
+    spa = priv->spa;
+
     priv->hba.height = alloc->height - outer.top - outer.bottom;
     priv->hba.y = alloc->y + outer.top;
     priv->hba.width = inner.top;
@@ -395,6 +390,12 @@ hildon_color_chooser_size_allocate              (GtkWidget *widget,
     priv->spa.height = alloc->height - outer.top - outer.bottom;
     priv->spa.width = alloc->width - outer.left - outer.right - inner.top - inner.bottom;
 
+    /* The cached images only depend on the sizes, not the positions */
+    if (hba.width != priv->hba.width || hba.height != priv->hba.height ||
+        spa.width != priv->spa.width || spa.height != priv->spa.height) {
+        clear_surfaces (HILDON_COLOR_CHOOSER (widget));
+    }
+
     if (gtk_widget_get_realized (widget)) {
         gdk_window_move_resize (priv->event_window, 
                 alloc->x, 
@@ -466,6 +467,11 @@ hildon_color_chooser_map                        (GtkWidget *widget)
     g_assert (priv);
     GTK_WIDGET_CLASS(parent_class)->map(widget);
 
+    /* All of it is drawn after mapping */
+    priv->expose_info.last_expose_hue = priv->currhue;
+    priv->expose_info.last_expose_sat = priv->currsat;
+    priv->expose_info.last_expose_val = priv->currval;
+
     if (priv->event_window) {
         gdk_window_show (priv->event_window);
     }
@@ -482,6 +488,11 @@ hildon_color_chooser_unmap                      (GtkWidget *widget)
         gdk_window_hide (priv->event_window);
     }
 
+    if (priv->expose_info.tick_id) {
+        gtk_widget_remove_tick_callback (widget, priv->expose_info.tick_id);
+        priv->expose_info.tick_id = 0;
+    }
+
     GTK_WIDGET_CLASS (parent_class)->unmap (widget);
 }
 
@@ -519,18 +530,12 @@ hildon_color_chooser_draw                       (GtkWidget *widget,
 
     GtkBorder graphical_border;
 
-    struct {
-        int x, y, w, h;
-    } area;
-
-
     if(! gtk_widget_get_realized (widget)) {
         return FALSE;
     }
 
     get_border (widget, "graphic_border", &graphical_border);
     
-//    if (event->area.width || event->area.height) {
     if (gtk_widget_get_allocated_width (widget) || gtk_widget_get_allocated_height (widget)) {
 
         cairo_set_source_rgb (cr, 0, 0, 0);
@@ -541,108 +546,64 @@ hildon_color_chooser_draw                       (GtkWidget *widget,
         cairo_stroke (cr);
     }
 
-/*    if (priv->expose_info.expose_queued) {
-        if (gtk_widget_is_sensitive (widget)) {
-            inline_draw_hue_bar (widget, cr, priv->hba.x, priv->hba.y, priv->hba.width, priv->hba.height, priv->hba.y, priv->hba.height);
-
-            inline_draw_sv_plane (sel, cr, priv->spa.x, priv->spa.y, priv->spa.width, priv->spa.height);
-        } else {
-            inline_draw_hue_bar_dimmed (widget, cr, priv->hba.x, priv->hba.y, priv->hba.width, priv->hba.height, priv->hba.y, priv->hba.height);
-
-            inline_draw_sv_plane_dimmed (sel, cr, priv->spa.x, priv->spa.y, priv->spa.width, priv->spa.height);
-        }
-
- //       priv->expose_info.expose_queued = 0;
-
-//        g_get_current_time (&priv->expose_info.last_expose_time);
-
-//    } else {*/
-        /* clip hue bar region */
-        area.x = 0;//event->area.x;
-        area.y = 0;//event->area.y;
-        area.w = gtk_widget_get_allocated_width (widget);//event->area.width;
-        area.h = gtk_widget_get_allocated_height (widget);//event->area.height;
-
-        inline_clip_to_alloc (&area, &priv->hba);
-
-        if(gtk_widget_is_sensitive (widget)) {
-            inline_draw_hue_bar (widget, cr, area.x, area.y, area.w, area.h, priv->hba.y, priv->hba.height);
-        } else {
-            inline_draw_hue_bar_dimmed (widget, cr, area.x, area.y, area.w, area.h, priv->hba.y, priv->hba.height);
-        }
-        
-        area.x = 0;//event->area.x;
-        area.y = 0;//event->area.y;
-        area.w = gtk_widget_get_allocated_width (widget);//event->area.width;
-        area.h = gtk_widget_get_allocated_height (widget);//event->area.height;
-
-        inline_clip_to_alloc (&area, &priv->spa);
-
-        if (gtk_widget_is_sensitive (widget)) {
-            inline_draw_sv_plane (sel, cr, area.x, area.y, area.w, area.h);
-        } else {
-            inline_draw_sv_plane_dimmed (sel, cr, area.x, area.y, area.w, area.h);
-        }
-    //}
+    /* Only the hue marker and the crosshair are drawn over the cached
+       images, so moving them does not render anything again */
+    if (gtk_widget_is_sensitive (widget)) {
+        inline_draw_hue_bar (widget, cr);
+        inline_draw_sv_plane (sel, cr);
+    } else {
+        inline_draw_hue_bar_dimmed (widget, cr, priv->hba.x, priv->hba.y, priv->hba.width, priv->hba.height, priv->hba.y, priv->hba.height);
+        inline_draw_sv_plane_dimmed (sel, cr, priv->spa.x, priv->spa.y, priv->spa.width, priv->spa.height);
+    }
 
     return FALSE;
 }
 
 
-inline void 
-inline_sub_times                                (GTimeVal *result, 
-                                                 GTimeVal *greater, 
-                                                 GTimeVal *lesser)
+/* The pixels of the hue marker for @hue, see inline_draw_hue_bar() */
+static void
+hue_marker_rect                                 (HildonColorChooserPrivate *priv,
+                                                 unsigned short hue,
+                                                 GdkRectangle *rect)
 {
-    result->tv_sec = greater->tv_sec - lesser->tv_sec;
-    result->tv_usec = greater->tv_usec - lesser->tv_usec;
+    rect->x = priv->hba.x - 1;
+    rect->y = priv->hba.y + (hue * priv->hba.height / 0xffff) - 2;
+    rect->width = priv->hba.width + 2;
+    rect->height = 5;
+}
 
-    if (result->tv_usec < 0) {
-        result->tv_sec--;
-        result->tv_usec += 1000000;
-    }
+/* The pixels of the crosshair for @sat and @val, see
+   inline_draw_crosshair() */
+static void
+crosshair_rect                                  (HildonColorChooserPrivate *priv,
+                                                 unsigned short sat,
+                                                 unsigned short val,
+                                                 GdkRectangle *rect)
+{
+    rect->x = priv->spa.x + (priv->spa.width * val / 0xffff) - 4;
+    rect->y = priv->spa.y + (priv->spa.height * sat / 0xffff) - 4;
+    rect->width = 8;
+    rect->height = 8;
 }
 
+/* Invalidates what changed since the last frame, once per frame
+   however many times the colour changed in between */
 inline void 
 inline_limited_expose                           (HildonColorChooser *sel)
 {
-    GTimeVal curr_time, result;
-    GdkEventExpose event;
+    GtkWidget *widget = GTK_WIDGET (sel);
     HildonColorChooserPrivate *priv; 
 
-    return; //HACK
-   
-    if (! gtk_widget_get_realized (GTK_WIDGET (sel))) {
+    if (! gtk_widget_get_mapped (widget)) {
         return;
     }
 
     priv = HILDON_COLOR_CHOOSER_GET_PRIVATE (sel);
     g_assert (priv);
 
-    if(priv->currhue == priv->expose_info.last_expose_hue) {
-        return; /* no need to redraw */
-    }
-
-    priv->expose_info.last_expose_hue = priv->currhue;
-
-    g_get_current_time (&curr_time);
-
-    inline_sub_times (&result, &curr_time, &priv->expose_info.last_expose_time);
-
-    if(result.tv_sec != 0 || result.tv_usec >= EXPOSE_INTERVAL) {
-
-        priv->expose_info.expose_queued = 1;
-
-        event.type = GDK_EXPOSE;
-        event.area.width = 0;
-        event.area.height = 0;
-        event.window = gtk_widget_get_window (GTK_WIDGET(sel));
-
-        gtk_widget_send_expose(GTK_WIDGET(sel), (GdkEvent *)&event);
-
-    } else if(! priv->expose_info.expose_queued) {
-        priv->expose_info.expose_queued = 1;
-        gdk_threads_add_timeout ((EXPOSE_INTERVAL - result.tv_usec) / 1000, hildon_color_chooser_expose_timer, sel);
+    if (priv->expose_info.tick_id == 0) {
+        priv->expose_info.tick_id = gtk_widget_add_tick_callback (widget,
+                hildon_color_chooser_expose_tick, NULL, NULL);
     }
 }
 
@@ -670,7 +631,7 @@ hildon_color_chooser_button_press               (GtkWidget *widget,
         priv->currval = tmp * 0xffff / priv->spa.width;
 
         g_signal_emit (sel, color_chooser_signals[COLOR_CHANGED], 0);
-        gtk_widget_queue_draw (widget);
+        inline_limited_expose (sel);
 
         priv->mousestate = 1;
         priv->mousein = TRUE;
@@ -684,7 +645,7 @@ hildon_color_chooser_button_press               (GtkWidget *widget,
         priv->currhue = tmp * 0xffff / priv->hba.height;
 
         g_signal_emit (sel, color_chooser_signals[COLOR_CHANGED], 0);
-        gtk_widget_queue_draw (widget);
+        inline_limited_expose (sel);
 
         priv->mousestate = 2;
         priv->mousein = TRUE;
@@ -737,7 +698,7 @@ hildon_color_chooser_pointer_motion             (GtkWidget *widget,
             priv->currval = (((long)(x - priv->spa.x)) * 0xffff) / priv->spa.width;
 
             g_signal_emit (sel, color_chooser_signals[COLOR_CHANGED], 0);
-            gtk_widget_queue_draw(widget);
+            inline_limited_expose (sel);
 
         } else if (priv->mousein == TRUE) {
         }
@@ -753,7 +714,7 @@ hildon_color_chooser_pointer_motion             (GtkWidget *widget,
                 priv->currhue = tmp;
 
                 g_signal_emit (sel, color_chooser_signals[COLOR_CHANGED], 0);
-                gtk_widget_queue_draw(widget);
+                inline_limited_expose (sel);
             }
 
         } else if (priv->mousein == TRUE) {
@@ -811,23 +772,6 @@ init_borders                                    (GtkWidget *w,
     if (inner->top < 2) inner->top = 2;
 }
 
-static void
-draw_rgb_image                                  (cairo_t *cr,
-                                                 unsigned char *data,
-                                                 int x,
-                                                 int y,
-                                                 int width,
-                                                 int height)
-{
-    GdkPixbuf *pixbuf;
-
-    pixbuf = gdk_pixbuf_new_from_data(data, GDK_COLORSPACE_RGB,
-        FALSE, 8, width, height, width * 3, NULL, NULL);
-    gdk_cairo_set_source_pixbuf(cr, pixbuf, x, y);
-    cairo_paint(cr);
-    g_object_unref(pixbuf);
-}
-
 /**
  * hildon_color_chooser_set_color:
  * @chooser: a #HildonColorChooser
@@ -883,7 +827,7 @@ hildon_color_chooser_set_color                  (HildonColorChooser *chooser,
     priv->currsat = sat;
     priv->currval = val;
 
-    gtk_widget_queue_draw (GTK_WIDGET(chooser));
+    inline_limited_expose (chooser);
     g_signal_emit (chooser, color_chooser_signals[COLOR_CHANGED], 0);
 }
 
@@ -999,51 +943,92 @@ intern_h2rgb8                                   (unsigned short hue,
     }
 }
 
-/* optimization: do not ask hue for each round but have bilinear vectors */
-/* rethink: benefits from handling data 8 bit? (no shift round) */
-inline void 
-inline_draw_hue_bar                             (GtkWidget *widget,
-                                                 cairo_t *cr, 
-                                                 int x, 
-                                                 int y, 
-                                                 int w, 
-                                                 int h, 
-                                                 int sy, 
-                                                 int sh)
+static void
+clear_surfaces                                  (HildonColorChooser *sel)
 {
-    HildonColorChooserPrivate *priv = HILDON_COLOR_CHOOSER_GET_PRIVATE (widget);
+    HildonColorChooserPrivate *priv = HILDON_COLOR_CHOOSER_GET_PRIVATE (sel);
 
-    unsigned short hvec, hcurr;
-    unsigned char *buf, *ptr, tmp[3];
-    int i, j, tmpy;
-    GdkRGBA rgba;
     g_assert (priv);
 
-    if (w <= 0 || h <= 0) {
-        return;
+    if (priv->hue_bar != NULL) {
+        cairo_surface_destroy (priv->hue_bar);
+        priv->hue_bar = NULL;
     }
 
-    buf = (unsigned char *) g_malloc (w * h * 3);
+    if (priv->sv_plane != NULL) {
+        cairo_surface_destroy (priv->sv_plane);
+        priv->sv_plane = NULL;
+    }
 
-    hvec = 65535 / sh;
-    hcurr = hvec * (y - sy);
-    
-    ptr = buf;
+    if (priv->dimmed_bar != NULL) {
+        g_object_unref (priv->dimmed_bar);
+        priv->dimmed_bar = NULL;
+    }
+
+    if (priv->dimmed_plane != NULL) {
+        g_object_unref (priv->dimmed_plane);
+        priv->dimmed_plane = NULL;
+    }
+}
+
+/* optimization: do not ask hue for each round but have bilinear vectors */
+static cairo_surface_t *
+create_hue_bar_surface                          (int w,
+                                                 int h)
+{
+    cairo_surface_t *surface;
+    unsigned short hvec, hcurr;
+    unsigned char *data, tmp[3];
+    int i, j, stride;
+
+    surface = cairo_image_surface_create (CAIRO_FORMAT_RGB24, w, h);
+    cairo_surface_flush (surface);
+
+    data = cairo_image_surface_get_data (surface);
+    stride = cairo_image_surface_get_stride (surface);
+
+    hvec = 65535 / h;
+    hcurr = 0;
 
     for (i = 0; i < h; i++) {
+        guint32 *row = (guint32 *) (data + i * stride);
+        guint32 pixel;
+
         intern_h2rgb8 (hcurr, tmp);
+        pixel = (tmp[0] << 16) | (tmp[1] << 8) | tmp[2];
 
         for (j = 0; j < w; j++) {
-            ptr[0] = tmp[0];
-            ptr[1] = tmp[1];
-            ptr[2] = tmp[2];
-            ptr += 3;
+            row[j] = pixel;
         }
 
         hcurr += hvec;
     }
 
-    draw_rgb_image(cr, buf, x, y, w, h);
+    cairo_surface_mark_dirty (surface);
+
+    return surface;
+}
+
+inline void 
+inline_draw_hue_bar                             (GtkWidget *widget,
+                                                 cairo_t *cr)
+{
+    HildonColorChooserPrivate *priv = HILDON_COLOR_CHOOSER_GET_PRIVATE (widget);
+
+    int tmpy;
+    GdkRGBA rgba;
+    g_assert (priv);
+
+    if (priv->hba.width <= 0 || priv->hba.height <= 0) {
+        return;
+    }
+
+    if (priv->hue_bar == NULL) {
+        priv->hue_bar = create_hue_bar_surface (priv->hba.width, priv->hba.height);
+    }
+
+    cairo_set_source_surface (cr, priv->hue_bar, priv->hba.x, priv->hba.y);
+    cairo_paint (cr);
 
     /* trick so we don't have to add 0.5 to all the line calls below */
     //cairo_translate (cr, 0.5, 0.5);
@@ -1063,7 +1048,6 @@ inline_draw_hue_bar                             (GtkWidget *widget,
     }
     cairo_set_line_width(cr, 2);
     cairo_stroke(cr);
-    g_free(buf);
 }
 
 inline void 
@@ -1119,109 +1103,113 @@ inline_draw_hue_bar_dimmed                      (GtkWidget *widget,
     cairo_paint (cr);
 }
 
-inline void 
-inline_draw_crosshair                           (unsigned char *buf, 
-                                                 int x, 
-                                                 int y, 
-                                                 int w, 
-                                                 int h)
+static cairo_surface_t *
+create_crosshair_surface                        (void)
 {
-    int i, j, sx, sy;
+    cairo_surface_t *surface;
+    unsigned char *data;
+    int i, j, stride;
+
+    surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, 8, 8);
+    cairo_surface_flush (surface);
+
+    data = cairo_image_surface_get_data (surface);
+    stride = cairo_image_surface_get_stride (surface);
 
-    /* bad "clipping", clip the loop to save cpu */
     for(i = 0; i < 8; i++) {
+        guint32 *row = (guint32 *) (data + i * stride);
+
         for(j = 0; j < 8; j++) {
-            sx = j + x; sy = i + y;
-
-            if (sx >= 0 && sx < w && sy >= 0 && sy < h) {
-                if (crosshair[j + 8*i]) {
-                    if (crosshair[j + 8*i] & 0x1) {
-                        buf[(sx)*3+(sy)*w*3+0] = 255;
-                        buf[(sx)*3+(sy)*w*3+1] = 255;
-                        buf[(sx)*3+(sy)*w*3+2] = 255;
-                    } else {
-                        buf[(sx)*3+(sy)*w*3+0] = 0;
-                        buf[(sx)*3+(sy)*w*3+1] = 0;
-                        buf[(sx)*3+(sy)*w*3+2] = 0;
-                    }
-                }
+            if (crosshair[j + 8*i] == 0) {
+                row[j] = 0;
+            } else if (crosshair[j + 8*i] & 0x1) {
+                row[j] = 0xffffffff;
+            } else {
+                row[j] = 0xff000000;
             }
         }
     }
+
+    cairo_surface_mark_dirty (surface);
+
+    return surface;
 }
 
 inline void 
-inline_draw_sv_plane                            (HildonColorChooser *sel,
-                                                 cairo_t *cr, 
-                                                 int x, 
-                                                 int y, 
-                                                 int w, 
+inline_draw_crosshair                           (HildonColorChooser *sel,
+                                                 cairo_t *cr)
+{
+    HildonColorChooserPrivate *priv = HILDON_COLOR_CHOOSER_GET_PRIVATE (sel);
+
+    g_assert (priv);
+
+    if (priv->crosshair == NULL) {
+        priv->crosshair = create_crosshair_surface ();
+    }
+
+    /* The crosshair is cut at the edges of the plane */
+    cairo_save (cr);
+    cairo_rectangle (cr, priv->spa.x, priv->spa.y, priv->spa.width, priv->spa.height);
+    cairo_clip (cr);
+    cairo_set_source_surface (cr, priv->crosshair,
+            priv->spa.x + (priv->spa.width * priv->currval / 0xffff) - 4,
+            priv->spa.y + (priv->spa.height * priv->currsat / 0xffff) - 4);
+    cairo_paint (cr);
+    cairo_restore (cr);
+}
+
+static cairo_surface_t *
+create_sv_plane_surface                         (unsigned short hue,
+                                                 int w,
                                                  int h)
 {
-    GtkWidget *widget = GTK_WIDGET (sel);
-    unsigned char *buf, *ptr;
-    unsigned long rgbx[3] = { 0x00ffffff, 0x00ffffff, 0x00ffffff }, rgbtmp[3];
-    signed long rgby[3];
+    cairo_surface_t *surface;
+    unsigned long rgb[3];
+
+    surface = cairo_image_surface_create (CAIRO_FORMAT_RGB24, w, h);
+    cairo_surface_flush (surface);
+
+    inline_h2rgb (hue, rgb);
+
+    /* See hildon-color-chooser-raster.c */
+    hildon_color_chooser_raster_sv_plane (rgb,
+                                          cairo_image_surface_get_data (surface),
+                                          cairo_image_surface_get_stride (surface),
+                                          w, h);
+
+    cairo_surface_mark_dirty (surface);
+
+    return surface;
+}
+
+inline void 
+inline_draw_sv_plane                            (HildonColorChooser *sel,
+                                                 cairo_t *cr)
+{
     HildonColorChooserPrivate *priv;
-    int i, j;
-    int tmp;
 
-    if (w <= 0 || h <= 0) {
+    priv = HILDON_COLOR_CHOOSER_GET_PRIVATE (sel);
+    g_assert (priv);
+
+    if (priv->spa.width <= 0 || priv->spa.height <= 0) {
         return;
     }
 
-    priv = HILDON_COLOR_CHOOSER_GET_PRIVATE (sel);
-    g_assert (priv);
-    tmp = priv->spa.width * priv->spa.height;
-
-    buf = (unsigned char *) g_malloc (w * h * 3);
-    ptr = buf;
-
-    inline_h2rgb (priv->currhue, rgbtmp);
-
-    rgby[0] = rgbtmp[0] - rgbx[0];
-    rgby[1] = rgbtmp[1] - rgbx[1];
-    rgby[2] = rgbtmp[2] - rgbx[2];
-
-    rgbx[0] /= priv->spa.width;
-    rgbx[1] /= priv->spa.width;
-    rgbx[2] /= priv->spa.width;
-
-    rgby[0] /= tmp;
-    rgby[1] /= tmp;
-    rgby[2] /= tmp;
-
-    rgbx[0] += (y - priv->spa.y) * rgby[0];
-    rgbx[1] += (y - priv->spa.y) * rgby[1];
-    rgbx[2] += (y - priv->spa.y) * rgby[2];
-
-    for(i = 0; i < h; i++) {
-        rgbtmp[0] = rgbx[0] * (x - priv->spa.x);
-        rgbtmp[1] = rgbx[1] * (x - priv->spa.x);
-        rgbtmp[2] = rgbx[2] * (x - priv->spa.x);
-
-        for(j = 0; j < w; j++) {
-            ptr[0] = rgbtmp[0] >> 16;
-            ptr[1] = rgbtmp[1] >> 16;
-            ptr[2] = rgbtmp[2] >> 16;
-            rgbtmp[0] += rgbx[0];
-            rgbtmp[1] += rgbx[1];
-            rgbtmp[2] += rgbx[2];
-            ptr += 3;
-        }
+    /* Only a new hue needs the plane to be rendered again */
+    if (priv->sv_plane != NULL && priv->sv_plane_hue != priv->currhue) {
+        cairo_surface_destroy (priv->sv_plane);
+        priv->sv_plane = NULL;
+    }
 
-        rgbx[0] += rgby[0];
-        rgbx[1] += rgby[1];
-        rgbx[2] += rgby[2];
+    if (priv->sv_plane == NULL) {
+        priv->sv_plane = create_sv_plane_surface (priv->currhue, priv->spa.width, priv->spa.height);
+        priv->sv_plane_hue = priv->currhue;
     }
 
-    inline_draw_crosshair (buf, 
-            (priv->spa.width * priv->currval / 0xffff) - x + priv->spa.x - 4, 
-            (priv->spa.height * priv->currsat / 0xffff) - y + priv->spa.y - 4, 
-            w, h);
+    cairo_set_source_surface (cr, priv->sv_plane, priv->spa.x, priv->spa.y);
+    cairo_paint (cr);
 
-    draw_rgb_image(cr, buf, x, y, w, h);
-    g_free(buf);
+    inline_draw_crosshair (sel, cr);
 }
 
 inline void 
@@ -1322,18 +1310,48 @@ inline_draw_sv_plane_dimmed                     (HildonColorChooser *sel,
 
 
 static gboolean 
-hildon_color_chooser_expose_timer               (gpointer data)
+hildon_color_chooser_expose_tick                (GtkWidget *widget,
+                                                 GdkFrameClock *frame_clock,
+                                                 gpointer data)
 {
-    HildonColorChooser *sel = HILDON_COLOR_CHOOSER (data);
-    HildonColorChooserPrivate *priv = HILDON_COLOR_CHOOSER_GET_PRIVATE (sel);
+    HildonColorChooserPrivate *priv = HILDON_COLOR_CHOOSER_GET_PRIVATE (widget);
+    cairo_region_t *region;
+    GdkRectangle rect;
 
     g_assert (priv);
 
-    if (priv->expose_info.expose_queued) {
-        gtk_widget_queue_draw (GTK_WIDGET (data));
+    priv->expose_info.tick_id = 0;
+
+    region = cairo_region_create ();
+
+    if (priv->currhue != priv->expose_info.last_expose_hue) {
+        hue_marker_rect (priv, priv->expose_info.last_expose_hue, &rect);
+        cairo_region_union_rectangle (region, &rect);
+        hue_marker_rect (priv, priv->currhue, &rect);
+        cairo_region_union_rectangle (region, &rect);
+
+        /* A new hue is a new plane, with the crosshair on it */
+        cairo_region_union_rectangle (region, &priv->spa);
+    } else if (priv->currsat != priv->expose_info.last_expose_sat ||
+               priv->currval != priv->expose_info.last_expose_val) {
+        crosshair_rect (priv, priv->expose_info.last_expose_sat,
+                        priv->expose_info.last_expose_val, &rect);
+        cairo_region_union_rectangle (region, &rect);
+        crosshair_rect (priv, priv->currsat, priv->currval, &rect);
+        cairo_region_union_rectangle (region, &rect);
     }
 
-    return FALSE;
+    priv->expose_info.last_expose_hue = priv->currhue;
+    priv->expose_info.last_expose_sat = priv->currsat;
+    priv->expose_info.last_expose_val = priv->currval;
+
+    if (! cairo_region_is_empty (region)) {
+        gtk_widget_queue_draw_region (widget, region);
+    }
+
+    cairo_region_destroy (region);
+
+    return G_SOURCE_REMOVE;
 }
 
 /**
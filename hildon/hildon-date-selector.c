@@ -48,6 +48,7 @@
 #include <langinfo.h>
 
 #include "hildon-date-selector.h"
+#include "hildon-touch-selector-private.h"
 
 #define HILDON_DATE_SELECTOR_GET_PRIVATE(obj)                           \
   (G_TYPE_INSTANCE_GET_PRIVATE ((obj), HILDON_TYPE_DATE_SELECTOR, HildonDateSelectorPrivate))
@@ -529,9 +530,8 @@ _init_column_order (HildonDateSelector * selector)
   }
 }
 
-
 static GtkTreeModel *
-_create_day_model (HildonDateSelector * selector)
+_build_day_model (gpointer data)
 {
   GtkListStore *store_days = NULL;
   gint i = 0;
@@ -552,18 +552,47 @@ _create_day_model (HildonDateSelector * selector)
   return GTK_TREE_MODEL (store_days);
 }
 
+static gboolean
+_day_visible_func (GtkTreeModel *model,
+                   GtkTreeIter *iter,
+                   gpointer data)
+{
+  HildonDateSelector *selector = HILDON_DATE_SELECTOR (data);
+  gint day = 0;
+
+  gtk_tree_model_get (model, iter, COLUMN_INT, &day, -1);
+
+  return day <= selector->priv->current_num_days;
+}
+
+/* All the days are in a shared model, the filter of each selector
+   hides the days that the current month doesn't have */
 static GtkTreeModel *
-_create_year_model (HildonDateSelector * selector)
+_create_day_model (HildonDateSelector * selector)
 {
+  GtkTreeModel *filter;
+  gchar *key;
+
+  key = hildon_touch_selector_shared_model_key ("day", _("wdgt_va_day_numeric"));
+  filter = hildon_touch_selector_get_shared_model (key, _build_day_model, NULL);
+  g_free (key);
+
+  gtk_tree_model_filter_set_visible_func (GTK_TREE_MODEL_FILTER (filter),
+                                          _day_visible_func, selector, NULL);
+
+  return filter;
+}
+
+static GtkTreeModel *
+_build_year_model (gpointer data)
+{
+  HildonDateSelector *selector = HILDON_DATE_SELECTOR (data);
   GtkListStore *store_years = NULL;
-  gint real_year = 0;
   gint i = 0;
-  static gchar label[255];
+  gchar label[255];
   struct tm tm = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
   GtkTreeIter iter;
 
-  real_year = selector->priv->creation_year;
-
   store_years = gtk_list_store_new (2, G_TYPE_STRING, G_TYPE_INT);
   for (i = selector->priv->min_year; i < selector->priv->max_year + 1; i++) {
     tm.tm_year = i - 1900;
@@ -578,12 +607,29 @@ _create_year_model (HildonDateSelector * selector)
 }
 
 static GtkTreeModel *
-_create_month_model (HildonDateSelector * selector)
+_create_year_model (HildonDateSelector * selector)
+{
+  GtkTreeModel *model;
+  gchar *name;
+  gchar *key;
+
+  name = g_strdup_printf ("year:%d:%d",
+                          selector->priv->min_year, selector->priv->max_year);
+  key = hildon_touch_selector_shared_model_key (name, _("wdgt_va_year"));
+  model = hildon_touch_selector_get_shared_model (key, _build_year_model, selector);
+  g_free (key);
+  g_free (name);
+
+  return model;
+}
+
+static GtkTreeModel *
+_build_month_model (gpointer data)
 {
   GtkTreeIter iter;
   gint i = 0;
   GtkListStore *store_months = NULL;
-  static gchar label[255];
+  gchar label[255];
   struct tm tm = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
 
   store_months = gtk_list_store_new (2, G_TYPE_STRING, G_TYPE_INT);
@@ -600,15 +646,22 @@ _create_month_model (HildonDateSelector * selector)
   return GTK_TREE_MODEL (store_months);
 }
 
+static GtkTreeModel *
+_create_month_model (HildonDateSelector * selector)
+{
+  GtkTreeModel *model;
+  gchar *key;
+
+  key = hildon_touch_selector_shared_model_key ("month", _("wdgt_va_month"));
+  model = hildon_touch_selector_get_shared_model (key, _build_month_model, NULL);
+  g_free (key);
+
+  return model;
+}
+
 static GtkTreeModel *
 _update_day_model (HildonDateSelector * selector)
 {
-  GtkListStore *store_days = NULL;
-  GtkTreePath *path = NULL;
-  gint i = 0;
-  GtkTreeIter iter;
-  static gchar label[255];
-  struct tm tm = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
   guint current_day = 0;
   guint current_year = 0;
   guint current_month = 0;
@@ -618,33 +671,13 @@ _update_day_model (HildonDateSelector * selector)
                                  &current_day);
 
   num_days = _month_days (current_month, current_year);
-  store_days = GTK_LIST_STORE (selector->priv->day_model);
 
   if (num_days == selector->priv->current_num_days) {
-    return GTK_TREE_MODEL (store_days);
+    return selector->priv->day_model;
   }
 
-  if (num_days > selector->priv->current_num_days) {
-    for (i = selector->priv->current_num_days + 1; i <= num_days; i++) {
-      tm.tm_mday = i;
-      strftime (label, 255, _("wdgt_va_day_numeric"), &tm);
-
-      gtk_list_store_append (store_days, &iter);
-      gtk_list_store_set (store_days, &iter,
-                          COLUMN_STRING, label, COLUMN_INT, i, -1);
-    }
-  } else {
-    path = gtk_tree_path_new_from_indices (num_days,
-                                           -1);
-    gtk_tree_model_get_iter (GTK_TREE_MODEL (store_days), &iter, path);
-    do {
-    }while (gtk_list_store_remove (store_days, &iter));
-
-    gtk_tree_path_free (path);
-  }
-
-
   selector->priv->current_num_days = num_days;
+  gtk_tree_model_filter_refilter (GTK_TREE_MODEL_FILTER (selector->priv->day_model));
 
   /* now we select a day */
   if (current_day >= num_days) {
@@ -653,10 +686,9 @@ _update_day_model (HildonDateSelector * selector)
 
   hildon_date_selector_select_day (selector, current_day);
 
-  return GTK_TREE_MODEL (store_days);
+  return selector->priv->day_model;
 }
 
-
 static void
 _get_real_date (gint * year, gint * month, gint * day)
 {
@@ -42,6 +42,14 @@
 #include                                        "hildon-helper.h"
 #include                                        "hildon-banner.h"
 
+#if defined(__SSE2__)
+#include                                        <emmintrin.h>
+#define                                         HILDON_HELPER_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include                                        <arm_neon.h>
+#define                                         HILDON_HELPER_NEON
+#endif
+
 #define                                         HILDON_FINGER_PRESSURE_THRESHOLD 0.4
 
 #define                                         HILDON_FINGER_BUTTON 8
@@ -567,14 +575,177 @@ hildon_format_file_size_for_display             (goffset size)
 }
 
 
-/**
- * stripped_char:
+/*
+ * IMPLEMENTATION NOTES:
+ * Both hildon_helper_smart_match() and
+ * hildon_helper_utf8_strstrcasedecomp_needle_stripped() look for a
+ * needle at the start of the words of the haystack. When both are
+ * ASCII, this is done 16 bytes at a time with SSE2 or NEON: the bytes
+ * of the haystack are compared to the first byte of the needle with
+ * the case bit (0x20) set on both sides, and only the few candidates
+ * found this way are checked for a word start and the rest of the
+ * needle. Without SIMD support, the same search is done a byte at a
+ * time.
  *
- * Returns a stripped version of @ch, removing any case, accentuation
- * mark, or any special mark on it.
- **/
+ * The SIMD helpers return a mask with SIMD_MASK_BITS bits set for
+ * each matching byte, SSE2 having _mm_movemask_epi8() and NEON needing
+ * a narrowing shift instead.
+ */
+#if defined(HILDON_HELPER_SSE2)
+
+#define                                         SIMD_MASK_BITS 1
+
+static inline guint64
+simd_mask_folded_eq (const guchar *p, guchar c)
+{
+  __m128i v = _mm_loadu_si128 ((const __m128i *) p);
+
+  v = _mm_or_si128 (v, _mm_set1_epi8 (0x20));
+  return (guint) _mm_movemask_epi8 (_mm_cmpeq_epi8 (v, _mm_set1_epi8 ((gchar) c)));
+}
+
+static inline guint64
+simd_mask_non_ascii (const guchar *p)
+{
+  return (guint) _mm_movemask_epi8 (_mm_loadu_si128 ((const __m128i *) p));
+}
+
+#elif defined(HILDON_HELPER_NEON)
+
+#define                                         SIMD_MASK_BITS 4
+
+static inline guint64
+simd_mask_from_bytes (uint8x16_t bytes)
+{
+  uint8x8_t nibbles = vshrn_n_u16 (vreinterpretq_u16_u8 (bytes), 4);
+
+  return vget_lane_u64 (vreinterpret_u64_u8 (nibbles), 0);
+}
+
+static inline guint64
+simd_mask_folded_eq (const guchar *p, guchar c)
+{
+  uint8x16_t v = vorrq_u8 (vld1q_u8 (p), vdupq_n_u8 (0x20));
+
+  return simd_mask_from_bytes (vceqq_u8 (v, vdupq_n_u8 (c)));
+}
+
+static inline guint64
+simd_mask_non_ascii (const guchar *p)
+{
+  return simd_mask_from_bytes (vcgeq_u8 (vld1q_u8 (p), vdupq_n_u8 (0x80)));
+}
+
+#endif
+
+#if defined(SIMD_MASK_BITS)
+
+/* Index of the first matching byte in @mask, and @mask without it */
+static inline guint
+simd_mask_next (guint64 *mask)
+{
+  guint bit = __builtin_ctzll (*mask);
+
+  *mask &= ~((((guint64) 1 << SIMD_MASK_BITS) - 1) << bit);
+
+  return bit / SIMD_MASK_BITS;
+}
+
+#endif
+
+/*
+ * Returns the length of the run of ASCII characters at the start of
+ * @string, @len bytes long.
+ */
+static gsize
+ascii_prefix_length (const guchar *string, gsize len)
+{
+  gsize i = 0;
+
+#if defined(SIMD_MASK_BITS)
+  for (; i + 16 <= len; i += 16) {
+    guint64 mask = simd_mask_non_ascii (string + i);
+
+    if (mask)
+      return i + simd_mask_next (&mask);
+  }
+#endif
+
+  for (; i < len; i++)
+    if (string[i] & 0x80)
+      return i;
+
+  return len;
+}
+
+static inline gboolean
+ascii_word_starts_with (const guchar *haystack,
+                        gsize         pos,
+                        const guchar *needle,
+                        gsize         nlen)
+{
+  gsize i;
+
+  if (pos > 0 && g_ascii_isalnum (haystack[pos - 1]))
+    return FALSE;
+
+  for (i = 0; i < nlen; i++)
+    if (g_ascii_tolower (haystack[pos + i]) != needle[i])
+      return FALSE;
+
+  return TRUE;
+}
+
+/*
+ * ascii_word_search:
+ *
+ * Finds the first word of @haystack, @len bytes long, starting with
+ * @needle regardless of the ASCII case. @needle must be lowercase, and
+ * start with an alphanumeric character. Bytes out of the ASCII range
+ * separate words. Only matches ending within @len are found.
+ *
+ * Returns: the offset of the match in @haystack, or -1.
+ */
+static gssize
+ascii_word_search (const guchar *haystack,
+                   gsize         len,
+                   const guchar *needle,
+                   gsize         nlen)
+{
+  gsize last, i = 0;
+  guchar first = needle[0] | 0x20;
+
+  if (nlen == 0 || nlen > len)
+    return -1;
+
+  /* Last offset where the needle fits */
+  last = len - nlen;
+
+#if defined(SIMD_MASK_BITS)
+  for (; i + 16 <= last + 1; i += 16) {
+    guint64 mask = simd_mask_folded_eq (haystack + i, first);
+
+    while (mask) {
+      gsize pos = i + simd_mask_next (&mask);
+
+      if (ascii_word_starts_with (haystack, pos, needle, nlen))
+        return pos;
+    }
+  }
+#endif
+
+  for (; i <= last; i++)
+    if ((haystack[i] | 0x20) == first &&
+        ascii_word_starts_with (haystack, i, needle, nlen))
+      return i;
+
+  return -1;
+}
+
+
+/* Computes the stripped version of @ch, see stripped_char() */
 static gunichar
-stripped_char (gunichar ch)
+compute_stripped_char (gunichar ch)
 {
   gunichar decomp[4];
   gunichar retval;
@@ -605,6 +776,54 @@ stripped_char (gunichar ch)
   return 0;
 }
 
+/*
+ * IMPLEMENTATION NOTES:
+ * Stripping a character takes several lookups in the Unicode tables,
+ * for every character of every string searched. The stripped versions
+ * of the characters of the Basic Multilingual Plane are kept in a
+ * table instead, made of blocks of STRIPPED_BLOCK_SIZE characters that
+ * are filled the first time one of their characters is stripped. Names
+ * only use a few of these blocks (Latin, Greek, Cyrillic...). The
+ * blocks are never freed, and can be filled from any thread.
+ */
+#define                                         STRIPPED_BLOCK_SIZE 256
+
+#define                                         STRIPPED_N_BLOCKS (0x10000 / STRIPPED_BLOCK_SIZE)
+
+static const gunichar *
+stripped_block (guint index)
+{
+  static gsize blocks[STRIPPED_N_BLOCKS];
+
+  if (g_once_init_enter (&blocks[index])) {
+    gunichar *block = g_new (gunichar, STRIPPED_BLOCK_SIZE);
+    gunichar first = index * STRIPPED_BLOCK_SIZE;
+    guint i;
+
+    for (i = 0; i < STRIPPED_BLOCK_SIZE; i++)
+      block[i] = compute_stripped_char (first + i);
+
+    g_once_init_leave (&blocks[index], (gsize) block);
+  }
+
+  return (const gunichar *) blocks[index];
+}
+
+/**
+ * stripped_char:
+ *
+ * Returns a stripped version of @ch, removing any case, accentuation
+ * mark, or any special mark on it.
+ **/
+static inline gunichar
+stripped_char (gunichar ch)
+{
+  if (ch >= 0x10000)
+    return compute_stripped_char (ch);
+
+  return stripped_block (ch / STRIPPED_BLOCK_SIZE)[ch % STRIPPED_BLOCK_SIZE];
+}
+
 static gchar *
 e_util_unicode_get_utf8 (const gchar *text, gunichar *out)
 {
@@ -646,6 +865,9 @@ get_next (const gchar *p, const gchar **o, gunichar *out, gboolean separators)
   return p;
 }
 
+static const gchar *
+strstrcasedecomp_needle_stripped (const gchar *haystack, const gunichar *nuni);
+
 /**
  * hildon_helper_utf8_strstrcasedecomp_needle_stripped:
  * @haystack: a haystack where to search
@@ -671,14 +893,56 @@ get_next (const gchar *p, const gchar **o, gunichar *out, gboolean separators)
  **/
 const gchar *
 hildon_helper_utf8_strstrcasedecomp_needle_stripped (const gchar *haystack, const gunichar *nuni)
+{
+  guchar needle[64];
+  const guchar *h = (const guchar *) haystack;
+  gsize len, ascii_len, nlen = 0, restart;
+  gssize pos;
+
+  if (haystack == NULL) return NULL;
+  if (nuni == NULL) return NULL;
+
+  /* The fast path handles ASCII needles starting a word */
+  while (nuni[nlen] != 0) {
+    if (nlen == sizeof (needle) || nuni[nlen] >= 0x80)
+      return strstrcasedecomp_needle_stripped (haystack, nuni);
+    needle[nlen] = nuni[nlen];
+    nlen++;
+  }
+
+  if (nlen == 0 || !g_ascii_isalnum (needle[0]))
+    return strstrcasedecomp_needle_stripped (haystack, nuni);
+
+  len = strlen (haystack);
+  ascii_len = ascii_prefix_length (h, len);
+
+  /* In ASCII, stripping a character only lowers its case */
+  pos = ascii_word_search (h, ascii_len, needle, nlen);
+  if (pos >= 0)
+    return haystack + pos;
+
+  if (ascii_len == len)
+    return NULL;
+
+  /* The words that may match past the ASCII run are left to the
+     complete search, restarting where a word can start */
+  restart = ascii_len + 1 > nlen ? ascii_len + 1 - nlen : 0;
+  while (restart > 0 && g_ascii_isalnum (h[restart - 1]) &&
+         (restart == ascii_len || g_ascii_isalnum (h[restart])))
+    restart--;
+
+  return strstrcasedecomp_needle_stripped (haystack + restart, nuni);
+}
+
+/* Complete search, decomposing each character of @haystack */
+static const gchar *
+strstrcasedecomp_needle_stripped (const gchar *haystack, const gunichar *nuni)
 {
   gunichar unival;
   gint nlen = 0;
   const gchar *o, *p;
   gunichar sc;
 
-  if (haystack == NULL) return NULL;
-  if (nuni == NULL) return NULL;
   if (strlen (haystack) == 0) return NULL;
   while (*(nuni + nlen) != 0) nlen++;
 
@@ -803,8 +1067,21 @@ hildon_helper_smart_match (const gchar *haystack, const gchar *needle)
     if (strlen (haystack) == 0) return NULL;
 
     gboolean skip_separators = g_ascii_isalnum (needle[0]);
+    gsize nlen = strlen (needle);
+
+    if (skip_separators && nlen <= 64) {
+        guchar lower[64];
+        gssize pos;
+        gsize i;
+
+        for (i = 0; i < nlen; i++)
+            lower[i] = g_ascii_tolower (needle[i]);
+
+        pos = ascii_word_search ((const guchar *) haystack, strlen (haystack),
+                                 lower, nlen);
 
-    if (skip_separators) {
+        return pos >= 0 ? (gchar *) haystack + pos : NULL;
+    } else if (skip_separators) {
         gint i = 0;
         while (haystack[i] != '\0') {
             while (haystack[i] != '\0' && !g_ascii_isalnum (haystack[i]))
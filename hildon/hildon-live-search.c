@@ -34,8 +34,27 @@
  * necessary, you can use hildon_live_search_set_visible_func() to
  * specify a #HildonLiveSearchVisibleFunc to use.
  *
+ * When the text in the entry only grows, the new set of visible rows
+ * is a subset of the previous one. #HildonLiveSearch takes advantage
+ * of this with the default filtering function, and with custom ones
+ * when #HildonLiveSearch:incremental is set: rows hidden for the
+ * previous text are not tested again.
+ *
+ * For large lists of names, such as contacts or media titles,
+ * hildon_live_search_set_match_column() filters by matching each word
+ * of the text against the beginning of the words in a column, the
+ * same way #HildonTouchSelector does. The rows are then matched on
+ * #HildonLiveSearch:match-threads worker threads, and the filter is
+ * updated in one go when they are done.
+ *
+ * With #HildonLiveSearch:ranked set, the words of the text may also
+ * match in the middle of words, skip characters or contain a typo,
+ * and hildon_live_search_get_ranked_model() sorts the visible rows
+ * from the best match to the worst.
+ *
  */
 
+#define _GNU_SOURCE
 #include                                        "hildon-live-search.h"
 
 #include                                        <hildon/hildon.h>
@@ -48,6 +67,36 @@ G_DEFINE_TYPE (HildonLiveSearch, hildon_live_search, GTK_TYPE_TOOLBAR);
                                                 HILDON_TYPE_LIVE_SEARCH,           \
                                                 HildonLiveSearchPrivate))
 
+/* Time spent testing rows in each slice of a chunked refilter, in
+   microseconds */
+#define                                         CHUNK_TIME_BUDGET 4000
+
+/* Rows tested between two checks of the time budget */
+#define                                         CHUNK_CHECK_INTERVAL 64
+
+/* Rows normalized and matched by each task of a threaded match */
+#define                                         MATCH_RANGE_SIZE 4096
+
+/* Scores of the ways a word of the text can match a row, see
+   match_token_score() */
+#define                                         SCORE_PREFIX 1000
+#define                                         SCORE_WORD_START 800
+#define                                         SCORE_SUBSTRING 400
+#define                                         SCORE_SUBSEQUENCE 200
+#define                                         SCORE_TYPO 100
+#define                                         SCORE_PENALTY_MAX 99
+
+typedef enum
+{
+    SELECTION_KEY_ID_COLUMN,
+    SELECTION_KEY_ITER,
+    SELECTION_KEY_PATH
+} SelectionKeyType;
+
+typedef struct _MatchSnapshot                   MatchSnapshot;
+
+typedef struct _MatchJob                        MatchJob;
+
 struct _HildonLiveSearchPrivate
 {
     GtkTreeModelFilter *filter;
@@ -57,6 +106,8 @@ struct _HildonLiveSearchPrivate
     GtkWidget *entry;
     GtkWidget *event_widget;
     GHashTable *selection_map;
+    SelectionKeyType selection_key;
+    gint id_column;
 
     gulong key_press_id;
     gulong event_widget_destroy_id;
@@ -71,6 +122,48 @@ struct _HildonLiveSearchPrivate
     GDestroyNotify visible_destroy;
     gboolean visible_func_set;
     gboolean run_async;
+
+    /* Incremental filtering */
+    gboolean incremental;
+    gboolean refiltering;
+    gboolean narrowing;
+    GHashTable *hidden_rows;
+    gboolean hidden_rows_valid;
+    gchar *hidden_prefix;
+    GtkTreeModel *base_model;
+    gulong row_inserted_id;
+    gulong row_changed_id;
+    gulong row_deleted_id;
+    gulong rows_reordered_id;
+
+    /* Chunked filtering */
+    gboolean chunked;
+    guint chunk_source_id;
+    GtkTreeIter chunk_iter;
+    gboolean chunk_iter_valid;
+    gboolean chunk_narrowing;
+    gboolean chunk_publishing;
+    GHashTable *chunk_results;
+    GArray *chunk_changed;
+
+    /* Threaded matching */
+    gint match_column;
+    guint match_threads;
+    GThreadPool *match_pool;
+    MatchSnapshot *match_snapshot;
+    GHashTable *match_changed_rows;
+    gboolean match_order_valid;
+    MatchJob *match_job;
+    MatchJob *match_done;
+    gboolean match_applying;
+    gchar **match_tokens;
+    gchar *match_tokens_text;
+
+    /* Ranked matching */
+    gboolean ranked;
+    GtkTreeModel *ranked_model;
+    GHashTable *rank_scores;
+    gchar *rank_scores_text;
 };
 
 enum
@@ -80,7 +173,13 @@ enum
     PROP_FILTER,
     PROP_WIDGET,
     PROP_TEXT_COLUMN,
-    PROP_TEXT
+    PROP_TEXT,
+    PROP_INCREMENTAL,
+    PROP_ID_COLUMN,
+    PROP_CHUNKED,
+    PROP_MATCH_COLUMN,
+    PROP_MATCH_THREADS,
+    PROP_RANKED
 };
 
 enum
@@ -96,40 +195,112 @@ visible_func                                    (GtkTreeModel *model,
                                                  GtkTreeIter  *iter,
                                                  gpointer      data);
 
+static void
+match_job_cancel                                (HildonLiveSearchPrivate *priv);
+
+static void
+match_snapshot_row_changed                      (HildonLiveSearchPrivate *priv,
+                                                 GtkTreeIter             *iter);
+
+static void
+match_snapshot_invalidate                       (HildonLiveSearchPrivate *priv);
+
+static void
+ranked_model_resort                             (HildonLiveSearchPrivate *priv);
+
 /* Private implementation */
 
-static guint
-hash_func                                       (gconstpointer key)
+/*
+ * IMPLEMENTATION NOTES:
+ * The selection map remembers the rows of the child model which are
+ * selected, so that the selection survives the rows being filtered out
+ * and in again. Rows are stored as #GtkTreeRowReference values, keyed by
+ * an identity of the row that can be computed in constant time:
+ *
+ * - the value of #HildonLiveSearch:id-column, converted to a string,
+ *   when it is set;
+ * - the iter, for child models whose iters persist. Since iters can be
+ *   reused once a row is deleted, the row reference is used to check
+ *   that the entry still belongs to the row;
+ * - the path of the row as a string otherwise. Paths change when rows
+ *   are added or removed, so the map is re-keyed before being used.
+ */
+static gpointer
+selection_map_key_for_iter                      (HildonLiveSearchPrivate *priv,
+                                                 GtkTreeModel            *base_model,
+                                                 GtkTreeIter             *iter)
+{
+    gpointer key = NULL;
+
+    switch (priv->selection_key) {
+    case SELECTION_KEY_ID_COLUMN: {
+        GValue value = G_VALUE_INIT;
+        GValue string_value = G_VALUE_INIT;
+
+        gtk_tree_model_get_value (base_model, iter, priv->id_column, &value);
+        g_value_init (&string_value, G_TYPE_STRING);
+        if (g_value_transform (&value, &string_value))
+            key = g_value_dup_string (&string_value);
+        g_value_unset (&string_value);
+        g_value_unset (&value);
+        break;
+    }
+    case SELECTION_KEY_ITER:
+        key = iter->user_data;
+        break;
+    case SELECTION_KEY_PATH: {
+        GtkTreePath *path = gtk_tree_model_get_path (base_model, iter);
+        key = gtk_tree_path_to_string (path);
+        gtk_tree_path_free (path);
+        break;
+    }
+    }
+
+    return key;
+}
+
+static gpointer
+selection_map_key_for_path                      (HildonLiveSearchPrivate *priv,
+                                                 GtkTreeModel            *base_model,
+                                                 GtkTreePath             *base_path)
 {
-    GtkTreePath *path;
-    gchar *path_str;
-    guint val;
+    GtkTreeIter iter;
+
+    if (priv->selection_key == SELECTION_KEY_PATH)
+        return gtk_tree_path_to_string (base_path);
 
-    path = gtk_tree_row_reference_get_path ((GtkTreeRowReference *) key);
-    path_str = gtk_tree_path_to_string (path);
-    val = g_str_hash (path_str);
-    g_free (path_str);
-    gtk_tree_path_free (path);
+    if (!gtk_tree_model_get_iter (base_model, &iter, base_path))
+        return NULL;
 
-    return val;
+    return selection_map_key_for_iter (priv, base_model, &iter);
 }
 
-static gboolean
-key_equal_func                                  (gconstpointer v1,
-                                                 gconstpointer v2)
+static void
+selection_map_key_free                          (HildonLiveSearchPrivate *priv,
+                                                 gpointer                 key)
+{
+    if (priv->selection_key != SELECTION_KEY_ITER)
+        g_free (key);
+}
+
+static GHashTable *
+selection_map_new                               (HildonLiveSearchPrivate *priv)
 {
-    gboolean ret;
-    GtkTreePath *path1;
-    GtkTreePath *path2;
+    GtkTreeModel *base_model = gtk_tree_model_filter_get_model (priv->filter);
 
-    path1 = gtk_tree_row_reference_get_path ((GtkTreeRowReference *) v1);
-    path2 = gtk_tree_row_reference_get_path ((GtkTreeRowReference *) v2);
-    ret = gtk_tree_path_compare (path1, path2) == 0;
+    if (priv->id_column != -1)
+        priv->selection_key = SELECTION_KEY_ID_COLUMN;
+    else if (gtk_tree_model_get_flags (base_model) & GTK_TREE_MODEL_ITERS_PERSIST)
+        priv->selection_key = SELECTION_KEY_ITER;
+    else
+        priv->selection_key = SELECTION_KEY_PATH;
 
-    gtk_tree_path_free (path1);
-    gtk_tree_path_free (path2);
+    if (priv->selection_key == SELECTION_KEY_ITER)
+        return g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL,
+                                      (GDestroyNotify) gtk_tree_row_reference_free);
 
-    return ret;
+    return g_hash_table_new_full (g_str_hash, g_str_equal, g_free,
+                                  (GDestroyNotify) gtk_tree_row_reference_free);
 }
 
 /**
@@ -147,10 +318,7 @@ selection_map_create                            (HildonLiveSearchPrivate *priv)
 
     g_assert (priv->selection_map == NULL);
 
-    priv->selection_map = g_hash_table_new_full
-        (hash_func, key_equal_func,
-         (GDestroyNotify) gtk_tree_row_reference_free, NULL);
-
+    priv->selection_map = selection_map_new (priv);
 }
 
 /**
@@ -168,6 +336,94 @@ selection_map_destroy                           (HildonLiveSearchPrivate *priv)
     }
 }
 
+/**
+ * selection_map_rekey:
+ * @priv: The private pimpl
+ *
+ * Computes again the keys of all the rows in the selection map,
+ * dropping the rows which don't exist anymore.
+ **/
+static void
+selection_map_rekey                             (HildonLiveSearchPrivate *priv)
+{
+    GtkTreeModel *base_model;
+    GHashTable *old_map;
+    GHashTableIter iter;
+    gpointer value;
+
+    if (priv->selection_map == NULL)
+        return;
+
+    base_model = gtk_tree_model_filter_get_model (priv->filter);
+    old_map = priv->selection_map;
+    priv->selection_map = selection_map_new (priv);
+
+    g_hash_table_iter_init (&iter, old_map);
+    while (g_hash_table_iter_next (&iter, NULL, &value)) {
+        GtkTreeRowReference *row_ref = value;
+        GtkTreePath *base_path = gtk_tree_row_reference_get_path (row_ref);
+        gpointer key;
+
+        if (base_path == NULL)
+            continue;
+
+        key = selection_map_key_for_path (priv, base_model, base_path);
+        if (key != NULL) {
+            g_hash_table_replace (priv->selection_map, key,
+                                  gtk_tree_row_reference_copy (row_ref));
+        }
+        gtk_tree_path_free (base_path);
+    }
+
+    g_hash_table_destroy (old_map);
+}
+
+static void
+selection_map_add                               (HildonLiveSearchPrivate *priv,
+                                                 GtkTreeModel            *base_model,
+                                                 GtkTreePath             *base_path)
+{
+    gpointer key;
+
+    key = selection_map_key_for_path (priv, base_model, base_path);
+    if (key == NULL)
+        return;
+
+    g_hash_table_replace (priv->selection_map, key,
+                          gtk_tree_row_reference_new (base_model, base_path));
+}
+
+static gboolean
+selection_map_contains                          (HildonLiveSearchPrivate *priv,
+                                                 GtkTreeModel            *base_model,
+                                                 GtkTreePath             *base_path)
+{
+    GtkTreeRowReference *row_ref;
+    gpointer key;
+    gboolean ret = FALSE;
+
+    key = selection_map_key_for_path (priv, base_model, base_path);
+    if (key == NULL)
+        return FALSE;
+
+    row_ref = g_hash_table_lookup (priv->selection_map, key);
+    if (row_ref != NULL) {
+        if (priv->selection_key == SELECTION_KEY_ITER) {
+            /* Make sure that the iter was not reused for another row */
+            GtkTreePath *path = gtk_tree_row_reference_get_path (row_ref);
+
+            ret = (path != NULL && gtk_tree_path_compare (path, base_path) == 0);
+            gtk_tree_path_free (path);
+        } else {
+            ret = TRUE;
+        }
+    }
+
+    selection_map_key_free (priv, key);
+
+    return ret;
+}
+
 static GtkTreePath *
 convert_child_path_to_path (GtkTreeModel *model,
                             GtkTreeModel *base_model,
@@ -207,8 +463,8 @@ convert_path_to_child_path (GtkTreeModel *model,
 }
 
 static gboolean
-row_reference_is_not_selected (GtkTreeRowReference *row_ref,
-                               gpointer value,
+row_reference_is_not_selected (gpointer key,
+                               GtkTreeRowReference *row_ref,
                                HildonLiveSearchPrivate *priv)
 {
   GtkTreeSelection *selection = gtk_tree_view_get_selection (
@@ -235,174 +491,1403 @@ row_reference_is_not_selected (GtkTreeRowReference *row_ref,
       gtk_tree_view_get_model (GTK_TREE_VIEW (priv->kb_focus_widget)),
               GTK_TREE_MODEL (priv->filter), filter_path);
 
-  ret = ! gtk_tree_selection_path_is_selected (selection, view_path);
+  ret = ! gtk_tree_selection_path_is_selected (selection, view_path);
+
+  gtk_tree_path_free (base_path);
+  gtk_tree_path_free (filter_path);
+  gtk_tree_path_free (view_path);
+
+  return ret;
+}
+
+
+/**
+ * selection_map_update_map_from_selection:
+ * @priv: The private pimpl
+ *
+ * Find out which rows are visible in filter, and mark them as selected
+ * or unselected from treeview to selection map.
+ **/
+static void
+selection_map_update_map_from_selection         (HildonLiveSearchPrivate *priv)
+{
+    GtkTreeModel *base_model;
+    GtkTreeSelection *selection;
+    GList *selected_list, *l_iter;
+
+    if (!GTK_IS_TREE_VIEW (priv->kb_focus_widget))
+        return;
+
+    base_model = gtk_tree_model_filter_get_model (priv->filter);
+    selection = gtk_tree_view_get_selection (GTK_TREE_VIEW (priv->kb_focus_widget));
+
+    /* Paths may have changed since the map was filled */
+    if (priv->selection_key == SELECTION_KEY_PATH)
+        selection_map_rekey (priv);
+
+    /* Remove all items from priv->selection_map which are not selected */
+    g_hash_table_foreach_remove (priv->selection_map,
+                                 (GHRFunc) row_reference_is_not_selected, priv);
+
+    /* fill priv->selection_map from gtk_tree_selection_get_selected_rows()*/
+    selected_list = l_iter = gtk_tree_selection_get_selected_rows (selection,
+                                                                 NULL);
+    while (l_iter) {
+        GtkTreePath *view_path = l_iter->data;
+        GtkTreePath *base_path, *filter_path;
+
+        filter_path = convert_path_to_child_path (
+            gtk_tree_view_get_model (GTK_TREE_VIEW (priv->kb_focus_widget)),
+            GTK_TREE_MODEL (priv->filter), view_path);
+        base_path = gtk_tree_model_filter_convert_path_to_child_path
+          (priv->filter, filter_path);
+
+        selection_map_add (priv, base_model, base_path);
+
+        gtk_tree_path_free (view_path);
+        gtk_tree_path_free (filter_path);
+        gtk_tree_path_free (base_path);
+        l_iter->data = NULL;
+        l_iter = g_list_next (l_iter);
+    }
+    g_list_free (selected_list);
+}
+
+/**
+ * selection_map_update_selection_from_map:
+ * @priv: The private pimpl
+ *
+ * For currently visible rows in filter, set selection from selection
+ * map to treeview.
+ **/
+static void
+selection_map_update_selection_from_map         (HildonLiveSearchPrivate *priv)
+{
+    GtkTreeModel *base_model;
+    GtkTreeModel *view_model;
+    GtkTreeSelection *selection;
+    GList *selected_list, *l_iter;
+    GHashTableIter iter;
+    gpointer value;
+
+    if (!GTK_IS_TREE_VIEW (priv->kb_focus_widget))
+        return;
+
+    base_model = gtk_tree_model_filter_get_model (priv->filter);
+    view_model = gtk_tree_view_get_model (GTK_TREE_VIEW (priv->kb_focus_widget));
+    selection = gtk_tree_view_get_selection (GTK_TREE_VIEW (priv->kb_focus_widget));
+
+    /* unselect things which are not in priv->selection_map */
+    selected_list = l_iter = gtk_tree_selection_get_selected_rows (selection,
+                                                                 NULL);
+    while (l_iter) {
+        GtkTreePath *view_path = l_iter->data;
+        GtkTreePath *base_path, *filter_path;
+        filter_path = convert_path_to_child_path (
+            view_model, GTK_TREE_MODEL (priv->filter), view_path);
+        base_path = gtk_tree_model_filter_convert_path_to_child_path
+            (priv->filter, filter_path);
+
+        if (!selection_map_contains (priv, base_model, base_path))
+            gtk_tree_selection_unselect_path
+                (selection, view_path);
+
+        gtk_tree_path_free (view_path);
+        gtk_tree_path_free (filter_path);
+        gtk_tree_path_free (base_path);
+        l_iter->data = NULL;
+
+        l_iter = g_list_next (l_iter);
+    }
+    g_list_free (selected_list);
+
+    /* going though priv->selection_map to select items */
+    g_hash_table_iter_init (&iter, priv->selection_map);
+    while (g_hash_table_iter_next (&iter, NULL, &value)) {
+        GtkTreeRowReference *row_ref = value;
+        GtkTreePath *base_path = gtk_tree_row_reference_get_path (row_ref);
+        GtkTreePath *filter_path;
+        GtkTreePath *view_path;
+
+        if (base_path == NULL)
+            continue;
+
+        filter_path = gtk_tree_model_filter_convert_child_path_to_path
+          (priv->filter, base_path);
+        gtk_tree_path_free (base_path);
+
+        if (filter_path == NULL)
+            continue;
+
+        view_path = convert_child_path_to_path (
+            view_model, GTK_TREE_MODEL (priv->filter), filter_path);
+
+        gtk_tree_selection_select_path (selection, view_path);
+
+        gtk_tree_path_free (filter_path);
+        gtk_tree_path_free (view_path);
+    }
+}
+
+/*
+ * IMPLEMENTATION NOTES:
+ * Incremental filtering. While refiltering, the child rows found to be
+ * hidden are recorded in priv->hidden_rows, together with the text used
+ * (priv->hidden_prefix). If the next text starts with the recorded one,
+ * those rows can only stay hidden, so visible_func() rejects them
+ * without calling the real filtering function, and only the rows that
+ * were visible are tested again.
+ *
+ * Rows are identified by their iter, so this requires a flat child
+ * model whose iters persist. Inserted or changed rows are dropped from
+ * the table, as their contents may not match the recorded result
+ * anymore (this also takes care of iters reused for new rows).
+ */
+static gboolean
+hidden_rows_supported                           (HildonLiveSearchPrivate *priv)
+{
+    GtkTreeModelFlags flags;
+
+    if (priv->base_model == NULL)
+        return FALSE;
+
+    /* Only the default filtering function is known to narrow. Typos
+       are only allowed in long enough words, so ranked matching
+       doesn't. */
+    if (priv->visible_func != NULL && !priv->incremental)
+        return FALSE;
+
+    if (priv->ranked)
+        return FALSE;
+
+    flags = gtk_tree_model_get_flags (priv->base_model);
+
+    return (flags & GTK_TREE_MODEL_LIST_ONLY) &&
+        (flags & GTK_TREE_MODEL_ITERS_PERSIST);
+}
+
+static void
+hidden_rows_invalidate                          (HildonLiveSearchPrivate *priv)
+{
+    if (priv->hidden_rows != NULL)
+        g_hash_table_remove_all (priv->hidden_rows);
+
+    g_free (priv->hidden_prefix);
+    priv->hidden_prefix = NULL;
+    priv->hidden_rows_valid = FALSE;
+}
+
+static void
+hidden_rows_begin_pass                          (HildonLiveSearchPrivate *priv)
+{
+    priv->narrowing = FALSE;
+
+    if (!hidden_rows_supported (priv)) {
+        hidden_rows_invalidate (priv);
+        return;
+    }
+
+    if (priv->hidden_rows == NULL)
+        priv->hidden_rows = g_hash_table_new (g_direct_hash, g_direct_equal);
+
+    if (priv->hidden_rows_valid &&
+        (priv->hidden_prefix == NULL ||
+         (priv->prefix != NULL &&
+          g_str_has_prefix (priv->prefix, priv->hidden_prefix)))) {
+        priv->narrowing = TRUE;
+    } else {
+        g_hash_table_remove_all (priv->hidden_rows);
+    }
+}
+
+static void
+hidden_rows_end_pass                            (HildonLiveSearchPrivate *priv,
+                                                 gboolean                 completed)
+{
+    priv->narrowing = FALSE;
+
+    if (completed && hidden_rows_supported (priv)) {
+        g_free (priv->hidden_prefix);
+        priv->hidden_prefix = g_strdup (priv->prefix);
+        priv->hidden_rows_valid = TRUE;
+    } else {
+        hidden_rows_invalidate (priv);
+    }
+}
+
+static void
+on_base_model_row_updated                       (GtkTreeModel *model,
+                                                 GtkTreePath  *path,
+                                                 GtkTreeIter  *iter,
+                                                 gpointer      user_data)
+{
+    HildonLiveSearchPrivate *priv = user_data;
+
+    if (priv->hidden_rows != NULL)
+        g_hash_table_remove (priv->hidden_rows, iter->user_data);
+
+    if (priv->chunk_results != NULL)
+        g_hash_table_remove (priv->chunk_results, iter->user_data);
+
+    match_snapshot_row_changed (priv, iter);
+
+    if (priv->rank_scores != NULL)
+        g_hash_table_remove (priv->rank_scores, iter->user_data);
+}
+
+static void
+on_base_model_row_deleted                       (GtkTreeModel *model,
+                                                 GtkTreePath  *path,
+                                                 gpointer      user_data)
+{
+    HildonLiveSearchPrivate *priv = user_data;
+
+    /* The iter of a chunked refilter may point to the deleted row */
+    priv->chunk_iter_valid = FALSE;
+}
+
+static void
+on_base_model_rows_reordered                    (GtkTreeModel *model,
+                                                 GtkTreePath  *path,
+                                                 GtkTreeIter  *iter,
+                                                 gint         *new_order,
+                                                 gpointer      user_data)
+{
+    HildonLiveSearchPrivate *priv = user_data;
+
+    priv->chunk_iter_valid = FALSE;
+
+    /* Ranked rows can't be ordered by their index in the snapshot */
+    priv->match_order_valid = FALSE;
+}
+
+static void
+base_model_disconnect                           (HildonLiveSearchPrivate *priv)
+{
+    if (priv->base_model == NULL)
+        return;
+
+    g_signal_handler_disconnect (priv->base_model, priv->row_inserted_id);
+    g_signal_handler_disconnect (priv->base_model, priv->row_changed_id);
+    g_signal_handler_disconnect (priv->base_model, priv->row_deleted_id);
+    g_signal_handler_disconnect (priv->base_model, priv->rows_reordered_id);
+    priv->row_inserted_id = 0;
+    priv->row_changed_id = 0;
+    priv->row_deleted_id = 0;
+    priv->rows_reordered_id = 0;
+    priv->base_model = NULL;
+
+    hidden_rows_invalidate (priv);
+    match_snapshot_invalidate (priv);
+}
+
+static void
+base_model_connect                              (HildonLiveSearchPrivate *priv)
+{
+    g_assert (priv->base_model == NULL);
+
+    if (priv->filter == NULL)
+        return;
+
+    /* The filter keeps a reference on its child model, and we keep
+       one on the filter */
+    priv->base_model = gtk_tree_model_filter_get_model (priv->filter);
+    priv->row_inserted_id =
+        g_signal_connect (priv->base_model, "row-inserted",
+                          G_CALLBACK (on_base_model_row_updated), priv);
+    priv->row_changed_id =
+        g_signal_connect (priv->base_model, "row-changed",
+                          G_CALLBACK (on_base_model_row_updated), priv);
+    priv->row_deleted_id =
+        g_signal_connect (priv->base_model, "row-deleted",
+                          G_CALLBACK (on_base_model_row_deleted), priv);
+    priv->rows_reordered_id =
+        g_signal_connect (priv->base_model, "rows-reordered",
+                          G_CALLBACK (on_base_model_rows_reordered), priv);
+}
+
+static gboolean
+selection_needs_mapping                         (HildonLiveSearchPrivate *priv)
+{
+    return GTK_IS_TREE_VIEW (priv->kb_focus_widget) &&
+        gtk_tree_selection_get_mode (gtk_tree_view_get_selection (
+                                         GTK_TREE_VIEW (priv->kb_focus_widget))) != GTK_SELECTION_NONE;
+}
+
+/*
+ * Create/update selection map from current selection. Returns FALSE if
+ * filtering should not happen.
+ */
+static gboolean
+selection_map_save                              (HildonLiveSearchPrivate *priv)
+{
+    if (!selection_needs_mapping (priv))
+        return TRUE;
+
+    /* This is not pretty code, but it should fix some warnings in the case we
+       attempt to refilter before the treeview actually has a model. */
+    if (!gtk_tree_view_get_model (GTK_TREE_VIEW (priv->kb_focus_widget)))
+        return FALSE;
+
+    if (priv->selection_map == NULL)
+        selection_map_create (priv);
+    selection_map_update_map_from_selection (priv);
+
+    return TRUE;
+}
+
+/* Restore selection from mapping */
+static void
+selection_map_restore                           (HildonLiveSearchPrivate *priv)
+{
+    if (selection_needs_mapping (priv))
+        selection_map_update_selection_from_map (priv);
+}
+
+static void
+chunked_refilter_cancel                         (HildonLiveSearchPrivate *priv)
+{
+    if (priv->chunk_source_id != 0) {
+        g_source_remove (priv->chunk_source_id);
+        priv->chunk_source_id = 0;
+    }
+
+    if (priv->chunk_results != NULL) {
+        g_hash_table_destroy (priv->chunk_results);
+        priv->chunk_results = NULL;
+    }
+
+    if (priv->chunk_changed != NULL) {
+        g_array_free (priv->chunk_changed, TRUE);
+        priv->chunk_changed = NULL;
+    }
+
+    priv->chunk_iter_valid = FALSE;
+}
+
+static void
+refilter (HildonLiveSearch *livesearch)
+{
+    HildonLiveSearchPrivate *priv = livesearch->priv;
+    gboolean handled = FALSE;
+
+    /* A pending chunked or threaded refilter would be out of date */
+    chunked_refilter_cancel (priv);
+    match_job_cancel (priv);
+
+    if (!selection_map_save (priv))
+        return;
+
+    /* Filter the model */
+    hidden_rows_begin_pass (priv);
+    priv->refiltering = TRUE;
+
+    g_signal_emit (livesearch, signals[REFILTER], 0, &handled);
+    if (!handled && priv->filter)
+        gtk_tree_model_filter_refilter (priv->filter);
+
+    /* If a handler took over, we can't know whether all rows were
+       tested */
+    priv->refiltering = FALSE;
+    hidden_rows_end_pass (priv, !handled && priv->filter != NULL);
+
+    ranked_model_resort (priv);
+    selection_map_restore (priv);
+}
+
+/*
+ * IMPLEMENTATION NOTES:
+ * Chunked filtering. gtk_tree_model_filter_refilter() tests every row
+ * of the child model at once, blocking the main loop for as long as it
+ * takes. When #HildonLiveSearch:chunked is set, the rows are instead
+ * tested from an idle source, in slices of at most CHUNK_TIME_BUDGET,
+ * and the results are kept in priv->chunk_results. Any new text cancels
+ * the pass in progress.
+ *
+ * The rows of each slice whose visibility changed are published as
+ * soon as the slice is done, so the filter shows the rows tested so far
+ * for the new text and the previous results for the others. This is
+ * what gtk_tree_model_filter_refilter() does for every row: it calls
+ * the filter's row-changed handler on the child model, which tests the
+ * row again (here a table lookup) and emits row-inserted or row-deleted
+ * on the filter. Since every other user of the child model would see
+ * that row-changed too (the touch selector would report its selected
+ * rows as changed, and normalize them again), it is only emitted to the
+ * handler of the filter, the others being blocked meanwhile. If that
+ * handler can't be found, the results are applied at the end of the
+ * pass with a single refilter instead.
+ *
+ * Walking the child model across slices requires a flat model with
+ * persistent iters, the same as incremental filtering.
+ */
+static gboolean
+chunked_refilter_supported                      (HildonLiveSearchPrivate *priv)
+{
+    GtkTreeModelFlags flags;
+
+    if (!priv->chunked || priv->filter == NULL || priv->base_model == NULL)
+        return FALSE;
+
+    flags = gtk_tree_model_get_flags (priv->base_model);
+
+    return (flags & GTK_TREE_MODEL_LIST_ONLY) &&
+        (flags & GTK_TREE_MODEL_ITERS_PERSIST);
+}
+
+static gulong
+chunked_refilter_filter_handler                 (HildonLiveSearchPrivate *priv)
+{
+    return g_signal_handler_find (priv->base_model,
+                                  G_SIGNAL_MATCH_ID | G_SIGNAL_MATCH_DATA,
+                                  g_signal_lookup ("row-changed",
+                                                   GTK_TYPE_TREE_MODEL),
+                                  0, NULL, NULL, priv->filter);
+}
+
+/* Tells the filter about the rows in priv->chunk_changed */
+static void
+chunked_refilter_publish                        (HildonLiveSearchPrivate *priv,
+                                                 gulong                   handler_id)
+{
+    GtkTreeModel *model = priv->base_model;
+    gboolean saved;
+    guint signal_id;
+    guint i;
+
+    if (priv->chunk_changed->len == 0)
+        return;
+
+    /* The selected rows about to be hidden must be remembered */
+    saved = selection_map_save (priv);
+
+    signal_id = g_signal_lookup ("row-changed", GTK_TYPE_TREE_MODEL);
+    g_signal_handlers_block_matched (model, G_SIGNAL_MATCH_ID, signal_id,
+                                     0, NULL, NULL, NULL);
+    g_signal_handler_unblock (model, handler_id);
+
+    priv->chunk_publishing = TRUE;
+
+    for (i = 0; i < priv->chunk_changed->len; i++) {
+        GtkTreeIter *iter = &g_array_index (priv->chunk_changed, GtkTreeIter, i);
+        GtkTreePath *path = gtk_tree_model_get_path (model, iter);
+
+        gtk_tree_model_row_changed (model, path, iter);
+        gtk_tree_path_free (path);
+    }
+
+    priv->chunk_publishing = FALSE;
+
+    g_signal_handler_block (model, handler_id);
+    g_signal_handlers_unblock_matched (model, G_SIGNAL_MATCH_ID, signal_id,
+                                       0, NULL, NULL, NULL);
+
+    g_array_set_size (priv->chunk_changed, 0);
+
+    if (saved)
+        selection_map_restore (priv);
+}
+
+static void
+chunked_refilter_apply                          (HildonLiveSearch *livesearch,
+                                                 gboolean          published)
+{
+    HildonLiveSearchPrivate *priv = livesearch->priv;
+
+    if (!published) {
+        /* The selection may have changed while filtering */
+        if (selection_map_save (priv)) {
+            hidden_rows_begin_pass (priv);
+            priv->refiltering = TRUE;
+            priv->chunk_publishing = TRUE;
+
+            gtk_tree_model_filter_refilter (priv->filter);
+
+            priv->chunk_publishing = FALSE;
+            priv->refiltering = FALSE;
+            hidden_rows_end_pass (priv, TRUE);
+
+            ranked_model_resort (priv);
+            selection_map_restore (priv);
+        }
+    } else {
+        /* Rows hidden for this text can be skipped when it grows */
+        if (hidden_rows_supported (priv) && priv->hidden_rows != NULL) {
+            GHashTableIter iter;
+            gpointer row, visible;
+
+            g_hash_table_iter_init (&iter, priv->chunk_results);
+            while (g_hash_table_iter_next (&iter, &row, &visible)) {
+                if (!GPOINTER_TO_INT (visible))
+                    g_hash_table_add (priv->hidden_rows, row);
+            }
+        }
+        hidden_rows_end_pass (priv, TRUE);
+
+        ranked_model_resort (priv);
+    }
+
+    g_hash_table_destroy (priv->chunk_results);
+    priv->chunk_results = NULL;
+    g_array_free (priv->chunk_changed, TRUE);
+    priv->chunk_changed = NULL;
+
+    if (priv->prefix == NULL)
+        selection_map_destroy (priv);
+}
+
+static gboolean
+on_chunked_refilter_step                        (HildonLiveSearch *livesearch)
+{
+    HildonLiveSearchPrivate *priv = livesearch->priv;
+    GtkTreeModel *model = priv->base_model;
+    gulong handler_id;
+    gint64 deadline;
+    gboolean valid;
+    guint n_rows = 0;
+
+    deadline = g_get_monotonic_time () + CHUNK_TIME_BUDGET;
+    handler_id = chunked_refilter_filter_handler (priv);
+
+    /* If the model changed under us, start again from the first row.
+       The rows already tested are skipped. */
+    if (priv->chunk_iter_valid)
+        valid = TRUE;
+    else
+        valid = gtk_tree_model_get_iter_first (model, &priv->chunk_iter);
+
+    priv->narrowing = priv->chunk_narrowing;
+
+    while (valid) {
+        gpointer row = priv->chunk_iter.user_data;
+
+        if (!g_hash_table_contains (priv->chunk_results, row)) {
+            gboolean visible = visible_func (model, &priv->chunk_iter, priv) != FALSE;
+            GtkTreeIter filter_iter;
+
+            g_hash_table_insert (priv->chunk_results, row,
+                                 GINT_TO_POINTER (visible));
+
+            /* Only rows shown or hidden by the new text are published */
+            if (handler_id != 0 &&
+                visible != gtk_tree_model_filter_convert_child_iter_to_iter (
+                    priv->filter, &filter_iter, &priv->chunk_iter))
+                g_array_append_val (priv->chunk_changed, priv->chunk_iter);
+        }
+
+        valid = gtk_tree_model_iter_next (model, &priv->chunk_iter);
+
+        if (valid &&
+            ++n_rows % CHUNK_CHECK_INTERVAL == 0 &&
+            g_get_monotonic_time () >= deadline)
+            break;
+    }
+
+    priv->narrowing = FALSE;
+
+    if (handler_id != 0)
+        chunked_refilter_publish (priv, handler_id);
+
+    if (valid) {
+        priv->chunk_iter_valid = TRUE;
+        return TRUE;
+    }
+
+    priv->chunk_iter_valid = FALSE;
+    priv->chunk_source_id = 0;
+    chunked_refilter_apply (livesearch, handler_id != 0);
+
+    return FALSE;
+}
+
+static void
+chunked_refilter_start                          (HildonLiveSearch *livesearch)
+{
+    HildonLiveSearchPrivate *priv = livesearch->priv;
+    gboolean handled = FALSE;
+
+    chunked_refilter_cancel (priv);
+
+    if (!selection_map_save (priv))
+        return;
+
+    /* Let handlers prepare for the new text, or take over */
+    g_signal_emit (livesearch, signals[REFILTER], 0, &handled);
+    if (handled) {
+        hidden_rows_invalidate (priv);
+        selection_map_restore (priv);
+        if (priv->prefix == NULL)
+            selection_map_destroy (priv);
+        return;
+    }
+
+    hidden_rows_begin_pass (priv);
+    priv->chunk_narrowing = priv->narrowing;
+    priv->narrowing = FALSE;
+
+    priv->chunk_results = g_hash_table_new (g_direct_hash, g_direct_equal);
+    priv->chunk_changed = g_array_new (FALSE, FALSE, sizeof (GtkTreeIter));
+    priv->chunk_iter_valid = FALSE;
+    priv->chunk_source_id =
+        gdk_threads_add_idle_full (G_PRIORITY_DEFAULT_IDLE,
+                                   (GSourceFunc) on_chunked_refilter_step,
+                                   livesearch, NULL);
+}
+
+/*
+ * IMPLEMENTATION NOTES:
+ * Threaded matching. With #HildonLiveSearch:match-column set, rows are
+ * visible when each word of the text matches the beginning of a word
+ * in the column, as told by hildon_helper_smart_match() on normalized
+ * strings. Tree models can only be used from the main thread, so the
+ * column is copied once into a MatchSnapshot, along with a table from
+ * the iter of each row to its index. The snapshot is never modified
+ * afterwards, except for each range of MATCH_RANGE_SIZE rows being
+ * normalized in place, under the lock of the range, by the first task
+ * that needs it.
+ *
+ * Each new text creates a MatchJob: one task per range is pushed to a
+ * GThreadPool, each writing the result of its rows to job->visible.
+ * The last task to finish hands the job back to the main loop, where
+ * a single gtk_tree_model_filter_refilter() reads the results. When
+ * the text grows, only the rows visible for the previous job are
+ * matched again. New text cancels the job in progress; its tasks then
+ * return without matching anything.
+ *
+ * Rows inserted or changed after the snapshot was taken are recorded
+ * in priv->match_changed_rows and matched on the main thread. This
+ * also covers iters reused for new rows. The snapshot is only taken
+ * again when too many rows changed.
+ *
+ * Each row gets a score rather than a visibility, 0 meaning hidden.
+ * Without #HildonLiveSearch:ranked, it is 1 when every word matches.
+ */
+struct _MatchSnapshot
+{
+    volatile gint ref_count;
+    guint n_rows;
+    gchar **text;
+    guint n_ranges;
+    GMutex *range_locks;
+    gboolean *range_done;
+    GHashTable *index;
+};
+
+struct _MatchJob
+{
+    volatile gint ref_count;
+    volatile gint cancelled;
+    volatile gint pending;
+    HildonLiveSearch *livesearch;
+    MatchSnapshot *snapshot;
+    gchar **tokens;
+    gchar *text;
+    gboolean ranked;
+    guint16 *scores;
+    MatchJob *previous;
+};
+
+typedef struct
+{
+    MatchJob *job;
+    guint range;
+} MatchTask;
+
+static gchar **
+match_tokens_new                                (const gchar *text)
+{
+    gchar **words;
+    GPtrArray *tokens;
+    gint i;
+
+    words = g_strsplit (text, " ", -1);
+    tokens = g_ptr_array_new ();
+
+    for (i = 0; words[i] != NULL; i++) {
+        gchar *token;
+
+        if (words[i][0] == '\0')
+            continue;
+
+        token = hildon_helper_normalize_string (words[i]);
+        if (token != NULL)
+            g_ptr_array_add (tokens, token);
+    }
+
+    g_ptr_array_add (tokens, NULL);
+    g_strfreev (words);
+
+    return (gchar **) g_ptr_array_free (tokens, FALSE);
+}
+
+static gboolean
+match_tokens                                    (const gchar *string,
+                                                 gchar      **tokens)
+{
+    if (string == NULL)
+        return FALSE;
+
+    for (; *tokens != NULL; tokens++) {
+        if (hildon_helper_smart_match (string, *tokens) == NULL)
+            return FALSE;
+    }
+
+    return TRUE;
+}
+
+/* Compares @n characters of @a and @b, which may be shorter */
+static inline gboolean
+match_equal                                     (const gchar *a,
+                                                 const gchar *b,
+                                                 gsize        n)
+{
+    return g_ascii_strncasecmp (a, b, n) == 0;
+}
+
+/*
+ * Whether @token matches the start of @word with at most one typo: a
+ * wrong, missing, extra or swapped character.
+ */
+static gboolean
+match_with_typo                                 (const gchar *word,
+                                                 const gchar *token,
+                                                 gsize        len)
+{
+    gsize i = 0;
+
+    while (i < len && word[i] != '\0' &&
+           g_ascii_tolower (word[i]) == g_ascii_tolower (token[i]))
+        i++;
+
+    if (i == len)
+        return TRUE;
+
+    /* Extra character in the token */
+    if (match_equal (token + i + 1, word + i, len - i - 1))
+        return TRUE;
+
+    if (word[i] == '\0')
+        return FALSE;
+
+    /* Wrong character, missing character, swapped characters */
+    return match_equal (token + i + 1, word + i + 1, len - i - 1) ||
+        match_equal (token + i, word + i + 1, len - i) ||
+        (i + 1 < len &&
+         g_ascii_tolower (token[i]) == g_ascii_tolower (word[i + 1]) &&
+         g_ascii_tolower (token[i + 1]) == g_ascii_tolower (word[i]) &&
+         match_equal (token + i + 2, word + i + 2, len - i - 2));
+}
+
+/*
+ * match_token_score:
+ *
+ * Scores how well @token matches @string, from the best to the worst:
+ * at the start of @string, at the start of a word, in the middle of a
+ * word, with characters in between, or with a typo at the start of a
+ * word (for tokens of at least 4 characters). Matches further into
+ * @string, or more spread out, lose up to SCORE_PENALTY_MAX.
+ *
+ * Returns: the score, or 0 if @token doesn't match.
+ */
+static guint
+match_token_score                               (const gchar *string,
+                                                 const gchar *token)
+{
+    const gchar *match, *s, *t, *first;
+    gsize len = strlen (token);
+
+    if (match_equal (string, token, len))
+        return SCORE_PREFIX;
+
+    match = hildon_helper_smart_match (string, token);
+    if (match != NULL)
+        return SCORE_WORD_START - MIN (match - string, SCORE_PENALTY_MAX);
+
+    match = strcasestr (string, token);
+    if (match != NULL)
+        return SCORE_SUBSTRING - MIN (match - string, SCORE_PENALTY_MAX);
+
+    /* Subsequence, losing points for each character in between */
+    first = NULL;
+    for (s = string, t = token; *s != '\0' && *t != '\0'; s++) {
+        if (g_ascii_tolower (*s) == g_ascii_tolower (*t)) {
+            if (first == NULL)
+                first = s;
+            t++;
+        }
+    }
+    if (*t == '\0' && first != NULL)
+        return SCORE_SUBSEQUENCE - MIN ((gsize) (s - first) - len, SCORE_PENALTY_MAX);
+
+    if (len < 4)
+        return 0;
+
+    for (s = string; *s != '\0'; s++) {
+        if (g_ascii_isalnum (*s) && (s == string || !g_ascii_isalnum (s[-1])) &&
+            match_with_typo (s, token, len))
+            return SCORE_TYPO;
+    }
+
+    return 0;
+}
+
+/*
+ * Scores @string against all the @tokens. Unranked, the score is 1
+ * if they all match the start of a word.
+ */
+static guint
+match_score                                     (const gchar *string,
+                                                 gchar      **tokens,
+                                                 gboolean     ranked)
+{
+    guint score = 1;
+
+    if (!ranked)
+        return match_tokens (string, tokens) ? 1 : 0;
+
+    if (string == NULL)
+        return 0;
+
+    for (; *tokens != NULL; tokens++) {
+        guint token_score = match_token_score (string, *tokens);
+
+        if (token_score == 0)
+            return 0;
+        score += token_score;
+    }
+
+    return MIN (score, G_MAXUINT16);
+}
+
+/* Tokens of the current text, for the rows matched on the main thread */
+static gchar **
+match_tokens_for_prefix                         (HildonLiveSearchPrivate *priv)
+{
+    if (priv->match_tokens == NULL ||
+        g_strcmp0 (priv->match_tokens_text, priv->prefix) != 0) {
+        g_strfreev (priv->match_tokens);
+        g_free (priv->match_tokens_text);
+        priv->match_tokens = match_tokens_new (priv->prefix);
+        priv->match_tokens_text = g_strdup (priv->prefix);
+    }
+
+    return priv->match_tokens;
+}
+
+static guint
+match_row                                       (HildonLiveSearchPrivate *priv,
+                                                 GtkTreeModel            *model,
+                                                 GtkTreeIter             *iter)
+{
+    gchar *string;
+    gchar *normalized = NULL;
+    guint score;
+
+    gtk_tree_model_get (model, iter, priv->match_column, &string, -1);
+    if (string != NULL) {
+        normalized = hildon_helper_normalize_string (string);
+        g_free (string);
+    }
+
+    score = match_score (normalized, match_tokens_for_prefix (priv),
+                         priv->ranked);
+    g_free (normalized);
+
+    return score;
+}
+
+static MatchSnapshot *
+match_snapshot_new                              (GtkTreeModel *model,
+                                                 gint          column)
+{
+    MatchSnapshot *snapshot;
+    GtkTreeIter iter;
+    gboolean valid;
+    guint i;
+
+    snapshot = g_slice_new0 (MatchSnapshot);
+    snapshot->ref_count = 1;
+    snapshot->n_rows = gtk_tree_model_iter_n_children (model, NULL);
+    snapshot->text = g_new0 (gchar *, snapshot->n_rows);
+    snapshot->index = g_hash_table_new (g_direct_hash, g_direct_equal);
+
+    valid = gtk_tree_model_get_iter_first (model, &iter);
+    for (i = 0; valid && i < snapshot->n_rows; i++) {
+        gtk_tree_model_get (model, &iter, column, &snapshot->text[i], -1);
+        g_hash_table_insert (snapshot->index, iter.user_data,
+                             GUINT_TO_POINTER (i + 1));
+        valid = gtk_tree_model_iter_next (model, &iter);
+    }
+
+    snapshot->n_ranges = (snapshot->n_rows + MATCH_RANGE_SIZE - 1) / MATCH_RANGE_SIZE;
+    snapshot->range_locks = g_new (GMutex, snapshot->n_ranges);
+    snapshot->range_done = g_new0 (gboolean, snapshot->n_ranges);
+    for (i = 0; i < snapshot->n_ranges; i++)
+        g_mutex_init (&snapshot->range_locks[i]);
+
+    return snapshot;
+}
+
+static MatchSnapshot *
+match_snapshot_ref                              (MatchSnapshot *snapshot)
+{
+    g_atomic_int_inc (&snapshot->ref_count);
+
+    return snapshot;
+}
+
+static void
+match_snapshot_unref                            (MatchSnapshot *snapshot)
+{
+    guint i;
+
+    if (!g_atomic_int_dec_and_test (&snapshot->ref_count))
+        return;
+
+    for (i = 0; i < snapshot->n_rows; i++)
+        g_free (snapshot->text[i]);
+    for (i = 0; i < snapshot->n_ranges; i++)
+        g_mutex_clear (&snapshot->range_locks[i]);
+
+    g_free (snapshot->text);
+    g_free (snapshot->range_locks);
+    g_free (snapshot->range_done);
+    g_hash_table_destroy (snapshot->index);
+    g_slice_free (MatchSnapshot, snapshot);
+}
+
+/* Called from the worker threads */
+static void
+match_snapshot_normalize_range                  (MatchSnapshot *snapshot,
+                                                 guint          range)
+{
+    guint i, end;
+
+    g_mutex_lock (&snapshot->range_locks[range]);
+
+    if (!snapshot->range_done[range]) {
+        end = MIN ((range + 1) * MATCH_RANGE_SIZE, snapshot->n_rows);
+
+        for (i = range * MATCH_RANGE_SIZE; i < end; i++) {
+            gchar *string = snapshot->text[i];
+
+            if (string != NULL) {
+                snapshot->text[i] = hildon_helper_normalize_string (string);
+                g_free (string);
+            }
+        }
+
+        snapshot->range_done[range] = TRUE;
+    }
+
+    g_mutex_unlock (&snapshot->range_locks[range]);
+}
+
+static void
+match_snapshot_invalidate                       (HildonLiveSearchPrivate *priv)
+{
+    if (priv->match_snapshot != NULL) {
+        match_snapshot_unref (priv->match_snapshot);
+        priv->match_snapshot = NULL;
+    }
+
+    if (priv->match_changed_rows != NULL)
+        g_hash_table_remove_all (priv->match_changed_rows);
+}
+
+static void
+match_snapshot_row_changed                      (HildonLiveSearchPrivate *priv,
+                                                 GtkTreeIter             *iter)
+{
+    if (priv->match_snapshot == NULL)
+        return;
+
+    if (priv->match_changed_rows == NULL)
+        priv->match_changed_rows = g_hash_table_new (g_direct_hash, g_direct_equal);
+
+    g_hash_table_add (priv->match_changed_rows, iter->user_data);
+}
+
+static MatchSnapshot *
+match_snapshot_get                              (HildonLiveSearchPrivate *priv)
+{
+    /* Rows changed since the snapshot are matched on the main thread,
+       take a new one before that gets too slow */
+    if (priv->match_snapshot != NULL && priv->match_changed_rows != NULL &&
+        g_hash_table_size (priv->match_changed_rows) >
+        priv->match_snapshot->n_rows / 16 + CHUNK_CHECK_INTERVAL)
+        match_snapshot_invalidate (priv);
+
+    if (priv->match_snapshot == NULL) {
+        priv->match_snapshot = match_snapshot_new (priv->base_model,
+                                                   priv->match_column);
+        priv->match_order_valid = TRUE;
+    }
+
+    return priv->match_snapshot;
+}
+
+static MatchJob *
+match_job_ref                                   (MatchJob *job)
+{
+    g_atomic_int_inc (&job->ref_count);
+
+    return job;
+}
+
+static void
+match_job_unref                                 (MatchJob *job)
+{
+    if (!g_atomic_int_dec_and_test (&job->ref_count))
+        return;
+
+    if (job->previous != NULL)
+        match_job_unref (job->previous);
+
+    match_snapshot_unref (job->snapshot);
+    g_strfreev (job->tokens);
+    g_free (job->text);
+    g_free (job->scores);
+    g_slice_free (MatchJob, job);
+}
+
+static void
+match_job_cancel                                (HildonLiveSearchPrivate *priv)
+{
+    if (priv->match_job != NULL) {
+        g_atomic_int_set (&priv->match_job->cancelled, TRUE);
+        match_job_unref (priv->match_job);
+        priv->match_job = NULL;
+    }
+}
+
+/*
+ * Looks up the score given by @job to the row at @iter, and its index
+ * in the snapshot. Returns FALSE if the row has to be matched on the
+ * main thread.
+ */
+static gboolean
+match_job_lookup                                (HildonLiveSearchPrivate *priv,
+                                                 MatchJob                *job,
+                                                 GtkTreeIter             *iter,
+                                                 guint                   *score,
+                                                 guint                   *order)
+{
+    guint index;
+
+    if (priv->match_changed_rows != NULL &&
+        g_hash_table_contains (priv->match_changed_rows, iter->user_data))
+        return FALSE;
+
+    index = GPOINTER_TO_UINT (g_hash_table_lookup (job->snapshot->index,
+                                                   iter->user_data));
+    if (index == 0)
+        return FALSE;
+
+    *score = job->scores[index - 1];
+    if (order != NULL)
+        *order = index - 1;
+
+    return TRUE;
+}
+
+static void
+threaded_refilter_apply                         (HildonLiveSearch *livesearch,
+                                                 MatchJob         *job)
+{
+    HildonLiveSearchPrivate *priv = livesearch->priv;
+
+    /* All the tasks are done, the previous results can go */
+    if (job->previous != NULL) {
+        match_job_unref (job->previous);
+        job->previous = NULL;
+    }
+
+    /* Keep the results to narrow the next job */
+    if (priv->match_done != NULL)
+        match_job_unref (priv->match_done);
+    priv->match_done = priv->match_job;
+    priv->match_job = NULL;
 
-  gtk_tree_path_free (base_path);
-  gtk_tree_path_free (filter_path);
-  gtk_tree_path_free (view_path);
+    /* The selection may have changed while matching */
+    if (selection_map_save (priv)) {
+        hidden_rows_begin_pass (priv);
+        priv->refiltering = TRUE;
+        priv->match_applying = TRUE;
 
-  return ret;
-}
+        gtk_tree_model_filter_refilter (priv->filter);
 
+        priv->match_applying = FALSE;
+        priv->refiltering = FALSE;
+        hidden_rows_end_pass (priv, TRUE);
 
-/**
- * selection_map_update_map_from_selection:
- * @priv: The private pimpl
- *
- * Find out which rows are visible in filter, and mark them as selected
- * or unselected from treeview to selection map.
- **/
-static void
-selection_map_update_map_from_selection         (HildonLiveSearchPrivate *priv)
+        ranked_model_resort (priv);
+        selection_map_restore (priv);
+    }
+}
+
+static gboolean
+on_match_job_done                               (MatchJob *job)
 {
-    GtkTreeModel *base_model;
-    GtkTreeSelection *selection;
-    GList *selected_list, *l_iter;
+    /* Jobs are cancelled when replaced, and when the live search is
+       disposed */
+    if (!g_atomic_int_get (&job->cancelled))
+        threaded_refilter_apply (job->livesearch, job);
 
-    if (!GTK_IS_TREE_VIEW (priv->kb_focus_widget))
-        return;
+    match_job_unref (job);
 
-    base_model = gtk_tree_model_filter_get_model (priv->filter);
-    selection = gtk_tree_view_get_selection (GTK_TREE_VIEW (priv->kb_focus_widget));
+    return FALSE;
+}
 
-    /* Remove all items from priv->selection_map which are not selected */
-    g_hash_table_foreach_remove (priv->selection_map,
-                                 (GHRFunc) row_reference_is_not_selected, priv);
+static void
+match_task_run                                  (MatchTask *task,
+                                                 gpointer   user_data)
+{
+    MatchJob *job = task->job;
+    MatchSnapshot *snapshot = job->snapshot;
+    guint i, end;
+
+    if (!g_atomic_int_get (&job->cancelled)) {
+        match_snapshot_normalize_range (snapshot, task->range);
+
+        end = MIN ((task->range + 1) * MATCH_RANGE_SIZE, snapshot->n_rows);
+        for (i = task->range * MATCH_RANGE_SIZE; i < end; i++) {
+            if (job->previous != NULL && job->previous->scores[i] == 0)
+                job->scores[i] = 0;
+            else
+                job->scores[i] = match_score (snapshot->text[i], job->tokens,
+                                              job->ranked);
+        }
+    }
 
-    /* fill priv->selection_map from gtk_tree_selection_get_selected_rows()*/
-    selected_list = l_iter = gtk_tree_selection_get_selected_rows (selection,
-                                                                 NULL);
-    while (l_iter) {
-        GtkTreePath *view_path = l_iter->data;
-        GtkTreePath *base_path, *filter_path;
-        GtkTreeRowReference *row_ref;
+    /* The last task hands its reference over to the main loop */
+    if (g_atomic_int_dec_and_test (&job->pending))
+        gdk_threads_add_idle_full (G_PRIORITY_DEFAULT_IDLE,
+                                   (GSourceFunc) on_match_job_done,
+                                   job, NULL);
+    else
+        match_job_unref (job);
 
-        filter_path = convert_path_to_child_path (
-            gtk_tree_view_get_model (GTK_TREE_VIEW (priv->kb_focus_widget)),
-            GTK_TREE_MODEL (priv->filter), view_path);
-        base_path = gtk_tree_model_filter_convert_path_to_child_path
-          (priv->filter, filter_path);
+    g_slice_free (MatchTask, task);
+}
 
-        row_ref = gtk_tree_row_reference_new (base_model, base_path);
-        g_hash_table_replace (priv->selection_map,
-                              row_ref, NULL);
-        gtk_tree_path_free (view_path);
-        gtk_tree_path_free (filter_path);
-        gtk_tree_path_free (base_path);
-        selected_list->data = NULL;
-        l_iter = g_list_next (l_iter);
-    }
-    g_list_free (selected_list);
+static guint
+match_pool_size                                 (HildonLiveSearchPrivate *priv)
+{
+    return priv->match_threads > 0 ? priv->match_threads : g_get_num_processors ();
 }
 
 static gboolean
-reference_row_has_path (GtkTreeRowReference *row_ref, gpointer value, GtkTreePath *path)
+threaded_refilter_supported                     (HildonLiveSearchPrivate *priv)
 {
-    gboolean ret;
-    GtkTreePath *path2 = gtk_tree_row_reference_get_path (row_ref);
-    ret = gtk_tree_path_compare (path, path2) == 0;
-    gtk_tree_path_free (path2);
-    return ret;
+    GtkTreeModelFlags flags;
+
+    if (priv->match_column == -1 || priv->filter == NULL || priv->base_model == NULL)
+        return FALSE;
+
+    flags = gtk_tree_model_get_flags (priv->base_model);
+
+    return (flags & GTK_TREE_MODEL_LIST_ONLY) &&
+        (flags & GTK_TREE_MODEL_ITERS_PERSIST);
 }
 
-/**
- * selection_map_update_selection_from_map:
- * @priv: The private pimpl
- *
- * For currently visible rows in filter, set selection from selection
- * map to treeview.
- **/
 static void
-selection_map_update_selection_from_map         (HildonLiveSearchPrivate *priv)
+threaded_refilter_start                         (HildonLiveSearch *livesearch)
 {
-    GtkTreeSelection *selection;
-    GList *selected_list, *l_iter;
+    HildonLiveSearchPrivate *priv = livesearch->priv;
+    MatchSnapshot *snapshot;
+    MatchJob *job;
+    gboolean handled = FALSE;
+    guint i;
 
-    if (!GTK_IS_TREE_VIEW (priv->kb_focus_widget))
+    chunked_refilter_cancel (priv);
+    match_job_cancel (priv);
+
+    /* Showing all the rows doesn't need any matching */
+    if (priv->prefix == NULL) {
+        refilter (livesearch);
+        selection_map_destroy (priv);
         return;
+    }
 
-    selection = gtk_tree_view_get_selection (GTK_TREE_VIEW (priv->kb_focus_widget));
+    if (!selection_map_save (priv))
+        return;
 
-    /* unselect things which are not in priv->selection_map */
-    selected_list = l_iter = gtk_tree_selection_get_selected_rows (selection,
-                                                                 NULL);
-    while (l_iter) {
-        GtkTreePath *view_path = l_iter->data;
-        GtkTreePath *base_path, *filter_path;
-        filter_path = convert_path_to_child_path (
-            gtk_tree_view_get_model (GTK_TREE_VIEW (priv->kb_focus_widget)),
-            GTK_TREE_MODEL (priv->filter), view_path);
-        base_path = gtk_tree_model_filter_convert_path_to_child_path
-            (priv->filter, filter_path);
+    /* Let handlers prepare for the new text, or take over */
+    g_signal_emit (livesearch, signals[REFILTER], 0, &handled);
+    if (handled) {
+        hidden_rows_invalidate (priv);
+        selection_map_restore (priv);
+        return;
+    }
 
-        if (g_hash_table_find (priv->selection_map,
-                               (GHRFunc) reference_row_has_path, base_path) == NULL)
-            gtk_tree_selection_unselect_path
-                (selection, view_path);
+    snapshot = match_snapshot_get (priv);
+
+    job = g_slice_new0 (MatchJob);
+    job->ref_count = 1;
+    job->livesearch = livesearch;
+    job->snapshot = match_snapshot_ref (snapshot);
+    job->tokens = match_tokens_new (priv->prefix);
+    job->text = g_strdup (priv->prefix);
+    job->ranked = priv->ranked;
+    job->scores = g_new0 (guint16, snapshot->n_rows);
+
+    if (!priv->ranked && priv->match_done != NULL &&
+        priv->match_done->snapshot == snapshot &&
+        g_str_has_prefix (priv->prefix, priv->match_done->text))
+        job->previous = match_job_ref (priv->match_done);
+
+    if (snapshot->n_ranges == 0) {
+        priv->match_job = job;
+        threaded_refilter_apply (livesearch, job);
+        return;
+    }
 
-        gtk_tree_path_free (view_path);
-        gtk_tree_path_free (filter_path);
-        gtk_tree_path_free (base_path);
-        l_iter->data = NULL;
+    if (priv->match_pool == NULL)
+        priv->match_pool = g_thread_pool_new ((GFunc) match_task_run, NULL,
+                                              match_pool_size (priv),
+                                              FALSE, NULL);
 
-        l_iter = g_list_next (l_iter);
+    priv->match_job = match_job_ref (job);
+    job->pending = snapshot->n_ranges;
+
+    /* Each task owns a reference, the first one being ours */
+    for (i = 0; i < snapshot->n_ranges; i++) {
+        MatchTask *task = g_slice_new (MatchTask);
+
+        task->job = i == 0 ? job : match_job_ref (job);
+        task->range = i;
+        g_thread_pool_push (priv->match_pool, task, NULL);
     }
-    g_list_free (selected_list);
+}
 
-    /* going though priv->selection_map to select items */
-    GHashTableIter iter;
-    gpointer key, value;
+/*
+ * IMPLEMENTATION NOTES:
+ * Ranked model. hildon_live_search_get_ranked_model() returns a
+ * #GtkTreeModelSort on top of the filter, whose default sort function
+ * orders the visible rows by score, and then by their order in the
+ * child model. Scores come from the last threaded job when it was for
+ * the current text, and are otherwise computed on the main thread and
+ * kept in priv->rank_scores until the text changes. After each
+ * refilter, the sort function is set again, which sorts the model.
+ */
+static guint
+ranked_row_score                                (HildonLiveSearchPrivate *priv,
+                                                 GtkTreeIter             *iter,
+                                                 guint                   *order)
+{
+    MatchJob *job = priv->match_done;
+    gpointer result;
+    guint score;
 
-    g_hash_table_iter_init (&iter, priv->selection_map);
-    while (g_hash_table_iter_next (&iter, &key, &value)) {
-        GtkTreeRowReference *row_ref = key;
-        GtkTreePath *base_path = gtk_tree_row_reference_get_path (row_ref);
-        GtkTreePath *filter_path = gtk_tree_model_filter_convert_child_path_to_path
-          (priv->filter, base_path);
-        GtkTreePath *view_path;
+    *order = G_MAXUINT;
 
-        if (filter_path == NULL)
-            continue;
+    if (job != NULL && g_strcmp0 (job->text, priv->prefix) == 0 &&
+        match_job_lookup (priv, job, iter, &score, order)) {
+        if (!priv->match_order_valid)
+            *order = G_MAXUINT;
+        return score;
+    }
 
-        view_path = convert_child_path_to_path (
-            gtk_tree_view_get_model (GTK_TREE_VIEW (priv->kb_focus_widget)),
-            GTK_TREE_MODEL (priv->filter), filter_path);
+    if (priv->prefix == NULL) {
+        if (priv->match_snapshot != NULL && priv->match_order_valid &&
+            (priv->match_changed_rows == NULL ||
+             !g_hash_table_contains (priv->match_changed_rows, iter->user_data)))
+            *order = GPOINTER_TO_UINT (g_hash_table_lookup (priv->match_snapshot->index,
+                                                            iter->user_data)) - 1;
+        return 0;
+    }
 
-        gtk_tree_selection_select_path (selection, view_path);
+    if (priv->rank_scores == NULL)
+        priv->rank_scores = g_hash_table_new (g_direct_hash, g_direct_equal);
+
+    if (g_strcmp0 (priv->rank_scores_text, priv->prefix) != 0) {
+        g_hash_table_remove_all (priv->rank_scores);
+        g_free (priv->rank_scores_text);
+        priv->rank_scores_text = g_strdup (priv->prefix);
     }
+
+    if (g_hash_table_lookup_extended (priv->rank_scores, iter->user_data,
+                                      NULL, &result))
+        return GPOINTER_TO_UINT (result);
+
+    score = match_row (priv, priv->base_model, iter);
+    g_hash_table_insert (priv->rank_scores, iter->user_data,
+                         GUINT_TO_POINTER (score));
+
+    return score;
 }
 
-static void
-refilter (HildonLiveSearch *livesearch)
+static gint
+ranked_compare                                  (GtkTreeModel *model,
+                                                 GtkTreeIter  *a,
+                                                 GtkTreeIter  *b,
+                                                 gpointer      user_data)
 {
-    HildonLiveSearchPrivate *priv = livesearch->priv;
-    gboolean handled = FALSE;
-    gboolean needs_mapping;
+    HildonLiveSearchPrivate *priv = user_data;
+    GtkTreeIter child_a, child_b;
+    GtkTreePath *path_a, *path_b;
+    guint score_a, score_b, order_a, order_b;
+    gint result;
 
-    needs_mapping = GTK_IS_TREE_VIEW (priv->kb_focus_widget) &&
-        gtk_tree_selection_get_mode (gtk_tree_view_get_selection (
-                                         GTK_TREE_VIEW (priv->kb_focus_widget))) != GTK_SELECTION_NONE;
+    gtk_tree_model_filter_convert_iter_to_child_iter (priv->filter, &child_a, a);
+    gtk_tree_model_filter_convert_iter_to_child_iter (priv->filter, &child_b, b);
 
-    /* This is not pretty code, but it should fix some warnings in the case we
-       attempt to refilter before the treeview actually has a model. */
-    if (needs_mapping && !gtk_tree_view_get_model (GTK_TREE_VIEW (priv->kb_focus_widget)))
+    if (priv->ranked && threaded_refilter_supported (priv)) {
+        score_a = ranked_row_score (priv, &child_a, &order_a);
+        score_b = ranked_row_score (priv, &child_b, &order_b);
+
+        if (score_a != score_b)
+            return score_a > score_b ? -1 : 1;
+
+        if (order_a != G_MAXUINT && order_b != G_MAXUINT)
+            return order_a < order_b ? -1 : (order_a > order_b ? 1 : 0);
+    }
+
+    /* Keep the order of the child model */
+    path_a = gtk_tree_model_get_path (priv->base_model, &child_a);
+    path_b = gtk_tree_model_get_path (priv->base_model, &child_b);
+    result = gtk_tree_path_compare (path_a, path_b);
+    gtk_tree_path_free (path_a);
+    gtk_tree_path_free (path_b);
+
+    return result;
+}
+
+static gboolean
+ranked_model_supported                          (HildonLiveSearchPrivate *priv)
+{
+    return priv->ranked && priv->ranked_model != NULL &&
+        threaded_refilter_supported (priv);
+}
+
+static void
+ranked_model_resort                             (HildonLiveSearchPrivate *priv)
+{
+    if (!ranked_model_supported (priv))
         return;
 
-    /* Create/update selection map from current selection */
-    if (needs_mapping) {
-        if (priv->selection_map == NULL)
-            selection_map_create (priv);
-        selection_map_update_map_from_selection (priv);
+    /* Setting the default sort function sorts the model again */
+    gtk_tree_sortable_set_default_sort_func (GTK_TREE_SORTABLE (priv->ranked_model),
+                                             ranked_compare, priv, NULL);
+}
+
+static void
+ranked_model_destroy                            (HildonLiveSearchPrivate *priv)
+{
+    if (priv->ranked_model != NULL) {
+        /* The view may still hold a reference on the model */
+        gtk_tree_model_sort_reset_default_sort_func (GTK_TREE_MODEL_SORT (priv->ranked_model));
+        g_object_unref (priv->ranked_model);
+        priv->ranked_model = NULL;
     }
 
-    /* Filter the model */
-    g_signal_emit (livesearch, signals[REFILTER], 0, &handled);
-    if (!handled && priv->filter)
-        gtk_tree_model_filter_refilter (priv->filter);
+    if (priv->rank_scores != NULL) {
+        g_hash_table_destroy (priv->rank_scores);
+        priv->rank_scores = NULL;
+    }
 
-    /* Restore selection from mapping */
-    if (needs_mapping)
-        selection_map_update_selection_from_map (priv);
+    g_free (priv->rank_scores_text);
+    priv->rank_scores_text = NULL;
 }
 
 static gboolean
@@ -439,7 +1924,19 @@ on_entry_changed                                (GtkEntry *entry,
     g_free (priv->prefix);
     priv->prefix = g_strdup (text);
 
-    if (priv->run_async) {
+    if (priv->run_async && threaded_refilter_supported (priv)) {
+        if (priv->idle_filter_id != 0) {
+            g_source_remove (priv->idle_filter_id);
+            priv->idle_filter_id = 0;
+        }
+        threaded_refilter_start (livesearch);
+    } else if (priv->run_async && chunked_refilter_supported (priv)) {
+        if (priv->idle_filter_id != 0) {
+            g_source_remove (priv->idle_filter_id);
+            priv->idle_filter_id = 0;
+        }
+        chunked_refilter_start (livesearch);
+    } else if (priv->run_async) {
         if (priv->idle_filter_id == 0) {
             priv->idle_filter_id = gdk_threads_add_idle ((GSourceFunc) on_idle_refilter, livesearch);
         }
@@ -610,6 +2107,24 @@ hildon_live_search_get_property                 (GObject    *object,
     case PROP_TEXT:
         g_value_set_string (value, livesearch->priv->prefix);
         break;
+    case PROP_INCREMENTAL:
+        g_value_set_boolean (value, livesearch->priv->incremental);
+        break;
+    case PROP_ID_COLUMN:
+        g_value_set_int (value, livesearch->priv->id_column);
+        break;
+    case PROP_CHUNKED:
+        g_value_set_boolean (value, livesearch->priv->chunked);
+        break;
+    case PROP_MATCH_COLUMN:
+        g_value_set_int (value, livesearch->priv->match_column);
+        break;
+    case PROP_MATCH_THREADS:
+        g_value_set_uint (value, livesearch->priv->match_threads);
+        break;
+    case PROP_RANKED:
+        g_value_set_boolean (value, livesearch->priv->ranked);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
     }
@@ -636,6 +2151,30 @@ hildon_live_search_set_property                 (GObject      *object,
         hildon_live_search_set_text (livesearch,
                                      g_value_get_string (value));
         break;
+    case PROP_INCREMENTAL:
+        hildon_live_search_set_incremental (livesearch,
+                                            g_value_get_boolean (value));
+        break;
+    case PROP_ID_COLUMN:
+        hildon_live_search_set_id_column (livesearch,
+                                          g_value_get_int (value));
+        break;
+    case PROP_CHUNKED:
+        hildon_live_search_set_chunked (livesearch,
+                                        g_value_get_boolean (value));
+        break;
+    case PROP_MATCH_COLUMN:
+        hildon_live_search_set_match_column (livesearch,
+                                             g_value_get_int (value));
+        break;
+    case PROP_MATCH_THREADS:
+        hildon_live_search_set_match_threads (livesearch,
+                                              g_value_get_uint (value));
+        break;
+    case PROP_RANKED:
+        hildon_live_search_set_ranked (livesearch,
+                                       g_value_get_boolean (value));
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
     }
@@ -648,6 +2187,41 @@ hildon_live_search_dispose                      (GObject *object)
 
     hildon_live_search_widget_unhook (HILDON_LIVE_SEARCH (object));
 
+    chunked_refilter_cancel (priv);
+    match_job_cancel (priv);
+    base_model_disconnect (priv);
+
+    /* Cancelled tasks return right away */
+    if (priv->match_pool) {
+        g_thread_pool_free (priv->match_pool, FALSE, TRUE);
+        priv->match_pool = NULL;
+    }
+
+    if (priv->match_done) {
+        match_job_unref (priv->match_done);
+        priv->match_done = NULL;
+    }
+
+    if (priv->match_changed_rows) {
+        g_hash_table_destroy (priv->match_changed_rows);
+        priv->match_changed_rows = NULL;
+    }
+
+    g_strfreev (priv->match_tokens);
+    priv->match_tokens = NULL;
+    g_free (priv->match_tokens_text);
+    priv->match_tokens_text = NULL;
+
+    ranked_model_destroy (priv);
+
+    if (priv->hidden_rows) {
+        g_hash_table_destroy (priv->hidden_rows);
+        priv->hidden_rows = NULL;
+    }
+
+    g_free (priv->hidden_prefix);
+    priv->hidden_prefix = NULL;
+
     if (priv->filter) {
         selection_map_destroy (priv);
         g_object_unref (priv->filter);
@@ -684,56 +2258,187 @@ hildon_live_search_class_init                   (HildonLiveSearchClass *klass)
     object_class->dispose = hildon_live_search_dispose;
 
     /**
-     * HildonLiveSearch:filter:
+     * HildonLiveSearch:filter:
+     *
+     * The #GtkTreeModelFilter to filter.
+     *
+     * Since: 2.2.4
+     */
+    g_object_class_install_property (object_class,
+                                     PROP_FILTER,
+                                     g_param_spec_object ("filter",
+                                                          "Filter",
+                                                          "Model filter",
+                                                          GTK_TYPE_TREE_MODEL_FILTER,
+                                                          G_PARAM_READWRITE |
+                                                          G_PARAM_STATIC_NICK |
+                                                          G_PARAM_STATIC_NAME |
+                                                          G_PARAM_STATIC_BLURB));
+
+    /**
+     * HildonLiveSearch:text-column:
+     *
+     * A %G_TYPE_STRING column in the child model of #HildonLiveSearch:filter,
+     * to be used by the default filtering function of #HildonLiveSearch.
+     *
+     * Since: 2.2.4
+     */
+    g_object_class_install_property (object_class,
+                                     PROP_TEXT_COLUMN,
+                                     g_param_spec_int ("text-column",
+                                                       "Text column",
+                                                       "Column to use to filter "
+                                                       "elements from the #GtkTreeModelFilter",
+                                                       -1, G_MAXINT, -1,
+                                                       G_PARAM_READWRITE |
+                                                       G_PARAM_STATIC_STRINGS));
+
+    /**
+     * HildonLiveSearch:text:
+     *
+     * The text used to filter
+     *
+     * Since: 2.2.15
+     */
+    g_object_class_install_property (object_class,
+                                     PROP_TEXT,
+                                     g_param_spec_string ("text",
+                                                       "Text",
+                                                       "Text to use as a filter",
+                                                       "",
+                                                       G_PARAM_READWRITE |
+                                                       G_PARAM_STATIC_STRINGS));
+
+    /**
+     * HildonLiveSearch:incremental:
+     *
+     * Whether the function set with hildon_live_search_set_visible_func()
+     * only narrows the set of visible rows when the text grows, that is,
+     * whether a row hidden for a given text is also hidden for any text
+     * starting with it. In that case, only the rows that were visible are
+     * tested again when text is appended. The default filtering function
+     * always behaves this way.
+     *
+     * Since: 3.0
+     */
+    g_object_class_install_property (object_class,
+                                     PROP_INCREMENTAL,
+                                     g_param_spec_boolean ("incremental",
+                                                           "Incremental",
+                                                           "Whether the visible function "
+                                                           "narrows as the text grows",
+                                                           FALSE,
+                                                           G_PARAM_READWRITE |
+                                                           G_PARAM_STATIC_STRINGS));
+
+    /**
+     * HildonLiveSearch:id-column:
+     *
+     * A column in the child model of #HildonLiveSearch:filter holding a
+     * unique identifier for each row, or -1. When the live search is
+     * hooked to a #GtkTreeView, it is used to remember which rows are
+     * selected while they are filtered out. Its type must be convertible
+     * to %G_TYPE_STRING.
+     *
+     * Since: 3.0
+     */
+    g_object_class_install_property (object_class,
+                                     PROP_ID_COLUMN,
+                                     g_param_spec_int ("id-column",
+                                                       "ID column",
+                                                       "Column with a unique identifier "
+                                                       "for each row",
+                                                       -1, G_MAXINT, -1,
+                                                       G_PARAM_READWRITE |
+                                                       G_PARAM_STATIC_STRINGS));
+
+    /**
+     * HildonLiveSearch:chunked:
      *
-     * The #GtkTreeModelFilter to filter.
+     * Whether to filter the rows in short time slices from the main
+     * loop when the user types, instead of all at once. The rows of each
+     * slice that are shown or hidden by the new text are updated in the
+     * filter as soon as the slice is done, and typing more text cancels
+     * the filtering in progress. Useful with large models, so that
+     * typing stays responsive.
      *
-     * Since: 2.2.4
+     * The visible function may then be called outside of
+     * #HildonLiveSearch::refilter, but always after it was emitted for
+     * the current text.
+     *
+     * Since: 3.0
      */
     g_object_class_install_property (object_class,
-                                     PROP_FILTER,
-                                     g_param_spec_object ("filter",
-                                                          "Filter",
-                                                          "Model filter",
-                                                          GTK_TYPE_TREE_MODEL_FILTER,
-                                                          G_PARAM_READWRITE |
-                                                          G_PARAM_STATIC_NICK |
-                                                          G_PARAM_STATIC_NAME |
-                                                          G_PARAM_STATIC_BLURB));
+                                     PROP_CHUNKED,
+                                     g_param_spec_boolean ("chunked",
+                                                           "Chunked",
+                                                           "Whether to filter in time slices "
+                                                           "while typing",
+                                                           FALSE,
+                                                           G_PARAM_READWRITE |
+                                                           G_PARAM_STATIC_STRINGS));
 
     /**
-     * HildonLiveSearch:text-column:
+     * HildonLiveSearch:match-column:
      *
      * A %G_TYPE_STRING column in the child model of #HildonLiveSearch:filter,
-     * to be used by the default filtering function of #HildonLiveSearch.
+     * or -1. When set, a row is visible if each word of the text matches
+     * the beginning of a word in this column, ignoring case and accents.
+     * See hildon_live_search_set_match_column().
      *
-     * Since: 2.2.4
+     * Since: 3.0
      */
     g_object_class_install_property (object_class,
-                                     PROP_TEXT_COLUMN,
-                                     g_param_spec_int ("text-column",
-                                                       "Text column",
-                                                       "Column to use to filter "
-                                                       "elements from the #GtkTreeModelFilter",
+                                     PROP_MATCH_COLUMN,
+                                     g_param_spec_int ("match-column",
+                                                       "Match column",
+                                                       "Column whose words are matched "
+                                                       "on worker threads",
                                                        -1, G_MAXINT, -1,
                                                        G_PARAM_READWRITE |
                                                        G_PARAM_STATIC_STRINGS));
 
     /**
-     * HildonLiveSearch:text:
+     * HildonLiveSearch:match-threads:
      *
-     * The text used to filter
+     * The number of worker threads matching the rows when
+     * #HildonLiveSearch:match-column is set, or 0 to use one per
+     * processor.
      *
-     * Since: 2.2.15
+     * Since: 3.0
      */
     g_object_class_install_property (object_class,
-                                     PROP_TEXT,
-                                     g_param_spec_string ("text",
-                                                       "Text",
-                                                       "Text to use as a filter",
-                                                       "",
-                                                       G_PARAM_READWRITE |
-                                                       G_PARAM_STATIC_STRINGS));
+                                     PROP_MATCH_THREADS,
+                                     g_param_spec_uint ("match-threads",
+                                                        "Match threads",
+                                                        "Number of threads matching "
+                                                        "the rows",
+                                                        0, G_MAXUINT, 0,
+                                                        G_PARAM_READWRITE |
+                                                        G_PARAM_STATIC_STRINGS));
+
+    /**
+     * HildonLiveSearch:ranked:
+     *
+     * Whether #HildonLiveSearch:match-column is matched loosely, and
+     * the matches ranked. Each word of the text then matches rows where
+     * it appears at the start of the column, at the start of a word, in
+     * the middle of a word, with other characters in between, or with a
+     * typo, from the best match to the worst. Use
+     * hildon_live_search_get_ranked_model() to show the best matches
+     * first.
+     *
+     * Since: 3.0
+     */
+    g_object_class_install_property (object_class,
+                                     PROP_RANKED,
+                                     g_param_spec_boolean ("ranked",
+                                                           "Ranked",
+                                                           "Whether to match loosely and "
+                                                           "rank the matches",
+                                                           FALSE,
+                                                           G_PARAM_READWRITE |
+                                                           G_PARAM_STATIC_STRINGS));
 
   /**
    * HildonLiveSearch::refilter:
@@ -800,8 +2505,47 @@ hildon_live_search_init                         (HildonLiveSearch *self)
     priv->idle_filter_id = 0;
 
     priv->selection_map = NULL;
+    priv->selection_key = SELECTION_KEY_PATH;
+    priv->id_column = -1;
     priv->run_async = TRUE;
 
+    priv->incremental = FALSE;
+    priv->refiltering = FALSE;
+    priv->narrowing = FALSE;
+    priv->hidden_rows = NULL;
+    priv->hidden_rows_valid = FALSE;
+    priv->hidden_prefix = NULL;
+    priv->base_model = NULL;
+    priv->row_inserted_id = 0;
+    priv->row_changed_id = 0;
+    priv->row_deleted_id = 0;
+    priv->rows_reordered_id = 0;
+
+    priv->chunked = FALSE;
+    priv->chunk_source_id = 0;
+    priv->chunk_iter_valid = FALSE;
+    priv->chunk_narrowing = FALSE;
+    priv->chunk_publishing = FALSE;
+    priv->chunk_results = NULL;
+    priv->chunk_changed = NULL;
+
+    priv->match_column = -1;
+    priv->match_threads = 0;
+    priv->match_pool = NULL;
+    priv->match_snapshot = NULL;
+    priv->match_changed_rows = NULL;
+    priv->match_order_valid = FALSE;
+    priv->match_job = NULL;
+    priv->match_done = NULL;
+    priv->match_applying = FALSE;
+    priv->match_tokens = NULL;
+    priv->match_tokens_text = NULL;
+
+    priv->ranked = FALSE;
+    priv->ranked_model = NULL;
+    priv->rank_scores = NULL;
+    priv->rank_scores_text = NULL;
+
     priv->text_column = -1;
 
     entry_container = gtk_tool_item_new ();
@@ -883,6 +2627,8 @@ visible_func                                    (GtkTreeModel *model,
 {
     HildonLiveSearchPrivate *priv;
     gchar *string;
+    gpointer result;
+    guint score;
     gboolean visible = FALSE;
 
     priv = (HildonLiveSearchPrivate *) data;
@@ -890,19 +2636,37 @@ visible_func                                    (GtkTreeModel *model,
     if (priv->prefix == NULL)
         return TRUE;
 
-    if (priv->visible_func == NULL && priv->text_column == -1)
+    if (priv->visible_func == NULL && priv->text_column == -1 &&
+        priv->match_column == -1)
         return TRUE;
 
-    if (priv->visible_func) {
+    if (priv->chunk_publishing && priv->chunk_results != NULL &&
+        g_hash_table_lookup_extended (priv->chunk_results, iter->user_data,
+                                      NULL, &result)) {
+        /* Already tested by a chunked refilter */
+        visible = GPOINTER_TO_INT (result);
+    } else if (priv->match_applying &&
+               match_job_lookup (priv, priv->match_done, iter, &score, NULL)) {
+        /* Already matched by a worker thread */
+        visible = score > 0;
+    } else if (priv->narrowing &&
+               g_hash_table_contains (priv->hidden_rows, iter->user_data)) {
+        return FALSE;
+    } else if (priv->visible_func) {
         visible = (priv->visible_func) (model, iter,
                                         priv->prefix,
                                         priv->visible_data);
+    } else if (priv->match_column != -1) {
+        visible = match_row (priv, model, iter) > 0;
     } else {
         gtk_tree_model_get (model, iter, priv->text_column, &string, -1);
         visible = (string != NULL && g_str_has_prefix (string, priv->prefix));
         g_free (string);
     }
 
+    if (!visible && priv->refiltering && priv->hidden_rows != NULL)
+        g_hash_table_add (priv->hidden_rows, iter->user_data);
+
     return visible;
 }
 
@@ -932,13 +2696,23 @@ hildon_live_search_set_filter                   (HildonLiveSearch   *livesearch,
     if (filter)
         g_object_ref (filter);
 
+    chunked_refilter_cancel (priv);
+    base_model_disconnect (priv);
+
+    /* The rows in the map belong to the previous model */
+    selection_map_destroy (priv);
+    ranked_model_destroy (priv);
+
     if (priv->filter)
         g_object_unref (priv->filter);
 
     priv->filter = filter;
 
+    base_model_connect (priv);
+
     if (priv->visible_func_set == FALSE &&
-        (priv->text_column != -1 || priv->visible_func)) {
+        (priv->text_column != -1 || priv->visible_func ||
+         priv->match_column != -1)) {
         gtk_tree_model_filter_set_visible_func (filter,
                                                 visible_func,
                                                 priv,
@@ -1000,11 +2774,13 @@ hildon_live_search_set_text_column              (HildonLiveSearch *livesearch,
 
     g_return_if_fail (text_column < gtk_tree_model_get_n_columns (gtk_tree_model_filter_get_model (priv->filter)));
     g_return_if_fail (priv->visible_func == NULL);
+    g_return_if_fail (priv->match_column == -1);
 
     if (priv->text_column == text_column)
         return;
 
     priv->text_column = text_column;
+    hidden_rows_invalidate (priv);
 
     if (priv->visible_func_set == FALSE) {
         gtk_tree_model_filter_set_visible_func (priv->filter,
@@ -1195,6 +2971,7 @@ hildon_live_search_set_visible_func             (HildonLiveSearch           *liv
     priv = livesearch->priv;
 
     g_return_if_fail (priv->text_column == -1);
+    g_return_if_fail (priv->match_column == -1);
 
     if (priv->visible_destroy) {
         priv->visible_destroy (priv->visible_data);
@@ -1203,6 +2980,7 @@ hildon_live_search_set_visible_func             (HildonLiveSearch           *liv
     priv->visible_func = func;
     priv->visible_data = data;
     priv->visible_destroy = destroy;
+    hidden_rows_invalidate (priv);
 
     if (priv->visible_func_set == FALSE) {
         gtk_tree_model_filter_set_visible_func (priv->filter,
@@ -1243,3 +3021,405 @@ hildon_live_search_clean_selection_map (HildonLiveSearch * livesearch)
         selection_map_update_map_from_selection (livesearch->priv);
     }
 }
+
+/**
+ * hildon_live_search_set_incremental:
+ * @livesearch: a #HildonLiveSearch
+ * @incremental: whether the visible function narrows as the text grows
+ *
+ * Sets #HildonLiveSearch:incremental. Only set this to %TRUE if the
+ * function given to hildon_live_search_set_visible_func() never shows
+ * a row for a text that it hid for a prefix of that text.
+ *
+ * Incremental filtering is only done on child models that are
+ * lists (%GTK_TREE_MODEL_LIST_ONLY) with persistent iters
+ * (%GTK_TREE_MODEL_ITERS_PERSIST), such as #GtkListStore.
+ *
+ * Since: 3.0
+ **/
+void
+hildon_live_search_set_incremental              (HildonLiveSearch *livesearch,
+                                                 gboolean          incremental)
+{
+    HildonLiveSearchPrivate *priv;
+
+    g_return_if_fail (HILDON_IS_LIVE_SEARCH (livesearch));
+
+    priv = livesearch->priv;
+    incremental = incremental ? TRUE : FALSE;
+
+    if (priv->incremental == incremental)
+        return;
+
+    priv->incremental = incremental;
+    hidden_rows_invalidate (priv);
+
+    g_object_notify (G_OBJECT (livesearch), "incremental");
+}
+
+/**
+ * hildon_live_search_get_incremental:
+ * @livesearch: a #HildonLiveSearch
+ *
+ * Gets the value of #HildonLiveSearch:incremental.
+ *
+ * Returns: whether the visible function of @livesearch is declared
+ * to narrow as the text grows.
+ *
+ * Since: 3.0
+ **/
+gboolean
+hildon_live_search_get_incremental              (HildonLiveSearch *livesearch)
+{
+    g_return_val_if_fail (HILDON_IS_LIVE_SEARCH (livesearch), FALSE);
+
+    return livesearch->priv->incremental;
+}
+
+/**
+ * hildon_live_search_set_id_column:
+ * @livesearch: a #HildonLiveSearch
+ * @id_column: a column in the child model of the filter of @livesearch, or -1
+ *
+ * Sets #HildonLiveSearch:id-column. When set, rows are identified by
+ * the value in this column to keep them selected while they are
+ * filtered out. Otherwise the rows themselves are tracked, which is
+ * slower for child models whose iters don't persist.
+ *
+ * Since: 3.0
+ **/
+void
+hildon_live_search_set_id_column                (HildonLiveSearch *livesearch,
+                                                 gint              id_column)
+{
+    HildonLiveSearchPrivate *priv;
+
+    g_return_if_fail (HILDON_IS_LIVE_SEARCH (livesearch));
+    g_return_if_fail (-1 <= id_column);
+
+    priv = livesearch->priv;
+
+    if (priv->id_column == id_column)
+        return;
+
+    priv->id_column = id_column;
+
+    /* Keep the rows already in the map */
+    selection_map_rekey (priv);
+
+    g_object_notify (G_OBJECT (livesearch), "id-column");
+}
+
+/**
+ * hildon_live_search_get_id_column:
+ * @livesearch: a #HildonLiveSearch
+ *
+ * Gets the value of #HildonLiveSearch:id-column.
+ *
+ * Returns: the column identifying the rows of the child model, or -1.
+ *
+ * Since: 3.0
+ **/
+gint
+hildon_live_search_get_id_column                (HildonLiveSearch *livesearch)
+{
+    g_return_val_if_fail (HILDON_IS_LIVE_SEARCH (livesearch), -1);
+
+    return livesearch->priv->id_column;
+}
+
+/**
+ * hildon_live_search_set_chunked:
+ * @livesearch: a #HildonLiveSearch
+ * @chunked: whether to filter in time slices while typing
+ *
+ * Sets #HildonLiveSearch:chunked. Chunked filtering is only done on
+ * child models that are lists (%GTK_TREE_MODEL_LIST_ONLY) with
+ * persistent iters (%GTK_TREE_MODEL_ITERS_PERSIST), such as
+ * #GtkListStore.
+ *
+ * Since: 3.0
+ **/
+void
+hildon_live_search_set_chunked                  (HildonLiveSearch *livesearch,
+                                                 gboolean          chunked)
+{
+    HildonLiveSearchPrivate *priv;
+
+    g_return_if_fail (HILDON_IS_LIVE_SEARCH (livesearch));
+
+    priv = livesearch->priv;
+    chunked = chunked ? TRUE : FALSE;
+
+    if (priv->chunked == chunked)
+        return;
+
+    priv->chunked = chunked;
+
+    /* Finish a pending pass right away */
+    if (!chunked && priv->chunk_source_id != 0)
+        refilter (livesearch);
+
+    g_object_notify (G_OBJECT (livesearch), "chunked");
+}
+
+/**
+ * hildon_live_search_get_chunked:
+ * @livesearch: a #HildonLiveSearch
+ *
+ * Gets the value of #HildonLiveSearch:chunked.
+ *
+ * Returns: whether @livesearch filters in time slices while typing.
+ *
+ * Since: 3.0
+ **/
+gboolean
+hildon_live_search_get_chunked                  (HildonLiveSearch *livesearch)
+{
+    g_return_val_if_fail (HILDON_IS_LIVE_SEARCH (livesearch), FALSE);
+
+    return livesearch->priv->chunked;
+}
+
+/**
+ * hildon_live_search_set_match_column:
+ * @livesearch: a #HildonLiveSearch
+ * @match_column: a %G_TYPE_STRING column in the child model of the
+ * filter of @livesearch, or -1
+ *
+ * Sets #HildonLiveSearch:match-column. Rows are then visible when each
+ * word of the text matches the beginning of a word in @match_column,
+ * as with hildon_helper_smart_match() on strings normalized with
+ * hildon_helper_normalize_string().
+ *
+ * While typing, the rows are matched on a copy of @match_column by
+ * #HildonLiveSearch:match-threads worker threads, and the filter is
+ * updated once all of them are done. The copy is taken again when
+ * many rows change. This is only done on child models that are lists
+ * (%GTK_TREE_MODEL_LIST_ONLY) with persistent iters
+ * (%GTK_TREE_MODEL_ITERS_PERSIST), such as #GtkListStore; other models
+ * are matched on the main thread.
+ *
+ * Note that you can only use one of #HildonLiveSearch:text-column,
+ * #HildonLiveSearch:match-column or hildon_live_search_set_visible_func().
+ *
+ * Since: 3.0
+ **/
+void
+hildon_live_search_set_match_column             (HildonLiveSearch *livesearch,
+                                                 gint              match_column)
+{
+    HildonLiveSearchPrivate *priv;
+
+    g_return_if_fail (HILDON_IS_LIVE_SEARCH (livesearch));
+    g_return_if_fail (-1 <= match_column);
+
+    priv = livesearch->priv;
+
+    g_return_if_fail (priv->filter != NULL);
+    g_return_if_fail (match_column < gtk_tree_model_get_n_columns (gtk_tree_model_filter_get_model (priv->filter)));
+    g_return_if_fail (priv->visible_func == NULL);
+    g_return_if_fail (priv->text_column == -1);
+
+    if (priv->match_column == match_column)
+        return;
+
+    match_job_cancel (priv);
+    if (priv->match_done != NULL) {
+        match_job_unref (priv->match_done);
+        priv->match_done = NULL;
+    }
+    match_snapshot_invalidate (priv);
+
+    priv->match_column = match_column;
+    hidden_rows_invalidate (priv);
+
+    if (priv->visible_func_set == FALSE) {
+        gtk_tree_model_filter_set_visible_func (priv->filter,
+                                                visible_func,
+                                                priv,
+                                                NULL);
+        priv->visible_func_set = TRUE;
+    }
+
+    refilter (livesearch);
+
+    g_object_notify (G_OBJECT (livesearch), "match-column");
+}
+
+/**
+ * hildon_live_search_get_match_column:
+ * @livesearch: a #HildonLiveSearch
+ *
+ * Gets the value of #HildonLiveSearch:match-column.
+ *
+ * Returns: the column matched on worker threads, or -1.
+ *
+ * Since: 3.0
+ **/
+gint
+hildon_live_search_get_match_column             (HildonLiveSearch *livesearch)
+{
+    g_return_val_if_fail (HILDON_IS_LIVE_SEARCH (livesearch), -1);
+
+    return livesearch->priv->match_column;
+}
+
+/**
+ * hildon_live_search_set_match_threads:
+ * @livesearch: a #HildonLiveSearch
+ * @n_threads: the number of worker threads, or 0 for one per processor
+ *
+ * Sets #HildonLiveSearch:match-threads.
+ *
+ * Since: 3.0
+ **/
+void
+hildon_live_search_set_match_threads            (HildonLiveSearch *livesearch,
+                                                 guint             n_threads)
+{
+    HildonLiveSearchPrivate *priv;
+
+    g_return_if_fail (HILDON_IS_LIVE_SEARCH (livesearch));
+
+    priv = livesearch->priv;
+
+    if (priv->match_threads == n_threads)
+        return;
+
+    priv->match_threads = n_threads;
+
+    if (priv->match_pool != NULL)
+        g_thread_pool_set_max_threads (priv->match_pool,
+                                       match_pool_size (priv), NULL);
+
+    g_object_notify (G_OBJECT (livesearch), "match-threads");
+}
+
+/**
+ * hildon_live_search_get_match_threads:
+ * @livesearch: a #HildonLiveSearch
+ *
+ * Gets the value of #HildonLiveSearch:match-threads.
+ *
+ * Returns: the number of worker threads, or 0 for one per processor.
+ *
+ * Since: 3.0
+ **/
+guint
+hildon_live_search_get_match_threads            (HildonLiveSearch *livesearch)
+{
+    g_return_val_if_fail (HILDON_IS_LIVE_SEARCH (livesearch), 0);
+
+    return livesearch->priv->match_threads;
+}
+
+/**
+ * hildon_live_search_set_ranked:
+ * @livesearch: a #HildonLiveSearch
+ * @ranked: whether to match loosely and rank the matches
+ *
+ * Sets #HildonLiveSearch:ranked.
+ *
+ * Since: 3.0
+ **/
+void
+hildon_live_search_set_ranked                   (HildonLiveSearch *livesearch,
+                                                 gboolean          ranked)
+{
+    HildonLiveSearchPrivate *priv;
+
+    g_return_if_fail (HILDON_IS_LIVE_SEARCH (livesearch));
+
+    priv = livesearch->priv;
+    ranked = ranked ? TRUE : FALSE;
+
+    if (priv->ranked == ranked)
+        return;
+
+    priv->ranked = ranked;
+
+    /* The scores and visible rows change */
+    match_job_cancel (priv);
+    if (priv->match_done != NULL) {
+        match_job_unref (priv->match_done);
+        priv->match_done = NULL;
+    }
+    if (priv->rank_scores != NULL)
+        g_hash_table_remove_all (priv->rank_scores);
+    hidden_rows_invalidate (priv);
+
+    if (priv->match_column != -1)
+        refilter (livesearch);
+
+    /* Back to the order of the child model */
+    if (!ranked && priv->ranked_model != NULL)
+        gtk_tree_sortable_set_default_sort_func (GTK_TREE_SORTABLE (priv->ranked_model),
+                                                 ranked_compare, priv, NULL);
+
+    g_object_notify (G_OBJECT (livesearch), "ranked");
+}
+
+/**
+ * hildon_live_search_get_ranked:
+ * @livesearch: a #HildonLiveSearch
+ *
+ * Gets the value of #HildonLiveSearch:ranked.
+ *
+ * Returns: whether @livesearch matches loosely and ranks the matches.
+ *
+ * Since: 3.0
+ **/
+gboolean
+hildon_live_search_get_ranked                   (HildonLiveSearch *livesearch)
+{
+    g_return_val_if_fail (HILDON_IS_LIVE_SEARCH (livesearch), FALSE);
+
+    return livesearch->priv->ranked;
+}
+
+/**
+ * hildon_live_search_get_ranked_model:
+ * @livesearch: a #HildonLiveSearch
+ *
+ * Gets a #GtkTreeModelSort on top of the filter of @livesearch which,
+ * with #HildonLiveSearch:ranked set, sorts the visible rows from the
+ * best match to the worst, keeping the order of the child model for
+ * equal matches. Use it as the model of the view instead of the
+ * filter.
+ *
+ * Ranking is only done on child models that are lists
+ * (%GTK_TREE_MODEL_LIST_ONLY) with persistent iters
+ * (%GTK_TREE_MODEL_ITERS_PERSIST), such as #GtkListStore; the rows of
+ * other models keep their order. A new model is created when the
+ * filter of @livesearch changes.
+ *
+ * Returns: (transfer none): the ranked model, or %NULL if @livesearch
+ * has no filter.
+ *
+ * Since: 3.0
+ **/
+GtkTreeModel *
+hildon_live_search_get_ranked_model             (HildonLiveSearch *livesearch)
+{
+    HildonLiveSearchPrivate *priv;
+
+    g_return_val_if_fail (HILDON_IS_LIVE_SEARCH (livesearch), NULL);
+
+    priv = livesearch->priv;
+
+    if (priv->filter == NULL)
+        return NULL;
+
+    if (priv->ranked_model == NULL) {
+        priv->ranked_model =
+            gtk_tree_model_sort_new_with_model (GTK_TREE_MODEL (priv->filter));
+        gtk_tree_sortable_set_default_sort_func (GTK_TREE_SORTABLE (priv->ranked_model),
+                                                 ranked_compare, priv, NULL);
+        gtk_tree_sortable_set_sort_column_id (GTK_TREE_SORTABLE (priv->ranked_model),
+                                              GTK_TREE_SORTABLE_DEFAULT_SORT_COLUMN_ID,
+                                              GTK_SORT_ASCENDING);
+    }
+
+    return priv->ranked_model;
+}
@@ -141,6 +141,51 @@ hildon_live_search_set_visible_func              (HildonLiveSearch           *li
 void
 hildon_live_search_clean_selection_map           (HildonLiveSearch * livesearch);
 
+void
+hildon_live_search_set_incremental               (HildonLiveSearch *livesearch,
+                                                  gboolean          incremental);
+
+gboolean
+hildon_live_search_get_incremental               (HildonLiveSearch *livesearch);
+
+void
+hildon_live_search_set_id_column                 (HildonLiveSearch *livesearch,
+                                                  gint              id_column);
+
+gint
+hildon_live_search_get_id_column                 (HildonLiveSearch *livesearch);
+
+void
+hildon_live_search_set_chunked                   (HildonLiveSearch *livesearch,
+                                                  gboolean          chunked);
+
+gboolean
+hildon_live_search_get_chunked                   (HildonLiveSearch *livesearch);
+
+void
+hildon_live_search_set_match_column              (HildonLiveSearch *livesearch,
+                                                  gint              match_column);
+
+gint
+hildon_live_search_get_match_column              (HildonLiveSearch *livesearch);
+
+void
+hildon_live_search_set_match_threads             (HildonLiveSearch *livesearch,
+                                                  guint             n_threads);
+
+guint
+hildon_live_search_get_match_threads             (HildonLiveSearch *livesearch);
+
+void
+hildon_live_search_set_ranked                    (HildonLiveSearch *livesearch,
+                                                  gboolean          ranked);
+
+gboolean
+hildon_live_search_get_ranked                    (HildonLiveSearch *livesearch);
+
+GtkTreeModel *
+hildon_live_search_get_ranked_model              (HildonLiveSearch *livesearch);
+
 G_END_DECLS
 
 #endif                                          /* __HILDON_LIVE_SEARCH__ */
@@ -40,14 +40,32 @@
 
 #undef HILDON_DISABLE_DEPRECATED
 
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
 #include <math.h>
+#include <string.h>
 #include <cairo.h>
 #include <gdk/gdk.h>
 
+#ifdef HAVE_SYSPROF
+#include <sysprof-capture.h>
+#endif
+
 #include "hildon-pannable-area.h"
 #include "hildon-marshalers.h"
 #include "hildon-enum-types.h"
 
+/* Marks the time spent since @start in a sysprof capture */
+#ifdef HAVE_SYSPROF
+#define HILDON_PANNABLE_AREA_MARK(start, name) \
+  sysprof_collector_mark ((start) * 1000, (g_get_monotonic_time () - (start)) * 1000, \
+                          "HildonPannableArea", (name), NULL)
+#else
+#define HILDON_PANNABLE_AREA_MARK(start, name) G_STMT_START { (void) (start); } G_STMT_END
+#endif
+
 #define SCROLL_BAR_MIN_SIZE 5
 #define RATIO_TOLERANCE 0.000001
 #define SCROLL_FADE_IN_TIMEOUT 50
@@ -60,6 +78,35 @@
 #define ACCEL_FACTOR 27
 #define MIN_ACCEL_THRESHOLD 40
 #define FAST_CLICK 125
+#define DEFAULT_FORCE 50
+#define DEFAULT_SPS 20
+#define MAX_FRAME_INTERVAL 50000
+#define SPRING_SETTLE_FACTOR 6.6
+#define SPRING_REST_DISTANCE 0.5
+#define SPRING_REST_VELOCITY 10.0
+
+/* Kinetic state of one of the scrolling axes. Velocities are in
+   adjustment units per second and grow with the adjustment value, the
+   overshoot is how far the child is moved past the adjustment
+   bounds, positive past the upper one */
+typedef struct {
+  gdouble vel;
+  gdouble overshoot;
+  gdouble drag_start;
+  gdouble target;
+  gdouble bounce_from;
+  gint64 bounce_start;
+  gboolean bouncing;
+} HildonPannableAreaAxis;
+
+/* A call deferred with hildon_pannable_area_defer_until_settled() */
+typedef struct {
+  GtkWidget *widget;
+  GSourceFunc func;
+  gpointer data;
+  GDestroyNotify notify;
+  gulong destroy_id;
+} HildonPannableAreaDeferred;
 
 struct _HildonPannableAreaPrivate {
   HildonPannableAreaMode mode;
@@ -166,6 +213,27 @@ struct _HildonPannableAreaPrivate {
   gint64 end_time;
   guint tick_id;
   GdkFrameClock *clock;
+
+  GtkGesture *drag_gesture;
+  gboolean dragging;            /* the press moved past the panning threshold */
+  gboolean kinetic;             /* moving on its own after a release */
+  HildonPannableAreaScrollMode scroll_mode;
+  gboolean spring;              /* following a scroll_to() target */
+  gdouble spring_omega;
+
+  gboolean is_panning;
+  gdouble scroll_velocity;
+  GQueue deferred;              /* oldest call first */
+  guint deferred_id;
+
+  HildonPannableAreaStats stats;
+  gint64 stats_frame_time;      /* last frame counted in the stats */
+  gint64 last_frame_time;
+  gdouble last_offset_x;
+  gdouble last_offset_y;
+  HildonPannableAreaAxis haxis;
+  HildonPannableAreaAxis vaxis;
+  GtkAllocation child_allocation; /* without the overshoot */
 };
 
 /*signals*/
@@ -174,6 +242,7 @@ enum {
   VERTICAL_MOVEMENT,
   PANNING_STARTED,
   PANNING_FINISHED,
+  SETTLED,
   LAST_SIGNAL
 };
 
@@ -206,6 +275,9 @@ enum {
   PROP_HADJUSTMENT,
   PROP_VADJUSTMENT,
   PROP_CENTER_ON_CHILD_FOCUS,
+  PROP_SCROLL_MODE,
+  PROP_IS_PANNING,
+  PROP_SCROLL_VELOCITY,
   PROP_LAST
 };
 
@@ -235,6 +307,23 @@ static void hildon_pannable_area_remove (GtkContainer *container, GtkWidget *chi
 static void hildon_pannable_area_set_focus_child (GtkContainer *container,
                                                  GtkWidget *child);
 static void hildon_pannable_area_center_on_child_focus (HildonPannableArea *area);
+static gboolean hildon_pannable_area_draw (GtkWidget *widget, cairo_t *cr);
+static void hildon_pannable_area_size_allocate (GtkWidget *widget,
+                                                GtkAllocation *allocation);
+static void hildon_pannable_area_drag_begin (GtkGestureDrag *gesture,
+                                             gdouble start_x, gdouble start_y,
+                                             HildonPannableArea *area);
+static void hildon_pannable_area_drag_update (GtkGestureDrag *gesture,
+                                              gdouble offset_x, gdouble offset_y,
+                                              HildonPannableArea *area);
+static void hildon_pannable_area_drag_end (GtkGestureDrag *gesture,
+                                           gdouble offset_x, gdouble offset_y,
+                                           HildonPannableArea *area);
+static void hildon_pannable_area_drag_cancel (GtkGesture *gesture,
+                                              GdkEventSequence *sequence,
+                                              HildonPannableArea *area);
+static void hildon_pannable_area_stop (HildonPannableArea *area);
+static void hildon_pannable_area_deferred_free (HildonPannableAreaDeferred *deferred);
 
 
 static void
@@ -263,6 +352,9 @@ hildon_pannable_area_class_init (HildonPannableAreaClass * class)
   object_class->set_property = hildon_pannable_area_set_property;
   object_class->get_property = hildon_pannable_area_get_property;
 
+  widget_class->draw = hildon_pannable_area_draw;
+  widget_class->size_allocate = hildon_pannable_area_size_allocate;
+
 //FIXME: Breaks scrolling.  Not adding viewport?
 /*  container_class->add = hildon_pannable_area_add;
   container_class->remove = hildon_pannable_area_remove;
@@ -537,6 +629,66 @@ hildon_pannable_area_class_init (HildonPannableAreaClass * class)
                                                          G_PARAM_READWRITE |
                                                          G_PARAM_CONSTRUCT));
 
+  /**
+   * HildonPannableArea:scroll-mode:
+   *
+   * The animation used by hildon_pannable_area_scroll_to() and
+   * hildon_pannable_area_scroll_to_child(). With
+   * %HILDON_PANNABLE_AREA_SCROLL_SPRING, calling them again while
+   * scrolling, or during a kinetic movement, changes the target
+   * without stopping, and the time to reach it grows with the
+   * distance, up to #HildonPannableArea:scroll-time seconds.
+   *
+   * Since: 3.0
+   */
+  g_object_class_install_property (object_class,
+                                   PROP_SCROLL_MODE,
+                                   g_param_spec_enum ("scroll-mode",
+                                                      "Scroll mode",
+                                                      "The animation used to scroll to a position.",
+                                                      HILDON_TYPE_PANNABLE_AREA_SCROLL_MODE,
+                                                      HILDON_PANNABLE_AREA_SCROLL_EASE,
+                                                      G_PARAM_READWRITE |
+                                                      G_PARAM_STATIC_STRINGS));
+
+  /**
+   * HildonPannableArea:is-panning:
+   *
+   * Whether the area is moving, because it is dragged, because of a
+   * kinetic movement or a bounce, or because of a
+   * hildon_pannable_area_scroll_to() animation. It changes between the
+   * #HildonPannableArea::panning-started and
+   * #HildonPannableArea::panning-finished signals.
+   *
+   * Since: 3.0
+   */
+  g_object_class_install_property (object_class,
+                                   PROP_IS_PANNING,
+                                   g_param_spec_boolean ("is-panning",
+                                                         "Is panning",
+                                                         "Whether the area is moving.",
+                                                         FALSE,
+                                                         G_PARAM_READABLE |
+                                                         G_PARAM_STATIC_STRINGS));
+
+  /**
+   * HildonPannableArea:scroll-velocity:
+   *
+   * The speed of the content of the area while it moves, in pixels
+   * per second. It is notified at most once per frame, and goes back
+   * to 0 when the area stops.
+   *
+   * Since: 3.0
+   */
+  g_object_class_install_property (object_class,
+                                   PROP_SCROLL_VELOCITY,
+                                   g_param_spec_double ("scroll-velocity",
+                                                        "Scroll velocity",
+                                                        "The speed of the content, in pixels per second.",
+                                                        0, G_MAXDOUBLE, 0,
+                                                        G_PARAM_READABLE |
+                                                        G_PARAM_STATIC_STRINGS));
+
 
   gtk_widget_class_install_style_property (widget_class,
 					   g_param_spec_uint
@@ -631,7 +783,9 @@ hildon_pannable_area_class_init (HildonPannableAreaClass * class)
    * panning
    *
    * This signal is emitted after the kinetic panning has
-   * finished.
+   * finished. Since 3.0 it is emitted once for every
+   * #HildonPannableArea::panning-started, whether the movement comes
+   * to rest or is interrupted.
    *
    * Since: 2.2
    */
@@ -644,6 +798,26 @@ hildon_pannable_area_class_init (HildonPannableAreaClass * class)
                   _hildon_marshal_VOID__VOID,
                   G_TYPE_NONE, 0);
 
+ /**
+   * HildonPannableArea::settled:
+   * @hildonpannable: the pannable area object that stopped moving
+   *
+   * This signal is emitted when @hildonpannable comes to rest after
+   * a hildon_pannable_area_scroll_to() animation, a kinetic movement
+   * or a bounce on its edges. It is not emitted when the movement is
+   * interrupted, for instance by a press or by a jump.
+   *
+   * Since: 3.0
+   */
+  pannable_area_signals[SETTLED] =
+    g_signal_new ("settled",
+                  G_TYPE_FROM_CLASS (object_class),
+                  0,
+                  0,
+                  NULL, NULL,
+                  _hildon_marshal_VOID__VOID,
+                  G_TYPE_NONE, 0);
+
 }
 
 static void
@@ -697,6 +871,7 @@ hildon_pannable_area_init (HildonPannableArea * area)
   priv->y_offset = 0;
   priv->center_on_child_focus_pending = FALSE;
   priv->selection_movement = FALSE;
+  priv->scroll_mode = HILDON_PANNABLE_AREA_SCROLL_EASE;
 
   priv->hadjust =
     GTK_ADJUSTMENT (gtk_adjustment_new (0.0, 0.0, 0.0, 0.0, 0.0, 0.0));
@@ -705,6 +880,23 @@ hildon_pannable_area_init (HildonPannableArea * area)
 
   g_object_ref_sink (G_OBJECT (priv->hadjust));
   g_object_ref_sink (G_OBJECT (priv->vadjust));
+
+  /* GtkScrolledWindow only pans touch screens, and with its own
+     physics. Pan with any pointer using ours */
+  gtk_scrolled_window_set_kinetic_scrolling (GTK_SCROLLED_WINDOW (area), FALSE);
+
+  priv->drag_gesture = gtk_gesture_drag_new (GTK_WIDGET (area));
+  gtk_gesture_single_set_touch_only (GTK_GESTURE_SINGLE (priv->drag_gesture), FALSE);
+  gtk_event_controller_set_propagation_phase (GTK_EVENT_CONTROLLER (priv->drag_gesture),
+                                              GTK_PHASE_CAPTURE);
+  g_signal_connect (priv->drag_gesture, "drag-begin",
+                    G_CALLBACK (hildon_pannable_area_drag_begin), area);
+  g_signal_connect (priv->drag_gesture, "drag-update",
+                    G_CALLBACK (hildon_pannable_area_drag_update), area);
+  g_signal_connect (priv->drag_gesture, "drag-end",
+                    G_CALLBACK (hildon_pannable_area_drag_end), area);
+  g_signal_connect (priv->drag_gesture, "cancel",
+                    G_CALLBACK (hildon_pannable_area_drag_cancel), area);
 }
 
 static void
@@ -799,6 +991,15 @@ hildon_pannable_area_get_property (GObject * object,
   case PROP_CENTER_ON_CHILD_FOCUS:
     g_value_set_boolean (value, priv->center_on_child_focus);
     break;
+  case PROP_SCROLL_MODE:
+    g_value_set_enum (value, priv->scroll_mode);
+    break;
+  case PROP_IS_PANNING:
+    g_value_set_boolean (value, priv->is_panning);
+    break;
+  case PROP_SCROLL_VELOCITY:
+    g_value_set_double (value, priv->scroll_velocity);
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
   }
@@ -825,6 +1026,10 @@ hildon_pannable_area_set_property (GObject * object,
     }
 
     priv->enabled = enabled;
+    gtk_event_controller_set_propagation_phase (GTK_EVENT_CONTROLLER (priv->drag_gesture),
+                                                enabled ? GTK_PHASE_CAPTURE : GTK_PHASE_NONE);
+    if (!enabled)
+      hildon_pannable_area_stop (HILDON_PANNABLE_AREA (object));
     break;
   case PROP_MODE:
     priv->mode = g_value_get_enum (value);
@@ -935,6 +1140,10 @@ hildon_pannable_area_set_property (GObject * object,
   case PROP_CENTER_ON_CHILD_FOCUS:
     priv->center_on_child_focus = g_value_get_boolean (value);
     break;
+  case PROP_SCROLL_MODE:
+    hildon_pannable_area_set_scroll_mode (HILDON_PANNABLE_AREA (object),
+                                          g_value_get_enum (value));
+    break;
 
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
@@ -949,6 +1158,15 @@ hildon_pannable_area_dispose (GObject * object)
 
   hildon_pannable_area_remove_timeouts (GTK_WIDGET (object));
 
+  g_clear_object (&priv->drag_gesture);
+
+  if (priv->deferred_id) {
+    g_source_remove (priv->deferred_id);
+    priv->deferred_id = 0;
+  }
+  g_queue_foreach (&priv->deferred, (GFunc) hildon_pannable_area_deferred_free, NULL);
+  g_queue_clear (&priv->deferred);
+
   if (child) {
     g_signal_handlers_disconnect_by_func (child,
                                           hildon_pannable_area_child_mapped,
@@ -1262,14 +1480,477 @@ ease_out_cubic (gdouble t)
   return p * p * p + 1;
 }
 
+static HildonPannableAreaDeferred *
+hildon_pannable_area_deferred_new (GtkWidget *widget,
+                                   GSourceFunc func,
+                                   gpointer data,
+                                   GDestroyNotify notify)
+{
+  HildonPannableAreaDeferred *deferred = g_slice_new (HildonPannableAreaDeferred);
+
+  deferred->widget = widget;
+  deferred->func = func;
+  deferred->data = data;
+  deferred->notify = notify;
+  deferred->destroy_id = 0;
+
+  return deferred;
+}
+
 static void
-hildon_pannable_area_on_frame_clock_update (GdkFrameClock *clock,
-                                            HildonPannableArea *area)
+hildon_pannable_area_deferred_free (HildonPannableAreaDeferred *deferred)
+{
+  if (deferred->destroy_id)
+    g_signal_handler_disconnect (deferred->widget, deferred->destroy_id);
+  if (deferred->notify)
+    deferred->notify (deferred->data);
+  g_slice_free (HildonPannableAreaDeferred, deferred);
+}
+
+static gboolean
+hildon_pannable_area_run_deferred (gpointer data)
 {
+  HildonPannableArea *area = HILDON_PANNABLE_AREA (data);
   HildonPannableAreaPrivate *priv = area->priv;
-  gint64 now;
+  guint n_calls;
+
+  priv->deferred_id = 0;
+
+  /* The calls can queue new ones, which wait for the next idle. They
+     can also destroy widgets, the area included, so every call is taken
+     out of the queue before it is run and the area is kept alive until
+     the loop is done */
+  g_object_ref (area);
+  n_calls = g_queue_get_length (&priv->deferred);
+
+  while (n_calls-- > 0 && !g_queue_is_empty (&priv->deferred) && !priv->is_panning) {
+    HildonPannableAreaDeferred *call = g_queue_pop_head (&priv->deferred);
+
+    g_signal_handler_disconnect (call->widget, call->destroy_id);
+    call->destroy_id = 0;
+
+    call->func (call->data);
+    hildon_pannable_area_deferred_free (call);
+  }
+
+  g_object_unref (area);
+
+  return FALSE;
+}
+
+/* Runs a call deferred outside of any area once, whatever it returns */
+static gboolean
+hildon_pannable_area_run_deferred_once (gpointer data)
+{
+  HildonPannableAreaDeferred *call = data;
+
+  call->func (call->data);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+hildon_pannable_area_queue_deferred (HildonPannableArea *area)
+{
+  HildonPannableAreaPrivate *priv = area->priv;
+
+  /* Let the last frame of the movement be drawn first */
+  if (!g_queue_is_empty (&priv->deferred) && priv->deferred_id == 0)
+    priv->deferred_id = gdk_threads_add_idle_full (G_PRIORITY_DEFAULT_IDLE,
+                                                   hildon_pannable_area_run_deferred,
+                                                   area, NULL);
+}
+
+static void
+hildon_pannable_area_stats_add_update (HildonPannableAreaPrivate *priv,
+                                       gint64 start)
+{
+  gint64 elapsed = g_get_monotonic_time () - start;
+
+  priv->stats.total_update_time += elapsed;
+  priv->stats.max_update_time = MAX (priv->stats.max_update_time, elapsed);
+  HILDON_PANNABLE_AREA_MARK (start, "update");
+}
+
+/* Counts the frame being drawn, if the area is moving */
+static void
+hildon_pannable_area_stats_add_frame (HildonPannableArea *area)
+{
+  HildonPannableAreaPrivate *priv = area->priv;
+  GdkFrameClock *clock;
+  gint64 frame_time, interval, refresh_interval;
+
+  clock = gtk_widget_get_frame_clock (GTK_WIDGET (area));
+  if (clock == NULL)
+    return;
+
+  frame_time = gdk_frame_clock_get_frame_time (clock);
+  if (frame_time == priv->stats_frame_time)
+    return;
+
+  /* The first frame of a movement has nothing to be compared with */
+  if (priv->stats_frame_time != 0) {
+    interval = frame_time - priv->stats_frame_time;
+
+    gdk_frame_clock_get_refresh_info (clock, frame_time, &refresh_interval, NULL);
+    if (refresh_interval <= 0)
+      refresh_interval = G_USEC_PER_SEC / 60;
+
+    priv->stats.n_frames++;
+    priv->stats.n_dropped_frames += MAX ((interval + refresh_interval / 2) / refresh_interval - 1, 0);
+    priv->stats.total_frame_interval += interval;
+    priv->stats.max_frame_interval = MAX (priv->stats.max_frame_interval, interval);
+    priv->stats.frame_intervals[MIN (interval / 1000, HILDON_PANNABLE_AREA_STATS_N_BUCKETS - 1)]++;
+  }
+
+  priv->stats_frame_time = frame_time;
+}
+
+static void
+hildon_pannable_area_set_scroll_velocity (HildonPannableArea *area,
+                                          gdouble hvel,
+                                          gdouble vvel)
+{
+  HildonPannableAreaPrivate *priv = area->priv;
+  gdouble velocity = sqrt (hvel * hvel + vvel * vvel);
+
+  if (priv->scroll_velocity == velocity)
+    return;
+
+  priv->scroll_velocity = velocity;
+  g_object_notify (G_OBJECT (area), "scroll-velocity");
+}
+
+/* Returns FALSE if a handler of panning-started refused the panning */
+static gboolean
+hildon_pannable_area_set_panning (HildonPannableArea *area,
+                                  gboolean panning)
+{
+  HildonPannableAreaPrivate *priv = area->priv;
+
+  if (priv->is_panning == panning)
+    return TRUE;
+
+  if (panning) {
+    gboolean refused = FALSE;
+
+    g_signal_emit (area, pannable_area_signals[PANNING_STARTED], 0, &refused);
+    if (refused)
+      return FALSE;
+
+    priv->is_panning = TRUE;
+    g_object_notify (G_OBJECT (area), "is-panning");
+  } else {
+    priv->is_panning = FALSE;
+    priv->stats_frame_time = 0;
+    hildon_pannable_area_set_scroll_velocity (area, 0, 0);
+    g_object_notify (G_OBJECT (area), "is-panning");
+    g_signal_emit (area, pannable_area_signals[PANNING_FINISHED], 0);
+    hildon_pannable_area_queue_deferred (area);
+  }
+
+  return TRUE;
+}
+
+/* Called when a movement comes to its end on its own */
+static void
+hildon_pannable_area_settle (HildonPannableArea *area)
+{
+  hildon_pannable_area_end_updating (area);
+  hildon_pannable_area_set_panning (area, FALSE);
+  g_signal_emit (area, pannable_area_signals[SETTLED], 0);
+}
+
+/* The physics properties are given per 'frame' of 1/sps seconds, as
+   they were when the widget was ticked by a timeout, so convert them
+   to the length of the frames of the frame clock */
+static gdouble
+hildon_pannable_area_get_sps (HildonPannableAreaPrivate *priv)
+{
+  return priv->sps > 0 ? priv->sps : DEFAULT_SPS;
+}
+
+static gdouble
+hildon_pannable_area_get_upper (GtkAdjustment *adj)
+{
+  return MAX (gtk_adjustment_get_lower (adj),
+              gtk_adjustment_get_upper (adj) - gtk_adjustment_get_page_size (adj));
+}
+
+/* Allocates the child moved by the overshoot. Moving the drawing
+   instead would leave behind the children with their own GdkWindow,
+   such as GtkViewport or GtkTreeView */
+static void
+hildon_pannable_area_allocate_child (HildonPannableArea *area)
+{
+  HildonPannableAreaPrivate *priv = area->priv;
+  GtkWidget *child = gtk_bin_get_child (GTK_BIN (area));
+  GtkAllocation allocation;
+
+  if (child == NULL || !gtk_widget_get_visible (child))
+    return;
+
+  allocation = priv->child_allocation;
+  allocation.x -= round (priv->haxis.overshoot);
+  allocation.y -= round (priv->vaxis.overshoot);
+  gtk_widget_size_allocate (child, &allocation);
+}
+
+static void
+hildon_pannable_area_overshoot_changed (HildonPannableArea *area)
+{
+  hildon_pannable_area_allocate_child (area);
+
+  /* For the part of the area the child left */
+  gtk_widget_queue_draw (GTK_WIDGET (area));
+}
+
+static void
+hildon_pannable_area_axis_start_bounce (HildonPannableAreaAxis *axis,
+                                        gint64 now)
+{
+  axis->vel = 0;
+  axis->bouncing = TRUE;
+  axis->bounce_from = axis->overshoot;
+  axis->bounce_start = now;
+}
+
+/* Moves the adjustment to @value, drawing what goes past its bounds as
+   overshoot. Dragging past the edge only moves the content half the
+   distance, like pulling a rubber band */
+static void
+hildon_pannable_area_axis_drag_to (HildonPannableAreaAxis *axis,
+                                   GtkAdjustment *adj,
+                                   gdouble value,
+                                   gint overshoot_max)
+{
+  gdouble lower = gtk_adjustment_get_lower (adj);
+  gdouble upper = hildon_pannable_area_get_upper (adj);
+  gdouble clamped = CLAMP (value, lower, upper);
+
+  axis->overshoot = CLAMP ((value - clamped) / 2, -overshoot_max, overshoot_max);
+  axis->bouncing = FALSE;
+
+  gtk_adjustment_set_value (adj, clamped);
+}
+
+/* Advances one axis @dt seconds. Returns whether it is still moving */
+static gboolean
+hildon_pannable_area_axis_step (HildonPannableArea *area,
+                                HildonPannableAreaAxis *axis,
+                                GtkAdjustment *adj,
+                                gint overshoot_max,
+                                gdouble dt,
+                                gint64 now)
+{
+  HildonPannableAreaPrivate *priv = area->priv;
+  gdouble sps = hildon_pannable_area_get_sps (priv);
+  gdouble vmin = priv->vmin * sps;
+  gdouble friction;
+  gdouble lower, upper, value;
+
+  if (axis->bouncing) {
+    gdouble bounce_time = priv->bounce_steps / sps * G_USEC_PER_SEC;
+    gdouble t = bounce_time > 0 ? (now - axis->bounce_start) / bounce_time : 1.0;
+
+    if (t >= 1.0) {
+      axis->overshoot = 0;
+      axis->bouncing = FALSE;
+      return FALSE;
+    }
+
+    axis->overshoot = axis->bounce_from * (1.0 - ease_out_cubic (t));
+    return TRUE;
+  }
+
+  if (axis->vel == 0 && axis->overshoot == 0)
+    return FALSE;
+
+  /* deceleration is the multiplier applied on each 1/sps frame */
+  friction = priv->low_friction_mode ? 1.0 : pow (priv->decel, dt * sps);
+
+  if (axis->overshoot != 0) {
+    gdouble vmax = priv->vmax_overshooting * sps;
+
+    /* Past the edge the content is also pulled back */
+    axis->vel = CLAMP (axis->vel * friction * friction, -vmax, vmax);
+    axis->overshoot += axis->vel * dt;
+
+    if (ABS (axis->overshoot) >= overshoot_max) {
+      axis->overshoot = axis->overshoot > 0 ? overshoot_max : -overshoot_max;
+      axis->vel = 0;
+    }
+
+    if (ABS (axis->vel) < vmin || (axis->vel > 0) != (axis->overshoot > 0))
+      hildon_pannable_area_axis_start_bounce (axis, now);
+
+    return TRUE;
+  }
+
+  axis->vel *= friction;
+  if (ABS (axis->vel) < vmin) {
+    axis->vel = 0;
+    return FALSE;
+  }
+
+  lower = gtk_adjustment_get_lower (adj);
+  upper = hildon_pannable_area_get_upper (adj);
+  value = gtk_adjustment_get_value (adj) + axis->vel * dt;
+
+  if (value < lower || value > upper) {
+    if (overshoot_max > 0 && !priv->low_friction_mode) {
+      axis->overshoot = CLAMP (value - CLAMP (value, lower, upper),
+                               -overshoot_max, overshoot_max);
+      axis->vel = CLAMP (axis->vel,
+                         -priv->vmax_overshooting * sps,
+                         priv->vmax_overshooting * sps);
+    } else {
+      /* Without overshooting the movement stops at the edges */
+      axis->vel = 0;
+    }
+    value = CLAMP (value, lower, upper);
+  }
+
+  gtk_adjustment_set_value (adj, value);
+
+  return axis->vel != 0 || axis->overshoot != 0;
+}
+
+static void
+hildon_pannable_area_kinetic_update (HildonPannableArea *area,
+                                     gint64 now)
+{
+  HildonPannableAreaPrivate *priv = area->priv;
+  GtkAdjustment *hadj;
+  GtkAdjustment *vadj;
+  gdouble old_hovershoot = priv->haxis.overshoot;
+  gdouble old_vovershoot = priv->vaxis.overshoot;
+  gboolean moving = FALSE;
+  gdouble dt;
+
+  hadj = gtk_scrolled_window_get_hadjustment (GTK_SCROLLED_WINDOW (area));
+  vadj = gtk_scrolled_window_get_vadjustment (GTK_SCROLLED_WINDOW (area));
+
+  /* Don't jump ahead after a stall of the frame clock */
+  dt = MIN (now - priv->last_frame_time, MAX_FRAME_INTERVAL) / (gdouble) G_USEC_PER_SEC;
+  priv->last_frame_time = now;
+
+  if (priv->mov_mode & HILDON_MOVEMENT_MODE_HORIZ)
+    moving |= hildon_pannable_area_axis_step (area, &priv->haxis, hadj,
+                                              priv->hovershoot_max, dt, now);
+  if (priv->mov_mode & HILDON_MOVEMENT_MODE_VERT)
+    moving |= hildon_pannable_area_axis_step (area, &priv->vaxis, vadj,
+                                              priv->vovershoot_max, dt, now);
+
+  if (old_hovershoot != priv->haxis.overshoot ||
+      old_vovershoot != priv->vaxis.overshoot)
+    hildon_pannable_area_overshoot_changed (area);
+
+  if (moving) {
+    hildon_pannable_area_set_scroll_velocity (area, priv->haxis.vel, priv->vaxis.vel);
+  } else {
+    priv->kinetic = FALSE;
+    hildon_pannable_area_settle (area);
+  }
+}
+
+/* Advances one axis of a critically damped spring @dt seconds,
+   using the exact solution so that long frames can't make it
+   unstable. Returns whether it is still moving */
+static gboolean
+hildon_pannable_area_axis_spring_step (HildonPannableAreaAxis *axis,
+                                       GtkAdjustment *adj,
+                                       gdouble omega,
+                                       gdouble dt)
+{
+  gdouble d;
+  gdouble b;
+  gdouble a;
+  gdouble decay;
+
+  /* The bounds may have changed since the target was set */
+  axis->target = CLAMP (axis->target, gtk_adjustment_get_lower (adj),
+                        hildon_pannable_area_get_upper (adj));
+
+  d = gtk_adjustment_get_value (adj) - axis->target;
+  b = axis->vel + omega * d;
+  a = d + b * dt;
+  decay = exp (-omega * dt);
+
+  d = a * decay;
+  axis->vel = (b - omega * a) * decay;
+
+  if (ABS (d) < SPRING_REST_DISTANCE && ABS (axis->vel) < SPRING_REST_VELOCITY) {
+    axis->vel = 0;
+    gtk_adjustment_set_value (adj, axis->target);
+    return FALSE;
+  }
+
+  gtk_adjustment_set_value (adj, axis->target + d);
+
+  return TRUE;
+}
+
+/* The time to settle grows with the log of the distance in pages,
+   from the duration of the ease animation up to scroll-time */
+static gdouble
+hildon_pannable_area_spring_omega (HildonPannableAreaPrivate *priv,
+                                   gdouble pages)
+{
+  gdouble time = priv->duration / 1000.0 * (1.0 + log2 (1.0 + pages));
+
+  if (priv->scroll_time > 0)
+    time = MIN (time, priv->scroll_time);
+
+  return SPRING_SETTLE_FACTOR / time;
+}
+
+static void
+hildon_pannable_area_spring_update (HildonPannableArea *area,
+                                    gint64 now)
+{
+  HildonPannableAreaPrivate *priv = area->priv;
+  GtkAdjustment *hadj;
+  GtkAdjustment *vadj;
+  gboolean moving = FALSE;
+  gdouble dt;
+
+  hadj = gtk_scrolled_window_get_hadjustment (GTK_SCROLLED_WINDOW (area));
+  vadj = gtk_scrolled_window_get_vadjustment (GTK_SCROLLED_WINDOW (area));
+
+  dt = MIN (now - priv->last_frame_time, MAX_FRAME_INTERVAL) / (gdouble) G_USEC_PER_SEC;
+  priv->last_frame_time = now;
+
+  moving |= hildon_pannable_area_axis_spring_step (&priv->haxis, hadj,
+                                                   priv->spring_omega, dt);
+  moving |= hildon_pannable_area_axis_spring_step (&priv->vaxis, vadj,
+                                                   priv->spring_omega, dt);
+
+  if (moving) {
+    hildon_pannable_area_set_scroll_velocity (area, priv->haxis.vel, priv->vaxis.vel);
+  } else {
+    priv->spring = FALSE;
+    hildon_pannable_area_settle (area);
+  }
+}
+
+static void
+hildon_pannable_area_update (HildonPannableArea *area,
+                             gint64 now)
+{
+  HildonPannableAreaPrivate *priv = area->priv;
+
+  if (priv->kinetic)
+    {
+      hildon_pannable_area_kinetic_update (area, now);
+      return;
+    }
 
-  now = gdk_frame_clock_get_frame_time (clock);
+  if (priv->spring)
+    {
+      hildon_pannable_area_spring_update (area, now);
+      return;
+    }
 
   GtkAdjustment *hadj;
   GtkAdjustment *vadj;
@@ -1279,21 +1960,345 @@ hildon_pannable_area_on_frame_clock_update (GdkFrameClock *clock,
 
   if (now < priv->end_time)
     {
-      gdouble t;
+
+      gdouble t, speed;
 
       t = (now - priv->start_time) / (gdouble) (priv->end_time - priv->start_time);
+      /* derivative of ease_out_cubic(), per second */
+      speed = 3 * (1 - t) * (1 - t) * G_USEC_PER_SEC / (priv->end_time - priv->start_time);
       t = ease_out_cubic (t);
       gtk_adjustment_set_value (hadj, priv->hsource + t * (priv->htarget - priv->hsource));
       gtk_adjustment_set_value (vadj, priv->vsource + t * (priv->vtarget - priv->vsource));
+      hildon_pannable_area_set_scroll_velocity (area,
+                                                speed * (priv->htarget - priv->hsource),
+                                                speed * (priv->vtarget - priv->vsource));
     }
   else
     {
       gtk_adjustment_set_value (hadj, priv->htarget);
       gtk_adjustment_set_value (vadj, priv->vtarget);
-      hildon_pannable_area_end_updating (area);
+      hildon_pannable_area_settle (area);
     }
 }
 
+static void
+hildon_pannable_area_on_frame_clock_update (GdkFrameClock *clock,
+                                            HildonPannableArea *area)
+{
+  HildonPannableAreaPrivate *priv = area->priv;
+  gint64 start;
+
+  start = g_get_monotonic_time ();
+  hildon_pannable_area_update (area, gdk_frame_clock_get_frame_time (clock));
+  hildon_pannable_area_stats_add_update (priv, start);
+}
+
+/* Stops any movement and drops the overshoot */
+static void
+hildon_pannable_area_stop (HildonPannableArea *area)
+{
+  HildonPannableAreaPrivate *priv = area->priv;
+  gboolean overshooting = priv->haxis.overshoot != 0 || priv->vaxis.overshoot != 0;
+
+  memset (&priv->haxis, 0, sizeof (HildonPannableAreaAxis));
+  memset (&priv->vaxis, 0, sizeof (HildonPannableAreaAxis));
+  if (overshooting)
+    hildon_pannable_area_overshoot_changed (area);
+  priv->kinetic = FALSE;
+  priv->spring = FALSE;
+  hildon_pannable_area_end_updating (area);
+  hildon_pannable_area_set_panning (area, FALSE);
+}
+
+static void
+hildon_pannable_area_start_kinetic (HildonPannableArea *area)
+{
+  HildonPannableAreaPrivate *priv = area->priv;
+
+  priv->clock = gtk_widget_get_frame_clock (GTK_WIDGET (area));
+  if (priv->clock == NULL) {
+    hildon_pannable_area_stop (area);
+    return;
+  }
+
+  /* A scroll_to() animation would fight the kinetic movement */
+  hildon_pannable_area_end_updating (area);
+  priv->spring = FALSE;
+
+  /* Already panning after a drag, but a press on an overshooting
+     area bounces it back without one. That can't be refused */
+  hildon_pannable_area_set_panning (area, TRUE);
+
+  priv->kinetic = TRUE;
+  priv->last_frame_time = gdk_frame_clock_get_frame_time (priv->clock);
+  hildon_pannable_area_begin_updating (area);
+}
+
+static void
+hildon_pannable_area_size_allocate (GtkWidget *widget,
+                                    GtkAllocation *allocation)
+{
+  HildonPannableArea *area = HILDON_PANNABLE_AREA (widget);
+  HildonPannableAreaPrivate *priv = area->priv;
+  GtkWidget *child;
+
+  GTK_WIDGET_CLASS (hildon_pannable_area_parent_class)->size_allocate (widget, allocation);
+
+  child = gtk_bin_get_child (GTK_BIN (area));
+  if (child == NULL || !gtk_widget_get_visible (child))
+    return;
+
+  gtk_widget_get_allocation (child, &priv->child_allocation);
+
+  if (priv->haxis.overshoot != 0 || priv->vaxis.overshoot != 0)
+    hildon_pannable_area_allocate_child (area);
+}
+
+static gboolean
+hildon_pannable_area_draw (GtkWidget *widget,
+                           cairo_t *cr)
+{
+  HildonPannableAreaPrivate *priv = HILDON_PANNABLE_AREA (widget)->priv;
+  gboolean result;
+  gint64 start = 0;
+
+  if (priv->is_panning) {
+    hildon_pannable_area_stats_add_frame (HILDON_PANNABLE_AREA (widget));
+    start = g_get_monotonic_time ();
+  }
+
+  if (priv->haxis.overshoot == 0 && priv->vaxis.overshoot == 0) {
+    result = GTK_WIDGET_CLASS (hildon_pannable_area_parent_class)->draw (widget, cr);
+  } else {
+    /* The child is allocated past the edge it overshot, keep it
+       from being drawn outside of the area */
+    cairo_save (cr);
+    cairo_rectangle (cr, 0, 0,
+                     gtk_widget_get_allocated_width (widget),
+                     gtk_widget_get_allocated_height (widget));
+    cairo_clip (cr);
+    result = GTK_WIDGET_CLASS (hildon_pannable_area_parent_class)->draw (widget, cr);
+    cairo_restore (cr);
+  }
+
+  if (start != 0) {
+    gint64 elapsed = g_get_monotonic_time () - start;
+
+    priv->stats.total_draw_time += elapsed;
+    priv->stats.max_draw_time = MAX (priv->stats.max_draw_time, elapsed);
+    HILDON_PANNABLE_AREA_MARK (start, "draw");
+  }
+
+  return result;
+}
+
+static gdouble
+hildon_pannable_area_blend_velocity (HildonPannableAreaPrivate *priv,
+                                     gdouble vel,
+                                     gdouble delta,
+                                     guint32 dt)
+{
+  /* drag_inertia is the weight of the last motion, the rest is kept
+     from the velocity measured before */
+  return priv->drag_inertia * (delta * 1000.0 / dt) + (1.0 - priv->drag_inertia) * vel;
+}
+
+static void
+hildon_pannable_area_drag_begin (GtkGestureDrag *gesture,
+                                 gdouble start_x,
+                                 gdouble start_y,
+                                 HildonPannableArea *area)
+{
+  HildonPannableAreaPrivate *priv = area->priv;
+  GtkAdjustment *hadj;
+  GtkAdjustment *vadj;
+  gdouble vfast;
+  gboolean fast;
+
+  hadj = gtk_scrolled_window_get_hadjustment (GTK_SCROLLED_WINDOW (area));
+  vadj = gtk_scrolled_window_get_vadjustment (GTK_SCROLLED_WINDOW (area));
+
+  /* Pressing while the area moves fast only stops it, children don't
+     get the press */
+  vfast = priv->vfast_factor * priv->vmax * hildon_pannable_area_get_sps (priv);
+  fast = priv->kinetic &&
+    (ABS (priv->haxis.vel) > vfast || ABS (priv->vaxis.vel) > vfast);
+
+  /* Keep the overshoot, so that the drag goes on from it */
+  priv->haxis.drag_start = gtk_adjustment_get_value (hadj) + 2 * priv->haxis.overshoot;
+  priv->vaxis.drag_start = gtk_adjustment_get_value (vadj) + 2 * priv->vaxis.overshoot;
+  priv->haxis.vel = 0;
+  priv->vaxis.vel = 0;
+  priv->haxis.bouncing = FALSE;
+  priv->vaxis.bouncing = FALSE;
+  priv->kinetic = FALSE;
+  priv->spring = FALSE;
+  hildon_pannable_area_end_updating (area);
+  /* Catching the area stops its movement */
+  hildon_pannable_area_set_panning (area, FALSE);
+
+  priv->dragging = FALSE;
+  priv->last_offset_x = 0;
+  priv->last_offset_y = 0;
+  priv->last_time = gtk_get_current_event_time ();
+  priv->last_press_time = priv->last_time;
+
+  if (fast)
+    gtk_gesture_set_state (GTK_GESTURE (gesture), GTK_EVENT_SEQUENCE_CLAIMED);
+}
+
+static void
+hildon_pannable_area_drag_update (GtkGestureDrag *gesture,
+                                  gdouble offset_x,
+                                  gdouble offset_y,
+                                  HildonPannableArea *area)
+{
+  HildonPannableAreaPrivate *priv = area->priv;
+  GtkAdjustment *hadj;
+  GtkAdjustment *vadj;
+  gdouble old_hovershoot;
+  gdouble old_vovershoot;
+  guint32 time;
+  gint64 start;
+
+  if (!(priv->mov_mode & HILDON_MOVEMENT_MODE_HORIZ))
+    offset_x = 0;
+  if (!(priv->mov_mode & HILDON_MOVEMENT_MODE_VERT))
+    offset_y = 0;
+
+  if (!priv->dragging) {
+    gdouble start_x, start_y;
+
+    if (ABS (offset_x) < priv->panning_threshold &&
+        ABS (offset_y) < priv->panning_threshold)
+      return;
+
+    if (!hildon_pannable_area_set_panning (area, TRUE)) {
+      gtk_gesture_set_state (GTK_GESTURE (gesture), GTK_EVENT_SEQUENCE_DENIED);
+      return;
+    }
+
+    priv->dragging = TRUE;
+    gtk_gesture_set_state (GTK_GESTURE (gesture), GTK_EVENT_SEQUENCE_CLAIMED);
+
+    gtk_gesture_drag_get_start_point (gesture, &start_x, &start_y);
+    if (ABS (offset_y) + priv->direction_error_margin >= ABS (offset_x))
+      g_signal_emit (area, pannable_area_signals[VERTICAL_MOVEMENT], 0,
+                     offset_y > 0 ? HILDON_MOVEMENT_UP : HILDON_MOVEMENT_DOWN,
+                     start_x, start_y);
+    if (ABS (offset_x) + priv->direction_error_margin >= ABS (offset_y))
+      g_signal_emit (area, pannable_area_signals[HORIZONTAL_MOVEMENT], 0,
+                     offset_x > 0 ? HILDON_MOVEMENT_LEFT : HILDON_MOVEMENT_RIGHT,
+                     start_x, start_y);
+  }
+
+  /* Sample the velocity of the pointer with the event timestamps */
+  time = gtk_get_current_event_time ();
+  if (time > priv->last_time) {
+    guint32 dt = time - priv->last_time;
+
+    priv->haxis.vel = hildon_pannable_area_blend_velocity (priv, priv->haxis.vel,
+                                                           priv->last_offset_x - offset_x, dt);
+    priv->vaxis.vel = hildon_pannable_area_blend_velocity (priv, priv->vaxis.vel,
+                                                           priv->last_offset_y - offset_y, dt);
+    priv->last_time = time;
+  }
+  priv->last_offset_x = offset_x;
+  priv->last_offset_y = offset_y;
+  hildon_pannable_area_set_scroll_velocity (area, priv->haxis.vel, priv->vaxis.vel);
+
+  hadj = gtk_scrolled_window_get_hadjustment (GTK_SCROLLED_WINDOW (area));
+  vadj = gtk_scrolled_window_get_vadjustment (GTK_SCROLLED_WINDOW (area));
+
+  old_hovershoot = priv->haxis.overshoot;
+  old_vovershoot = priv->vaxis.overshoot;
+
+  start = g_get_monotonic_time ();
+  if (priv->mov_mode & HILDON_MOVEMENT_MODE_HORIZ)
+    hildon_pannable_area_axis_drag_to (&priv->haxis, hadj,
+                                       priv->haxis.drag_start - offset_x,
+                                       priv->hovershoot_max);
+  if (priv->mov_mode & HILDON_MOVEMENT_MODE_VERT)
+    hildon_pannable_area_axis_drag_to (&priv->vaxis, vadj,
+                                       priv->vaxis.drag_start - offset_y,
+                                       priv->vovershoot_max);
+
+  /* The adjustments redraw the child, only the overshoot is ours */
+  if (old_hovershoot != priv->haxis.overshoot ||
+      old_vovershoot != priv->vaxis.overshoot)
+    hildon_pannable_area_overshoot_changed (area);
+  hildon_pannable_area_stats_add_update (priv, start);
+}
+
+static void
+hildon_pannable_area_launch_axis (HildonPannableArea *area,
+                                  HildonPannableAreaAxis *axis,
+                                  gboolean stopped)
+{
+  HildonPannableAreaPrivate *priv = area->priv;
+  gdouble sps = hildon_pannable_area_get_sps (priv);
+  gdouble vmax = priv->vmax * sps;
+
+  if (stopped || priv->mode == HILDON_PANNABLE_AREA_MODE_PUSH) {
+    axis->vel = 0;
+  } else {
+    axis->vel = CLAMP (axis->vel * priv->force / DEFAULT_FORCE, -vmax, vmax);
+    if (ABS (axis->vel) < priv->vmin * sps)
+      axis->vel = 0;
+  }
+
+  /* Released past the edge without moving away from it */
+  if (axis->overshoot != 0 && (axis->vel == 0 || (axis->vel > 0) != (axis->overshoot > 0)))
+    hildon_pannable_area_axis_start_bounce (axis, 0);
+}
+
+static void
+hildon_pannable_area_drag_end (GtkGestureDrag *gesture,
+                               gdouble offset_x,
+                               gdouble offset_y,
+                               HildonPannableArea *area)
+{
+  HildonPannableAreaPrivate *priv = area->priv;
+  gboolean stopped;
+  gint64 now;
+
+  if (!priv->dragging && priv->haxis.overshoot == 0 && priv->vaxis.overshoot == 0)
+    return;
+
+  priv->dragging = FALSE;
+
+  /* The finger rested before leaving the screen */
+  stopped = gtk_get_current_event_time () - priv->last_time > CURSOR_STOPPED_TIMEOUT;
+
+  hildon_pannable_area_launch_axis (area, &priv->haxis, stopped);
+  hildon_pannable_area_launch_axis (area, &priv->vaxis, stopped);
+
+  hildon_pannable_area_start_kinetic (area);
+
+  /* The bounces start with the first frame */
+  now = priv->last_frame_time;
+  if (priv->haxis.bouncing)
+    priv->haxis.bounce_start = now;
+  if (priv->vaxis.bouncing)
+    priv->vaxis.bounce_start = now;
+}
+
+static void
+hildon_pannable_area_drag_cancel (GtkGesture *gesture,
+                                  GdkEventSequence *sequence,
+                                  HildonPannableArea *area)
+{
+  HildonPannableAreaPrivate *priv = area->priv;
+
+  if (!priv->dragging && priv->haxis.overshoot == 0 && priv->vaxis.overshoot == 0)
+    return;
+
+  priv->dragging = FALSE;
+  hildon_pannable_area_launch_axis (area, &priv->haxis, TRUE);
+  hildon_pannable_area_launch_axis (area, &priv->vaxis, TRUE);
+  hildon_pannable_area_start_kinetic (area);
+}
+
 
 // WORKING ON THIS.  HANDLE -1 values
 static void hildon_pannable_area_set_value_internal (HildonPannableArea *area,
@@ -1302,6 +2307,9 @@ static void hildon_pannable_area_set_value_internal (HildonPannableArea *area,
                                          gboolean            animate)
 {
   HildonPannableAreaPrivate *priv = area->priv;
+  gboolean keep_htarget = (hvalue == -1);
+  gboolean keep_vtarget = (vvalue == -1);
+  gboolean spring;
 
   /* don't use CLAMP() so we don't end up below lower if upper - page_size
    * is smaller than lower
@@ -1330,8 +2338,59 @@ static void hildon_pannable_area_set_value_internal (HildonPannableArea *area,
     }
 
   area->priv->clock = gtk_widget_get_frame_clock (GTK_WIDGET (area));
-  
-  if (animate && priv->duration != 0 && priv->clock != NULL)
+
+  animate = animate && priv->duration != 0 && priv->clock != NULL;
+  spring = animate && priv->scroll_mode == HILDON_PANNABLE_AREA_SCROLL_SPRING &&
+    !priv->dragging;
+
+  /* A spring retargets the movement in progress, the other ways
+     replace it */
+  if (!spring && (priv->kinetic || priv->spring || priv->dragging))
+    hildon_pannable_area_stop (area);
+
+  /* Ask only once, if the panning is refused jump to the target */
+  if (animate && !hildon_pannable_area_set_panning (area, TRUE))
+    animate = spring = FALSE;
+
+  if (spring)
+    {
+      gdouble pages;
+
+      /* Retarget without stopping, a fling or a previous spring keeps
+         its velocity */
+      if (!priv->spring && !priv->kinetic)
+        {
+          priv->haxis.vel = 0;
+          priv->vaxis.vel = 0;
+          priv->last_frame_time = gdk_frame_clock_get_frame_time (priv->clock);
+        }
+
+      if (priv->haxis.overshoot != 0 || priv->vaxis.overshoot != 0)
+        {
+          priv->haxis.overshoot = priv->vaxis.overshoot = 0;
+          priv->haxis.bouncing = priv->vaxis.bouncing = FALSE;
+          hildon_pannable_area_overshoot_changed (area);
+        }
+
+      /* An ignored axis goes on to the target it already had */
+      if (!(priv->spring && keep_htarget))
+        priv->haxis.target = hvalue;
+      if (!(priv->spring && keep_vtarget))
+        priv->vaxis.target = vvalue;
+
+      pages = MAX (ABS (priv->haxis.target - gtk_adjustment_get_value (hadj)) /
+                   MAX (gtk_adjustment_get_page_size (hadj), 1.0),
+                   ABS (priv->vaxis.target - gtk_adjustment_get_value (vadj)) /
+                   MAX (gtk_adjustment_get_page_size (vadj), 1.0));
+      priv->spring_omega = hildon_pannable_area_spring_omega (priv, pages);
+
+      priv->kinetic = FALSE;
+      priv->spring = TRUE;
+      hildon_pannable_area_begin_updating (area);
+      return;
+    }
+
+  if (animate)
     {
       if (priv->tick_id && priv->htarget == hvalue && priv->vtarget == vvalue)
         return;
@@ -1349,6 +2408,7 @@ static void hildon_pannable_area_set_value_internal (HildonPannableArea *area,
       hildon_pannable_area_end_updating (area);
       gtk_adjustment_set_value (vadj, vvalue);
       gtk_adjustment_set_value (hadj, hvalue);
+      hildon_pannable_area_set_panning (area, FALSE);
     }
 }
 
@@ -1775,3 +2835,247 @@ hildon_pannable_area_set_center_on_child_focus  (HildonPannableArea *area,
 
   area->priv->center_on_child_focus = value;
 }
+
+/**
+ * hildon_pannable_area_get_scroll_mode:
+ * @area: A #HildonPannableArea
+ *
+ * Gets the @area #HildonPannableArea:scroll-mode property value.
+ *
+ * Returns: the animation used to scroll @area to a position
+ *
+ * Since: 3.0
+ **/
+HildonPannableAreaScrollMode
+hildon_pannable_area_get_scroll_mode            (HildonPannableArea *area)
+{
+  g_return_val_if_fail (HILDON_IS_PANNABLE_AREA (area), HILDON_PANNABLE_AREA_SCROLL_EASE);
+
+  return area->priv->scroll_mode;
+}
+
+/**
+ * hildon_pannable_area_set_scroll_mode:
+ * @area: A #HildonPannableArea
+ * @mode: the animation used to scroll to a position
+ *
+ * Sets the @area #HildonPannableArea:scroll-mode property to @mode.
+ * A scroll in progress goes on with the animation it started with.
+ *
+ * Since: 3.0
+ **/
+void
+hildon_pannable_area_set_scroll_mode            (HildonPannableArea *area,
+                                                 HildonPannableAreaScrollMode mode)
+{
+  g_return_if_fail (HILDON_IS_PANNABLE_AREA (area));
+
+  if (area->priv->scroll_mode == mode)
+    return;
+
+  area->priv->scroll_mode = mode;
+
+  g_object_notify (G_OBJECT (area), "scroll-mode");
+}
+
+/**
+ * hildon_pannable_area_get_is_panning:
+ * @area: A #HildonPannableArea
+ *
+ * Returns whether @area is moving, see #HildonPannableArea:is-panning.
+ *
+ * Returns: %TRUE if @area is being dragged or is scrolling on its own
+ *
+ * Since: 3.0
+ **/
+gboolean
+hildon_pannable_area_get_is_panning             (HildonPannableArea *area)
+{
+  g_return_val_if_fail (HILDON_IS_PANNABLE_AREA (area), FALSE);
+
+  return area->priv->is_panning;
+}
+
+/**
+ * hildon_pannable_area_get_scroll_velocity:
+ * @area: A #HildonPannableArea
+ *
+ * Returns the current speed of @area, see
+ * #HildonPannableArea:scroll-velocity.
+ *
+ * Returns: the speed of the scroll in pixels per second
+ *
+ * Since: 3.0
+ **/
+gdouble
+hildon_pannable_area_get_scroll_velocity        (HildonPannableArea *area)
+{
+  g_return_val_if_fail (HILDON_IS_PANNABLE_AREA (area), 0);
+
+  return area->priv->scroll_velocity;
+}
+
+static void
+hildon_pannable_area_deferred_widget_destroyed (GtkWidget *widget,
+                                                HildonPannableArea *area)
+{
+  HildonPannableAreaPrivate *priv = area->priv;
+  GList *iter, *next;
+
+  for (iter = priv->deferred.head; iter; iter = next) {
+    HildonPannableAreaDeferred *deferred = iter->data;
+
+    next = iter->next;
+    if (deferred->widget == widget) {
+      g_queue_delete_link (&priv->deferred, iter);
+      hildon_pannable_area_deferred_free (deferred);
+    }
+  }
+}
+
+/**
+ * hildon_pannable_area_defer_until_settled:
+ * @widget: A #GtkWidget inside a #HildonPannableArea
+ * @func: the function to call
+ * @data: data to pass to @func
+ * @notify: (allow-none): function to call on @data when it is no longer needed
+ *
+ * Calls @func once the #HildonPannableArea containing @widget stops
+ * moving. This is meant for work that is too expensive to be done
+ * while the area scrolls, like loading thumbnails or updating the
+ * rows that have come into view: doing it between two frames of the
+ * movement would make it stutter.
+ *
+ * If the area is not moving, or if @widget is not inside a
+ * #HildonPannableArea, @func is called from an idle handler. Queuing
+ * the same @func and @data for @widget again before it is called has
+ * no effect, and @notify is not called for the duplicate. If @widget
+ * is destroyed first, @func is not called but @notify is. The return
+ * value of @func is ignored.
+ *
+ * Since: 3.0
+ **/
+void
+hildon_pannable_area_defer_until_settled        (GtkWidget      *widget,
+                                                 GSourceFunc     func,
+                                                 gpointer        data,
+                                                 GDestroyNotify  notify)
+{
+  HildonPannableAreaPrivate *priv;
+  HildonPannableAreaDeferred *deferred;
+  GtkWidget *area;
+  GList *iter;
+
+  g_return_if_fail (GTK_IS_WIDGET (widget));
+  g_return_if_fail (func != NULL);
+
+  area = gtk_widget_get_ancestor (widget, HILDON_TYPE_PANNABLE_AREA);
+  if (area == NULL) {
+    deferred = hildon_pannable_area_deferred_new (widget, func, data, notify);
+    gdk_threads_add_idle_full (G_PRIORITY_DEFAULT_IDLE,
+                               hildon_pannable_area_run_deferred_once,
+                               deferred,
+                               (GDestroyNotify) hildon_pannable_area_deferred_free);
+    return;
+  }
+
+  priv = HILDON_PANNABLE_AREA (area)->priv;
+
+  for (iter = priv->deferred.head; iter; iter = iter->next) {
+    HildonPannableAreaDeferred *queued = iter->data;
+
+    if (queued->widget == widget && queued->func == func && queued->data == data)
+      return;
+  }
+
+  deferred = hildon_pannable_area_deferred_new (widget, func, data, notify);
+  deferred->destroy_id =
+    g_signal_connect (widget, "destroy",
+                      G_CALLBACK (hildon_pannable_area_deferred_widget_destroyed),
+                      area);
+
+  g_queue_push_tail (&priv->deferred, deferred);
+
+  if (!priv->is_panning)
+    hildon_pannable_area_queue_deferred (HILDON_PANNABLE_AREA (area));
+}
+
+/**
+ * hildon_pannable_area_get_stats:
+ * @area: A #HildonPannableArea
+ * @stats: (out caller-allocates): the location to store the timings
+ *
+ * Copies the timings of the movements of @area since it was created
+ * or since the last call to hildon_pannable_area_reset_stats(). They
+ * only cover the frames drawn while @area was panning, see
+ * #HildonPannableArea:is-panning, and can be used to tell whether
+ * the panning is smooth.
+ *
+ * When the library is built with sysprof support, the adjustment
+ * updates and the draws are also marked in sysprof captures.
+ *
+ * Since: 3.0
+ **/
+void
+hildon_pannable_area_get_stats                  (HildonPannableArea *area,
+                                                 HildonPannableAreaStats *stats)
+{
+  g_return_if_fail (HILDON_IS_PANNABLE_AREA (area));
+  g_return_if_fail (stats != NULL);
+
+  *stats = area->priv->stats;
+}
+
+/**
+ * hildon_pannable_area_reset_stats:
+ * @area: A #HildonPannableArea
+ *
+ * Clears the timings returned by hildon_pannable_area_get_stats().
+ *
+ * Since: 3.0
+ **/
+void
+hildon_pannable_area_reset_stats                (HildonPannableArea *area)
+{
+  g_return_if_fail (HILDON_IS_PANNABLE_AREA (area));
+
+  memset (&area->priv->stats, 0, sizeof (HildonPannableAreaStats));
+}
+
+/**
+ * hildon_pannable_area_stats_get_frame_interval_percentile:
+ * @stats: timings returned by hildon_pannable_area_get_stats()
+ * @percentile: a percentile, between 0 and 100
+ *
+ * Finds the interval between frames that @percentile percent of the
+ * frames of @stats did not exceed, rounded up to the millisecond.
+ * For instance, at 60 frames per second a 99th percentile above
+ * 17 ms means that more than one frame in a hundred came late.
+ *
+ * Returns: the interval in microseconds, or 0 if @stats has no frames
+ *
+ * Since: 3.0
+ **/
+gint64
+hildon_pannable_area_stats_get_frame_interval_percentile (const HildonPannableAreaStats *stats,
+                                                          gdouble percentile)
+{
+  guint rank, count = 0;
+  gint i;
+
+  g_return_val_if_fail (stats != NULL, 0);
+
+  if (stats->n_frames == 0)
+    return 0;
+
+  rank = ceil (CLAMP (percentile, 0, 100) / 100 * stats->n_frames);
+  rank = MAX (rank, 1);
+
+  for (i = 0; i < HILDON_PANNABLE_AREA_STATS_N_BUCKETS - 1; i++) {
+    count += stats->frame_intervals[i];
+    if (count >= rank)
+      return (i + 1) * 1000;
+  }
+
+  return stats->max_frame_interval;
+}
@@ -64,6 +64,23 @@ typedef enum {
   HILDON_PANNABLE_AREA_MODE_AUTO
 } HildonPannableAreaMode;
 
+/**
+ * HildonPannableAreaScrollMode:
+ * @HILDON_PANNABLE_AREA_SCROLL_EASE: Scroll to the new position in a
+ * fixed time, starting again when the position changes
+ * @HILDON_PANNABLE_AREA_SCROLL_SPRING: Follow the position with a
+ * critically damped spring, keeping the current velocity when the
+ * position changes
+ *
+ * Used to choose the animation of hildon_pannable_area_scroll_to()
+ *
+ * Since: 3.0
+ */
+typedef enum {
+  HILDON_PANNABLE_AREA_SCROLL_EASE,
+  HILDON_PANNABLE_AREA_SCROLL_SPRING
+} HildonPannableAreaScrollMode;
+
 /**
  * HildonMovementMode:
  * @HILDON_MOVEMENT_MODE_HORIZ:
@@ -117,6 +134,52 @@ typedef enum {
 } HildonSizeRequestPolicy;
 #endif
 
+/**
+ * HILDON_PANNABLE_AREA_STATS_N_BUCKETS:
+ *
+ * The number of buckets of the frame interval histogram of
+ * #HildonPannableAreaStats.
+ *
+ * Since: 3.0
+ */
+#define                                         HILDON_PANNABLE_AREA_STATS_N_BUCKETS 64
+
+/**
+ * HildonPannableAreaStats:
+ * @n_frames: the number of frames drawn while the area was moving,
+ * not counting the first frame of each movement
+ * @n_dropped_frames: the number of refresh cycles missed between
+ * those frames
+ * @total_frame_interval: the sum of the intervals between the frames,
+ * in microseconds
+ * @max_frame_interval: the longest interval between two frames, in
+ * microseconds
+ * @total_update_time: the time spent updating the adjustments of the
+ * area, including the handlers of their signals, in microseconds
+ * @max_update_time: the longest of those updates, in microseconds
+ * @total_draw_time: the time spent drawing the area and its children
+ * while it was moving, in microseconds
+ * @max_draw_time: the longest of those draws, in microseconds
+ * @frame_intervals: a histogram of the intervals between frames, by
+ * milliseconds; the last bucket counts all the longer intervals
+ *
+ * Timings of the movements of a #HildonPannableArea, as returned by
+ * hildon_pannable_area_get_stats().
+ *
+ * Since: 3.0
+ */
+typedef struct {
+  guint  n_frames;
+  guint  n_dropped_frames;
+  gint64 total_frame_interval;
+  gint64 max_frame_interval;
+  gint64 total_update_time;
+  gint64 max_update_time;
+  gint64 total_draw_time;
+  gint64 max_draw_time;
+  guint  frame_intervals[HILDON_PANNABLE_AREA_STATS_N_BUCKETS];
+} HildonPannableAreaStats;
+
 /**
  * HildonPannableArea:
  *
@@ -174,6 +237,20 @@ GtkAdjustment* hildon_pannable_area_get_vadjustment (HildonPannableArea *area);
 gboolean hildon_pannable_area_get_center_on_child_focus (HildonPannableArea *area);
 void hildon_pannable_area_set_center_on_child_focus (HildonPannableArea *area,
                                                      gboolean value);
+HildonPannableAreaScrollMode hildon_pannable_area_get_scroll_mode (HildonPannableArea *area);
+void hildon_pannable_area_set_scroll_mode       (HildonPannableArea *area,
+                                                 HildonPannableAreaScrollMode mode);
+gboolean hildon_pannable_area_get_is_panning   (HildonPannableArea *area);
+gdouble hildon_pannable_area_get_scroll_velocity (HildonPannableArea *area);
+void hildon_pannable_area_defer_until_settled   (GtkWidget *widget,
+                                                 GSourceFunc func,
+                                                 gpointer data,
+                                                 GDestroyNotify notify);
+void hildon_pannable_area_get_stats            (HildonPannableArea *area,
+                                                 HildonPannableAreaStats *stats);
+void hildon_pannable_area_reset_stats          (HildonPannableArea *area);
+gint64 hildon_pannable_area_stats_get_frame_interval_percentile (const HildonPannableAreaStats *stats,
+                                                                 gdouble percentile);
 
 G_END_DECLS
 
@@ -33,13 +33,30 @@ G_BEGIN_DECLS
 
 typedef struct                                  _HildonRemoteTexturePrivate HildonRemoteTexturePrivate;
 
+typedef struct                                  _HildonRemoteTextureBuffer HildonRemoteTextureBuffer;
+
 #define                                         HILDON_REMOTE_TEXTURE_GET_PRIVATE(obj) \
                                                 (G_TYPE_INSTANCE_GET_PRIVATE ((obj), \
                                                 HILDON_TYPE_REMOTE_TEXTURE, HildonRemoteTexturePrivate));
 
+/* A shared memory segment of hildon_remote_texture_alloc_buffers() */
+struct                                          _HildonRemoteTextureBuffer
+{
+    key_t   key;
+    int     shmid;
+    guchar *data;
+
+    cairo_surface_t *surface;
+
+    /* Whether hildon-desktop was sent all of it */
+    gboolean shown;
+};
+
 struct                                          _HildonRemoteTexturePrivate
 {
     guint   ready : 1;
+    guint   flushing : 1;
+    guint   frame_sync : 1;
 
     guint   set_shm : 1;
     guint   set_damage : 1;
@@ -54,10 +71,7 @@ struct                                          _HildonRemoteTexturePrivate
     guint   shm_height;
     guint   shm_bpp;
 
-    gint    damage_x1;
-    gint    damage_y1;
-    gint    damage_x2;
-    gint    damage_y2;
+    cairo_region_t *damage;
 
     guint   show;
     guint   opacity;
@@ -73,10 +87,20 @@ struct                                          _HildonRemoteTexturePrivate
     double  scale_x;
     double  scale_y;
 
+    HildonRemoteTextureBuffer *buffers;
+    guint   n_buffers;
+    guint   back_buffer;
+    guint   buffer_width;
+    guint   buffer_height;
+
     GtkWindow* parent;
     gulong  parent_map_event_cb_id;
 
     gulong  map_event_cb_id;
+
+    guint   freeze_count;
+    guint   flush_tick_id;
+    guint   messages_sent;
 };
 
 G_END_DECLS
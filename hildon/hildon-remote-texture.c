@@ -30,14 +30,35 @@
  * The #HildonRemoteTexture is a GTK+ widget which allows the rendering of
  * a shared memory area within hildon-desktop. It allows the memory area to
  * be positioned and scaled, without altering its' contents.
+ *
+ * The memory area can either be created by the application and passed
+ * with hildon_remote_texture_set_image(), or be allocated by the
+ * remote texture with hildon_remote_texture_alloc_buffers(). In the
+ * latter case, the application draws into the cairo surface returned
+ * by hildon_remote_texture_get_buffer() and shows it with
+ * hildon_remote_texture_swap_buffers(). With two or three buffers,
+ * the application draws into an area other than the one shown.
+ *
+ * hildon-desktop doesn't tell when it is done reading an area, so
+ * swapping buffers doesn't wait for it. If hildon-desktop is still
+ * reading the previous area when the application starts drawing into
+ * it again, the frame it shows can be torn. A third buffer gives
+ * hildon-desktop one more frame to finish reading, but doesn't
+ * guarantee that it did.
  */
 
+#include                                        <errno.h>
+#include                                        <sys/ipc.h>
+#include                                        <sys/shm.h>
 #include                                        <gdk/gdkx.h>
 #include                                        <X11/Xatom.h>
 
 #include                                        "hildon-remote-texture.h"
 #include                                        "hildon-remote-texture-private.h"
 
+/* Damage made of more rectangles than this is sent as its bounding box */
+#define MAX_DAMAGE_RECTANGLES 16
+
 G_DEFINE_TYPE (HildonRemoteTexture, hildon_remote_texture, GTK_TYPE_WINDOW);
 
 static GdkFilterReturn
@@ -48,6 +69,8 @@ static void
 hildon_remote_texture_update_ready (HildonRemoteTexture *self);
 static void
 hildon_remote_texture_send_pending_messages (HildonRemoteTexture *self);
+static gboolean
+hildon_remote_texture_may_send (HildonRemoteTexture *self);
 static void
 hildon_remote_texture_send_all_messages (HildonRemoteTexture *self);
 static gboolean
@@ -175,6 +198,10 @@ hildon_remote_texture_finalize                (GObject *object)
     HildonRemoteTexturePrivate
                        *priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
 
+    hildon_remote_texture_free_buffers (self);
+
+    cairo_region_destroy (priv->damage);
+
     if (priv->parent)
     {
         if (priv->parent_map_event_cb_id)
@@ -212,6 +239,8 @@ hildon_remote_texture_init                    (HildonRemoteTexture *self)
     priv->scale_x = 1;
     priv->scale_y = 1;
     priv->opacity = 0xff;
+
+    priv->damage = cairo_region_create ();
 }
 
 /**
@@ -338,12 +367,64 @@ hildon_remote_texture_update_ready (HildonRemoteTexture *self)
     hildon_remote_texture_send_pending_messages (self);
 }
 
+static void
+hildon_remote_texture_clamp_damage (HildonRemoteTexture *self)
+{
+    HildonRemoteTexturePrivate
+	               *priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
+    cairo_rectangle_int_t extents;
+
+    /* Every rectangle is a message of its own, so past a point the
+     * round trips cost more than uploading the tiles in between */
+    if (cairo_region_num_rectangles (priv->damage) <= MAX_DAMAGE_RECTANGLES)
+        return;
+
+    cairo_region_get_extents (priv->damage, &extents);
+    cairo_region_destroy (priv->damage);
+    priv->damage = cairo_region_create_rectangle (&extents);
+}
+
+static void
+hildon_remote_texture_send_damage (HildonRemoteTexture *self)
+{
+    HildonRemoteTexturePrivate
+	               *priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
+    cairo_rectangle_int_t rect;
+    int                 i, n;
+
+    if (!hildon_remote_texture_may_send (self))
+        return;
+
+    /* Defer messages until the remote texture is parented
+     * and the parent window is mapped */
+    if (!priv->parent || !gtk_widget_get_mapped (GTK_WIDGET (priv->parent)))
+        return;
+
+    n = cairo_region_num_rectangles (priv->damage);
+    for (i = 0; i < n; i++)
+    {
+        cairo_region_get_rectangle (priv->damage, i, &rect);
+        hildon_remote_texture_send_message (self,
+                                            damage_atom,
+                                            rect.x, rect.y,
+                                            rect.width, rect.height,
+                                            0);
+    }
+
+    cairo_region_destroy (priv->damage);
+    priv->damage = cairo_region_create ();
+    priv->set_damage = 0;
+}
+
 static void
 hildon_remote_texture_send_pending_messages (HildonRemoteTexture *self)
 {
     HildonRemoteTexturePrivate
 	               *priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
 
+    /* Let the setters send right away, whatever the update mode */
+    priv->flushing = 1;
+
     if (priv->set_shm)
       hildon_remote_texture_set_image(self,
                                       priv->shm_key,
@@ -351,11 +432,7 @@ hildon_remote_texture_send_pending_messages (HildonRemoteTexture *self)
                                       priv->shm_bpp);
 
     if (priv->set_damage)
-      hildon_remote_texture_update_area (self,
-                                         priv->damage_x1,
-                                         priv->damage_y1,
-                                         priv->damage_x2 - priv->damage_x1,
-                                         priv->damage_y2 - priv->damage_y1);
+      hildon_remote_texture_send_damage (self);
 
     if (priv->set_position)
 	hildon_remote_texture_set_position (self,
@@ -381,6 +458,8 @@ hildon_remote_texture_send_pending_messages (HildonRemoteTexture *self)
     if (priv->set_show)
 	hildon_remote_texture_set_show_full (self,
 					      priv->show, priv->opacity);
+
+    priv->flushing = 0;
 }
 
 static void
@@ -399,6 +478,56 @@ hildon_remote_texture_send_all_messages (HildonRemoteTexture *self)
     hildon_remote_texture_send_pending_messages (self);
 }
 
+static gboolean
+hildon_remote_texture_flush_tick (GtkWidget *widget,
+                                  GdkFrameClock *frame_clock,
+                                  gpointer user_data)
+{
+    HildonRemoteTexture *self = HILDON_REMOTE_TEXTURE (widget);
+    HildonRemoteTexturePrivate
+	               *priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
+
+    priv->flush_tick_id = 0;
+    hildon_remote_texture_send_pending_messages (self);
+
+    return G_SOURCE_REMOVE;
+}
+
+/*
+ * Whether a setter may send its message right away. Outside of
+ * hildon_remote_texture_send_pending_messages(), updates are
+ * held back while frozen, and until the next frame when synchronized
+ * to the frame clock.
+ */
+static gboolean
+hildon_remote_texture_may_send (HildonRemoteTexture *self)
+{
+    HildonRemoteTexturePrivate
+	               *priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
+    GtkWidget          *widget = GTK_WIDGET (self);
+
+    if (!gtk_widget_get_mapped (widget) || !priv->ready)
+        return FALSE;
+
+    if (priv->flushing)
+        return TRUE;
+
+    if (priv->freeze_count > 0)
+        return FALSE;
+
+    if (priv->frame_sync)
+    {
+        if (!priv->flush_tick_id)
+            priv->flush_tick_id =
+                gtk_widget_add_tick_callback (widget,
+                                              hildon_remote_texture_flush_tick,
+                                              NULL, NULL);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
 /* ------------------------------------------------------------- */
 
 /**
@@ -429,6 +558,8 @@ hildon_remote_texture_send_message (HildonRemoteTexture *self,
                                      guint32 l3,
                                      guint32 l4)
 {
+    HildonRemoteTexturePrivate
+	               *priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
     GtkWidget          *widget = GTK_WIDGET (self);
     Display            *display = GDK_WINDOW_XDISPLAY (gtk_widget_get_window (widget));
     Window              window = GDK_WINDOW_XID (gtk_widget_get_window (widget));
@@ -452,6 +583,8 @@ hildon_remote_texture_send_message (HildonRemoteTexture *self,
              window);
 #endif
 
+    priv->messages_sent++;
+
     XSendEvent (display, window, True,
                 StructureNotifyMask,
                 (XEvent *)&event);
@@ -478,7 +611,6 @@ hildon_remote_texture_set_image (HildonRemoteTexture *self,
 {
   HildonRemoteTexturePrivate
                        *priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
-  GtkWidget          *widget = GTK_WIDGET (self);
 
   priv->set_shm = 1;
   priv->shm_key = key;
@@ -486,7 +618,7 @@ hildon_remote_texture_set_image (HildonRemoteTexture *self,
   priv->shm_height = height;
   priv->shm_bpp = bpp;
 
-  if (gtk_widget_get_mapped (widget) && priv->ready)
+  if (hildon_remote_texture_may_send (self))
     {
        /* Defer messages until the remote texture is parented
         * and the parent window is mapped */
@@ -515,6 +647,9 @@ hildon_remote_texture_set_image (HildonRemoteTexture *self,
  * has changed. This will trigger a redraw and will update the relevant tiles
  * of the texture.
  *
+ * Areas signalled while the remote texture cannot send messages are sent
+ * as separate rectangles once it can, see hildon_remote_texture_update_region().
+ *
  * Since: 2.2
  */
 void
@@ -526,43 +661,46 @@ hildon_remote_texture_update_area (HildonRemoteTexture *self,
 {
   HildonRemoteTexturePrivate
                      *priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
-  GtkWidget          *widget = GTK_WIDGET (self);
+  cairo_rectangle_int_t rect = { x, y, width, height };
 
-  if (priv->damage_x1==priv->damage_x2 || priv->damage_y1==priv->damage_y2)
-    {
-      priv->damage_x1 = x;
-      priv->damage_y1 = y;
-      priv->damage_x2 = x+width;
-      priv->damage_y2 = y+height;
-    }
-  else
-    {
-      if (x<priv->damage_x1) priv->damage_x1 = x;
-      if (y<priv->damage_y1) priv->damage_y1 = y;
-      if (x+width>priv->damage_x2) priv->damage_x2 = x+width;
-      if (y+height>priv->damage_y2) priv->damage_y2 = y+height;
-    }
+  cairo_region_union_rectangle (priv->damage, &rect);
+  hildon_remote_texture_clamp_damage (self);
   priv->set_damage = 1;
 
-  if (gtk_widget_get_mapped (widget) && priv->ready)
-  {
-     /* Defer messages until the remote texture is parented
-      * and the parent window is mapped */
-      if (!priv->parent || !gtk_widget_get_mapped (GTK_WIDGET (priv->parent)))
-          return;
-      hildon_remote_texture_send_message (self,
-                                          damage_atom,
-                                          priv->damage_x1,
-                                          priv->damage_y1,
-                                          priv->damage_x2 - priv->damage_x1,
-                                          priv->damage_y2 - priv->damage_y1,
-                                          0);
-      priv->set_damage = 0;
-      priv->damage_x1 = 0;
-      priv->damage_y1 = 0;
-      priv->damage_x2 = 0;
-      priv->damage_y2 = 0;
-  }
+  hildon_remote_texture_send_damage (self);
+}
+
+/**
+ * hildon_remote_texture_update_region:
+ * @self: A #HildonRemoteTexture
+ * @region: the damaged area in pixels
+ *
+ * Like hildon_remote_texture_update_area(), but for an area made of
+ * several rectangles. hildon-desktop only updates the tiles covered by
+ * the rectangles of @region, rather than the ones covered by its
+ * bounding box. A region made of many rectangles is sent as its
+ * bounding box.
+ *
+ * Since: 3.0
+ */
+void
+hildon_remote_texture_update_region (HildonRemoteTexture *self,
+                                     const cairo_region_t *region)
+{
+  HildonRemoteTexturePrivate
+                     *priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
+
+  g_return_if_fail (HILDON_IS_REMOTE_TEXTURE (self));
+  g_return_if_fail (region != NULL);
+
+  if (cairo_region_is_empty (region))
+      return;
+
+  cairo_region_union (priv->damage, region);
+  hildon_remote_texture_clamp_damage (self);
+  priv->set_damage = 1;
+
+  hildon_remote_texture_send_damage (self);
 }
 
 /**
@@ -596,7 +734,6 @@ hildon_remote_texture_set_show_full (HildonRemoteTexture *self,
 {
     HildonRemoteTexturePrivate
 	               *priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
-    GtkWidget          *widget = GTK_WIDGET (self);
 
     if (opacity > 255)
 	opacity = 255;
@@ -608,7 +745,7 @@ hildon_remote_texture_set_show_full (HildonRemoteTexture *self,
     priv->opacity = opacity;
     priv->set_show = 1;
 
-    if (gtk_widget_get_mapped (widget) && priv->ready)
+    if (hildon_remote_texture_may_send (self))
     {
 	/* Defer show messages until the remote texture is parented
 	 * and the parent window is mapped */
@@ -695,7 +832,6 @@ hildon_remote_texture_set_position (HildonRemoteTexture *self,
 {
     HildonRemoteTexturePrivate
                        *priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
-    GtkWidget          *widget = GTK_WIDGET (self);
 
     priv->x = x;
     priv->y = y;
@@ -703,7 +839,7 @@ hildon_remote_texture_set_position (HildonRemoteTexture *self,
     priv->height = height;
     priv->set_position = 1;
 
-    if (gtk_widget_get_mapped (widget) && priv->ready)
+    if (hildon_remote_texture_may_send (self))
     {
         /* Defer messages until the remote texture is parented
          * and the parent window is mapped */
@@ -741,13 +877,12 @@ hildon_remote_texture_set_offset (HildonRemoteTexture *self,
 {
     HildonRemoteTexturePrivate
 	               *priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
-    GtkWidget          *widget = GTK_WIDGET (self);
 
     priv->offset_x = x;
     priv->offset_y = y;
     priv->set_offset = 1;
 
-    if (gtk_widget_get_mapped (widget) && priv->ready)
+    if (hildon_remote_texture_may_send (self))
     {
         /* Defer messages until the remote texture is parented
          * and the parent window is mapped */
@@ -777,13 +912,12 @@ hildon_remote_texture_set_scale (HildonRemoteTexture *self,
 {
     HildonRemoteTexturePrivate
 	               *priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
-    GtkWidget          *widget = GTK_WIDGET (self);
 
     priv->scale_x = x_scale;
     priv->scale_y = y_scale;
     priv->set_scale = 1;
 
-    if (gtk_widget_get_mapped (widget) && priv->ready)
+    if (hildon_remote_texture_may_send (self))
     {
         /* Defer messages until the remote texture is parented
          * and the parent window is mapped */
@@ -874,7 +1008,6 @@ hildon_remote_texture_set_parent (HildonRemoteTexture *self,
 {
     HildonRemoteTexturePrivate
 	               *priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
-    GtkWidget          *widget = GTK_WIDGET (self);
 
     gtk_window_set_transient_for (GTK_WINDOW (self), parent);
 
@@ -915,7 +1048,7 @@ hildon_remote_texture_set_parent (HildonRemoteTexture *self,
 	}
     }
 
-    if (gtk_widget_get_mapped (widget) && priv->ready)
+    if (hildon_remote_texture_may_send (self))
     {
 	Window win = 0;
 
@@ -961,3 +1094,352 @@ hildon_remote_texture_set_parent (HildonRemoteTexture *self,
     }
 }
 
+/**
+ * hildon_remote_texture_alloc_buffers:
+ * @self: A #HildonRemoteTexture
+ * @width: width of the buffers in pixels
+ * @height: height of the buffers in pixels
+ * @n_buffers: number of buffers, usually 2 or 3
+ *
+ * Allocates @n_buffers shared memory areas of @width x @height pixels
+ * for the remote texture, replacing the ones allocated before. The
+ * application draws into the one returned by
+ * hildon_remote_texture_get_buffer() and shows it with
+ * hildon_remote_texture_swap_buffers().
+ *
+ * With a single buffer, hildon-desktop may read the area while it is
+ * being drawn. With two, the application draws into one while the
+ * other is shown, and a third one leaves hildon-desktop a frame to
+ * finish reading the previous one. Nothing waits for hildon-desktop
+ * to be done reading though, see the description of
+ * #HildonRemoteTexture.
+ *
+ * The areas are only accessible to the user running the application.
+ *
+ * The pixels are in the #CAIRO_FORMAT_ARGB32 format, 4 bytes per
+ * pixel, without padding between the rows.
+ *
+ * Returns: %TRUE if the buffers could be allocated.
+ *
+ * Since: 3.0
+ **/
+gboolean
+hildon_remote_texture_alloc_buffers (HildonRemoteTexture *self,
+                                     guint width,
+                                     guint height,
+                                     guint n_buffers)
+{
+    HildonRemoteTexturePrivate
+                       *priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
+    gsize               size = (gsize) width * height * 4;
+    guint               i;
+
+    g_return_val_if_fail (HILDON_IS_REMOTE_TEXTURE (self), FALSE);
+    g_return_val_if_fail (width > 0 && height > 0, FALSE);
+    g_return_val_if_fail (n_buffers > 0, FALSE);
+
+    hildon_remote_texture_free_buffers (self);
+
+    priv->buffers = g_new0 (HildonRemoteTextureBuffer, n_buffers);
+    priv->buffer_width = width;
+    priv->buffer_height = height;
+
+    for (i = 0; i < n_buffers; i++)
+    {
+        HildonRemoteTextureBuffer *buffer = &priv->buffers[i];
+
+        /* hildon-desktop finds the area by its key, so it needs one
+         * that is not used yet rather than IPC_PRIVATE */
+        do
+        {
+            buffer->key = (key_t) g_random_int_range (1, G_MAXINT32);
+            buffer->shmid = shmget (buffer->key, size, IPC_CREAT | IPC_EXCL | 0600);
+        }
+        while (buffer->shmid < 0 && errno == EEXIST);
+
+        if (buffer->shmid < 0)
+        {
+            g_warning ("Could not allocate a remote texture buffer: %s",
+                       g_strerror (errno));
+            break;
+        }
+
+        priv->n_buffers++;
+
+        buffer->data = shmat (buffer->shmid, NULL, 0);
+        if (buffer->data == (guchar *) -1)
+        {
+            g_warning ("Could not attach a remote texture buffer: %s",
+                       g_strerror (errno));
+            buffer->data = NULL;
+            break;
+        }
+
+        buffer->surface = cairo_image_surface_create_for_data (buffer->data,
+                                                               CAIRO_FORMAT_ARGB32,
+                                                               width, height,
+                                                               width * 4);
+    }
+
+    if (priv->n_buffers < n_buffers || priv->buffers[n_buffers - 1].data == NULL)
+    {
+        hildon_remote_texture_free_buffers (self);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+/**
+ * hildon_remote_texture_free_buffers:
+ * @self: A #HildonRemoteTexture
+ *
+ * Frees the buffers allocated by hildon_remote_texture_alloc_buffers().
+ * The surfaces returned by hildon_remote_texture_get_buffer() must not
+ * be used anymore.
+ *
+ * Since: 3.0
+ **/
+void
+hildon_remote_texture_free_buffers (HildonRemoteTexture *self)
+{
+    HildonRemoteTexturePrivate
+                       *priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
+    guint               i;
+
+    g_return_if_fail (HILDON_IS_REMOTE_TEXTURE (self));
+
+    for (i = 0; i < priv->n_buffers; i++)
+    {
+        HildonRemoteTextureBuffer *buffer = &priv->buffers[i];
+
+        if (buffer->surface)
+        {
+            cairo_surface_finish (buffer->surface);
+            cairo_surface_destroy (buffer->surface);
+        }
+
+        if (buffer->data)
+            shmdt (buffer->data);
+
+        /* The area stays around while hildon-desktop has it attached */
+        shmctl (buffer->shmid, IPC_RMID, NULL);
+    }
+
+    g_free (priv->buffers);
+    priv->buffers = NULL;
+    priv->n_buffers = 0;
+    priv->back_buffer = 0;
+}
+
+/**
+ * hildon_remote_texture_get_buffer:
+ * @self: A #HildonRemoteTexture
+ *
+ * Returns the buffer to draw the next frame into. Its contents are the
+ * ones of the frame shown as many swaps ago as there are buffers.
+ *
+ * Returns: (transfer none): a #CAIRO_FORMAT_ARGB32 image surface, or
+ * %NULL if no buffers were allocated with
+ * hildon_remote_texture_alloc_buffers().
+ *
+ * Since: 3.0
+ **/
+cairo_surface_t *
+hildon_remote_texture_get_buffer (HildonRemoteTexture *self)
+{
+    HildonRemoteTexturePrivate
+                       *priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
+
+    g_return_val_if_fail (HILDON_IS_REMOTE_TEXTURE (self), NULL);
+
+    if (priv->n_buffers == 0)
+        return NULL;
+
+    return priv->buffers[priv->back_buffer].surface;
+}
+
+/* Whether the area set is one of the buffers */
+static gboolean
+hildon_remote_texture_showing_buffer (HildonRemoteTexture *self)
+{
+    HildonRemoteTexturePrivate
+                       *priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
+    guint               i;
+
+    if (priv->shm_width != priv->buffer_width ||
+        priv->shm_height != priv->buffer_height)
+        return FALSE;
+
+    for (i = 0; i < priv->n_buffers; i++)
+        if (priv->buffers[i].key == priv->shm_key)
+            return TRUE;
+
+    return FALSE;
+}
+
+/**
+ * hildon_remote_texture_swap_buffers:
+ * @self: A #HildonRemoteTexture
+ * @damage: (allow-none): the area drawn since the last swap, or %NULL
+ * for all of it
+ *
+ * Shows the buffer returned by hildon_remote_texture_get_buffer(), and
+ * makes the next one the buffer to draw into.
+ *
+ * hildon-desktop is only told about a new memory area when the buffer
+ * shown changes, so with a single buffer this just signals @damage as
+ * hildon_remote_texture_update_area() does. All of the buffer is
+ * updated the first time it is shown, and only @damage afterwards, so
+ * the buffer must hold the whole frame.
+ *
+ * Since: 3.0
+ **/
+void
+hildon_remote_texture_swap_buffers (HildonRemoteTexture *self,
+                                    const cairo_rectangle_int_t *damage)
+{
+    HildonRemoteTexturePrivate
+                       *priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
+    HildonRemoteTextureBuffer *buffer;
+
+    g_return_if_fail (HILDON_IS_REMOTE_TEXTURE (self));
+    g_return_if_fail (priv->n_buffers > 0);
+
+    buffer = &priv->buffers[priv->back_buffer];
+    cairo_surface_flush (buffer->surface);
+
+    /* hildon-desktop already has the rest of the frame unless the area
+     * is new to it, or it was showing an area set by the application */
+    if (!buffer->shown || !hildon_remote_texture_showing_buffer (self))
+        damage = NULL;
+
+    if (priv->shm_key != buffer->key ||
+        priv->shm_width != priv->buffer_width ||
+        priv->shm_height != priv->buffer_height)
+    {
+        hildon_remote_texture_set_image (self, buffer->key,
+                                         priv->buffer_width,
+                                         priv->buffer_height, 4);
+    }
+
+    if (damage)
+        hildon_remote_texture_update_area (self,
+                                           damage->x, damage->y,
+                                           damage->width, damage->height);
+    else
+        hildon_remote_texture_update_area (self, 0, 0,
+                                           priv->buffer_width,
+                                           priv->buffer_height);
+
+    buffer->shown = TRUE;
+    priv->back_buffer = (priv->back_buffer + 1) % priv->n_buffers;
+}
+
+/**
+ * hildon_remote_texture_freeze_updates:
+ * @self: A #HildonRemoteTexture
+ *
+ * Holds back the messages of the remote texture setters until
+ * hildon_remote_texture_thaw_updates() is called, so that properties changed
+ * several times in between are only sent once. Calls nest, and the
+ * messages are sent when the last freeze is thawed.
+ *
+ * Since: 3.0
+ **/
+void
+hildon_remote_texture_freeze_updates (HildonRemoteTexture *self)
+{
+    HildonRemoteTexturePrivate
+	               *priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
+
+    g_return_if_fail (HILDON_IS_REMOTE_TEXTURE (self));
+
+    priv->freeze_count++;
+}
+
+/**
+ * hildon_remote_texture_thaw_updates:
+ * @self: A #HildonRemoteTexture
+ *
+ * Reverts the effect of a previous call to
+ * hildon_remote_texture_freeze_updates(), sending the properties changed
+ * in between once the last freeze is thawed.
+ *
+ * Since: 3.0
+ **/
+void
+hildon_remote_texture_thaw_updates (HildonRemoteTexture *self)
+{
+    HildonRemoteTexturePrivate
+	               *priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
+
+    g_return_if_fail (HILDON_IS_REMOTE_TEXTURE (self));
+    g_return_if_fail (priv->freeze_count > 0);
+
+    if (--priv->freeze_count == 0 &&
+        gtk_widget_get_mapped (GTK_WIDGET (self)) && priv->ready)
+        hildon_remote_texture_send_pending_messages (self);
+}
+
+/**
+ * hildon_remote_texture_set_frame_sync:
+ * @self: A #HildonRemoteTexture
+ * @frame_sync: whether to send the messages once per frame
+ *
+ * When @frame_sync is %TRUE, the remote texture setters only record the
+ * new values, and the properties changed during a frame are sent once
+ * from the frame clock of the remote texture window. An animation updating
+ * several properties of many actors on every frame then sends a
+ * message per changed property and frame, rather than one per call.
+ *
+ * Since: 3.0
+ **/
+void
+hildon_remote_texture_set_frame_sync (HildonRemoteTexture *self,
+                                      gboolean frame_sync)
+{
+    HildonRemoteTexturePrivate
+	               *priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
+
+    g_return_if_fail (HILDON_IS_REMOTE_TEXTURE (self));
+
+    frame_sync = frame_sync ? 1 : 0;
+    if (priv->frame_sync == frame_sync)
+        return;
+
+    priv->frame_sync = frame_sync;
+
+    if (!frame_sync && priv->flush_tick_id)
+    {
+        gtk_widget_remove_tick_callback (GTK_WIDGET (self),
+                                         priv->flush_tick_id);
+        priv->flush_tick_id = 0;
+
+        if (priv->freeze_count == 0)
+            hildon_remote_texture_send_pending_messages (self);
+    }
+}
+
+/**
+ * hildon_remote_texture_get_messages_sent:
+ * @self: A #HildonRemoteTexture
+ *
+ * Returns the number of messages sent to the window manager for
+ * @self so far. Comparing it between frames tells how many
+ * messages a frame costs.
+ *
+ * Returns: the number of messages sent.
+ *
+ * Since: 3.0
+ **/
+guint
+hildon_remote_texture_get_messages_sent (HildonRemoteTexture *self)
+{
+    HildonRemoteTexturePrivate
+	               *priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
+
+    g_return_val_if_fail (HILDON_IS_REMOTE_TEXTURE (self), 0);
+
+    return priv->messages_sent;
+}
@@ -131,6 +131,33 @@ void
 hildon_remote_texture_set_parent (HildonRemoteTexture *self,
 				   GtkWindow *parent);
 
+void
+hildon_remote_texture_update_region (HildonRemoteTexture *self,
+                                     const cairo_region_t *region);
+
+gboolean
+hildon_remote_texture_alloc_buffers (HildonRemoteTexture *self,
+                                     guint width,
+                                     guint height,
+                                     guint n_buffers);
+void
+hildon_remote_texture_free_buffers (HildonRemoteTexture *self);
+cairo_surface_t *
+hildon_remote_texture_get_buffer (HildonRemoteTexture *self);
+void
+hildon_remote_texture_swap_buffers (HildonRemoteTexture *self,
+                                    const cairo_rectangle_int_t *damage);
+
+void
+hildon_remote_texture_freeze_updates (HildonRemoteTexture *self);
+void
+hildon_remote_texture_thaw_updates (HildonRemoteTexture *self);
+void
+hildon_remote_texture_set_frame_sync (HildonRemoteTexture *self,
+                                      gboolean frame_sync);
+guint
+hildon_remote_texture_get_messages_sent (HildonRemoteTexture *self);
+
 G_END_DECLS
 
 #endif                                 /* __HILDON_REMOTE_TEXTURE_H__ */
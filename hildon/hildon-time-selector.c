@@ -370,11 +370,12 @@ _custom_print_func (HildonTouchSelector * touch_selector,
 }
 
 static GtkTreeModel *
-_create_minutes_model (guint minutes_step)
+_build_minutes_model (gpointer data)
 {
+  guint minutes_step = GPOINTER_TO_UINT (data);
   GtkListStore *store_minutes = NULL;
   gint i = 0;
-  static gchar label[255];
+  gchar label[255];
   struct tm tm = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
   GtkTreeIter iter;
 
@@ -392,13 +393,31 @@ _create_minutes_model (guint minutes_step)
 }
 
 static GtkTreeModel *
-_create_hours_model (HildonTimeSelector * selector)
+_create_minutes_model (guint minutes_step)
+{
+  GtkTreeModel *model;
+  gchar *name;
+  gchar *key;
+
+  name = g_strdup_printf ("minutes:%u", minutes_step);
+  key = hildon_touch_selector_shared_model_key (name, _("wdgt_va_minutes"));
+  model = hildon_touch_selector_get_shared_model (key, _build_minutes_model,
+                                                  GUINT_TO_POINTER (minutes_step));
+  g_free (key);
+  g_free (name);
+
+  return model;
+}
+
+static GtkTreeModel *
+_build_hours_model (gpointer data)
 {
+  gboolean ampm_format = GPOINTER_TO_INT (data);
   GtkListStore *store_hours = NULL;
   gint i = 0;
   GtkTreeIter iter;
   struct tm tm = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
-  static gchar label[255];
+  gchar label[255];
   static gint range_12h[12] = {12, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11};
   static gint range_24h[24] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,
                                12,13,14,15,16,17,18,19,20,21,22,23};
@@ -406,7 +425,7 @@ _create_hours_model (HildonTimeSelector * selector)
   gint num_elements = 0;
   gchar *format_string = NULL;
 
-  if (selector->priv->ampm_format) {
+  if (ampm_format) {
     range = range_12h;
     num_elements = 12;
     format_string = N_("wdgt_va_12h_hours");
@@ -430,29 +449,57 @@ _create_hours_model (HildonTimeSelector * selector)
 }
 
 static GtkTreeModel *
-_create_ampm_model (HildonTimeSelector * selector)
+_create_hours_model (HildonTimeSelector * selector)
+{
+  GtkTreeModel *model;
+  gchar *key;
+
+  if (selector->priv->ampm_format)
+    key = hildon_touch_selector_shared_model_key ("hours:12", _("wdgt_va_12h_hours"));
+  else
+    key = hildon_touch_selector_shared_model_key ("hours:24", _("wdgt_va_24h_hours"));
+
+  model = hildon_touch_selector_get_shared_model (key, _build_hours_model,
+                                                  GINT_TO_POINTER (selector->priv->ampm_format));
+  g_free (key);
+
+  return model;
+}
+
+static GtkTreeModel *
+_build_ampm_model (gpointer data)
 {
   GtkListStore *store_ampm = NULL;
   GtkTreeIter iter;
-  static gchar label[255];
 
   store_ampm = gtk_list_store_new (2, G_TYPE_STRING, G_TYPE_INT);
 
-  snprintf (label, 255, _("wdgt_va_am"));
   gtk_list_store_append (store_ampm, &iter);
   gtk_list_store_set (store_ampm, &iter,
-                      COLUMN_STRING, label,
+                      COLUMN_STRING, _("wdgt_va_am"),
                       COLUMN_INT, 0, -1);
 
-  snprintf (label, 255, _("wdgt_va_pm"));
   gtk_list_store_append (store_ampm, &iter);
   gtk_list_store_set (store_ampm, &iter,
-                      COLUMN_STRING, label,
+                      COLUMN_STRING, _("wdgt_va_pm"),
                       COLUMN_INT, 1, -1);
 
   return GTK_TREE_MODEL (store_ampm);
 }
 
+static GtkTreeModel *
+_create_ampm_model (HildonTimeSelector * selector)
+{
+  GtkTreeModel *model;
+  gchar *name;
+
+  name = g_strdup_printf ("ampm:%s:%s", _("wdgt_va_am"), _("wdgt_va_pm"));
+  model = hildon_touch_selector_get_shared_model (name, _build_ampm_model, NULL);
+  g_free (name);
+
+  return model;
+}
+
 static void
 _get_real_time (gint * hours, gint * minutes)
 {
@@ -31,6 +31,19 @@ hildon_touch_selector_block_changed             (HildonTouchSelector *selector);
 void G_GNUC_INTERNAL
 hildon_touch_selector_unblock_changed           (HildonTouchSelector *selector);
 
+typedef GtkTreeModel * (*HildonTouchSelectorModelFunc) (gpointer data);
+
+/* Returns the key of a shared model of labels made with @format */
+gchar * G_GNUC_INTERNAL
+hildon_touch_selector_shared_model_key          (const gchar                  *name,
+                                                 const gchar                  *format);
+
+/* Returns a new GtkTreeModelFilter over the shared model */
+GtkTreeModel * G_GNUC_INTERNAL
+hildon_touch_selector_get_shared_model          (const gchar                  *key,
+                                                 HildonTouchSelectorModelFunc  create_func,
+                                                 gpointer                      data);
+
 G_END_DECLS
 
 #endif
@@ -172,6 +172,7 @@
 
 #include <string.h>
 #include <stdlib.h>
+#include <locale.h>
 #include <glib.h>
 
 #include "hildon-gtk.h"
@@ -211,6 +212,9 @@ struct _HildonTouchSelectorColumnPrivate
   GtkWidget *panarea;           /* the pannable widget */
   GtkWidget *vbox;
   GtkTreeRowReference *last_activated;
+
+  GPtrArray *norm_cache;        /* normalized text-column strings, by row */
+  guint norm_cache_idle_id;     /* builds norm_cache before the first search */
 };
 
 struct _HildonTouchSelectorPrivate
@@ -228,6 +232,8 @@ struct _HildonTouchSelectorPrivate
   GDestroyNotify print_destroy_func;
 
   HildonUIMode hildon_ui_mode;
+
+  gboolean fixed_row_height;    /* whether rows are measured only once */
 };
 
 enum
@@ -235,7 +241,8 @@ enum
   PROP_HAS_MULTIPLE_SELECTION = 1,
   PROP_INITIAL_SCROLL,
   PROP_HILDON_UI_MODE,
-  PROP_LIVE_SEARCH
+  PROP_LIVE_SEARCH,
+  PROP_FIXED_ROW_HEIGHT
 };
 
 enum
@@ -295,6 +302,12 @@ static void
 on_row_deleted                                 (GtkTreeModel *model,
                                                 GtkTreePath *path,
                                                 gpointer userdata);
+static void
+hildon_touch_selector_column_connect_norm_cache (HildonTouchSelectorColumn *column);
+static void
+hildon_touch_selector_column_build_norm_cache  (HildonTouchSelectorColumn *column);
+static void
+hildon_touch_selector_column_free_norm_cache   (HildonTouchSelectorColumn *column);
 
 static void
 hildon_touch_selector_scroll_to (HildonTouchSelectorColumn *column,
@@ -467,6 +480,27 @@ hildon_touch_selector_class_init (HildonTouchSelectorClass * class)
                                                          TRUE,
                                                          G_PARAM_READWRITE | G_PARAM_CONSTRUCT));
 
+  /**
+   * HildonTouchSelector:fixed-row-height:
+   *
+   * Whether all the rows of the columns of the selector have the same
+   * height. When set, only the first row of a column is measured and
+   * only the rows in view are rendered, so showing a column does not
+   * get slower as its model grows. The width of the columns is then
+   * given by the allocation of the selector instead of by its rows.
+   *
+   * Since: 3.0
+   */
+  g_object_class_install_property (gobject_class,
+                                   PROP_FIXED_ROW_HEIGHT,
+                                   g_param_spec_boolean ("fixed-row-height",
+                                                         "Fixed row height",
+                                                         "Whether all the rows of "
+                                                         "the columns have the same "
+                                                         "height",
+                                                         FALSE,
+                                                         G_PARAM_READWRITE));
+
   /* style properties */
   /* We need to ensure fremantle mode for the treeview in order to work
      properly. This is not about the appearance, this is about behaviour */
@@ -500,6 +534,9 @@ hildon_touch_selector_get_property (GObject * object,
     g_value_set_boolean (value,
                          hildon_touch_selector_get_live_search (HILDON_TOUCH_SELECTOR (object)));
     break;
+  case PROP_FIXED_ROW_HEIGHT:
+    g_value_set_boolean (value, priv->fixed_row_height);
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
     break;
@@ -524,6 +561,10 @@ hildon_touch_selector_set_property (GObject *object, guint prop_id,
     hildon_touch_selector_set_live_search (HILDON_TOUCH_SELECTOR (object),
                                            g_value_get_boolean (value));
     break;
+  case PROP_FIXED_ROW_HEIGHT:
+    hildon_touch_selector_set_fixed_row_height (HILDON_TOUCH_SELECTOR (object),
+                                                g_value_get_boolean (value));
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
     break;
@@ -551,6 +592,7 @@ hildon_touch_selector_init (HildonTouchSelector * selector)
   selector->priv->changed_blocked = FALSE;
 
   selector->priv->hildon_ui_mode = HILDON_UI_MODE_EDIT;
+  selector->priv->fixed_row_height = FALSE;
 
   gtk_box_pack_end (GTK_BOX (selector), selector->priv->hbox,
                     TRUE, TRUE, 0);
@@ -586,6 +628,8 @@ clean_column                                    (HildonTouchSelectorColumn *col,
                                         on_row_changed, selector);
   g_signal_handlers_disconnect_by_func (col->priv->model,
                                         on_row_deleted, selector);
+  g_signal_handlers_disconnect_by_data (col->priv->model, col);
+  hildon_touch_selector_column_free_norm_cache (col);
 
   if (col->priv->last_activated != NULL) {
     gtk_tree_row_reference_free (col->priv->last_activated);
@@ -650,6 +694,61 @@ hildon_touch_selector_unblock_changed           (HildonTouchSelector *selector)
   selector->priv->changed_blocked = FALSE;
 }
 
+/* Models that never change once created, shared between all the
+   selectors using the same key. The table only holds weak references:
+   a model is dropped when the last selector using it goes away.
+
+   hildon_touch_selector_get_model() gives the models of the columns to
+   applications, so each caller gets a filter of its own over the shared
+   model: a list store changed through one selector would change all the
+   others. */
+static GHashTable *shared_models = NULL;
+
+/* The labels depend on the locale and on the translated format, so
+   both are part of the key of the shared models */
+gchar *
+hildon_touch_selector_shared_model_key          (const gchar *name,
+                                                 const gchar *format)
+{
+  return g_strdup_printf ("%s:%s:%s", name, setlocale (LC_TIME, NULL), format);
+}
+
+static void
+on_shared_model_finalized                       (gpointer  key,
+                                                 GObject  *model)
+{
+  g_hash_table_remove (shared_models, key);
+}
+
+GtkTreeModel *
+hildon_touch_selector_get_shared_model          (const gchar                  *key,
+                                                 HildonTouchSelectorModelFunc  create_func,
+                                                 gpointer                      data)
+{
+  GtkTreeModel *model;
+  GtkTreeModel *filter;
+  gchar *model_key;
+
+  if (shared_models == NULL)
+    shared_models = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+
+  model = g_hash_table_lookup (shared_models, key);
+  if (model != NULL) {
+    filter = gtk_tree_model_filter_new (model, NULL);
+  } else {
+    model = create_func (data);
+    model_key = g_strdup (key);
+    g_hash_table_insert (shared_models, model_key, model);
+    g_object_weak_ref (G_OBJECT (model), on_shared_model_finalized, model_key);
+
+    /* The filter holds the only reference */
+    filter = gtk_tree_model_filter_new (model, NULL);
+    g_object_unref (model);
+  }
+
+  return filter;
+}
+
 static void
 hildon_touch_selector_emit_value_changed        (HildonTouchSelector *selector,
                                                  gint column)
@@ -830,6 +929,28 @@ _row_tapped_cb (GtkTreeView * tree_view, GtkTreePath * path, gpointer user_data)
 }
 
 
+/* In fixed height mode the tree view takes the height of the first
+   row for every row, creates its nodes without measuring them and
+   only renders the rows that are in view */
+static void
+_set_tree_view_fixed_row_height (GtkTreeView *tv,
+                                 gboolean fixed)
+{
+  GtkTreeViewColumn *view_column;
+
+  view_column = gtk_tree_view_get_column (tv, 0);
+
+  if (fixed) {
+    gtk_tree_view_column_set_sizing (view_column, GTK_TREE_VIEW_COLUMN_FIXED);
+    gtk_tree_view_column_set_expand (view_column, TRUE);
+    gtk_tree_view_set_fixed_height_mode (tv, TRUE);
+  } else {
+    gtk_tree_view_set_fixed_height_mode (tv, FALSE);
+    gtk_tree_view_column_set_expand (view_column, FALSE);
+    gtk_tree_view_column_set_sizing (view_column, GTK_TREE_VIEW_COLUMN_GROW_ONLY);
+  }
+}
+
 static HildonTouchSelectorColumn *
 _create_new_column (HildonTouchSelector * selector,
                     GtkTreeModel * model,
@@ -871,6 +992,20 @@ _create_new_column (HildonTouchSelector * selector,
     gtk_widget_set_can_focus (GTK_WIDGET (tv), FALSE);
   }
 
+  new_column = g_object_new (HILDON_TYPE_TOUCH_SELECTOR_COLUMN, NULL);
+  new_column->priv->parent = selector;
+  new_column->priv->model = g_object_ref (model);
+
+  /* The cache must be updated before the filter looks at new rows,
+     so connect to the model before the filter does */
+  hildon_touch_selector_column_connect_norm_cache (new_column);
+
+  /* The mode must be set before the model, so that the rows are never
+     measured one by one */
+  gtk_tree_view_append_column (GTK_TREE_VIEW (tv), tree_column);
+  if (selector->priv->fixed_row_height)
+    _set_tree_view_fixed_row_height (tv, TRUE);
+
   filter = gtk_tree_model_filter_new (model, NULL);
   gtk_tree_view_set_model (tv, filter);
   g_signal_connect (model, "row-changed",
@@ -879,16 +1014,10 @@ _create_new_column (HildonTouchSelector * selector,
                           G_CALLBACK (on_row_deleted), selector);
   gtk_tree_view_set_rules_hint (tv, TRUE);
 
-  gtk_tree_view_append_column (GTK_TREE_VIEW (tv), tree_column);
-
-  new_column = g_object_new (HILDON_TYPE_TOUCH_SELECTOR_COLUMN, NULL);
-  new_column->priv->parent = selector;
-
   panarea = hildon_pannable_area_new ();
 
   gtk_container_add (GTK_CONTAINER (panarea), GTK_WIDGET (tv));
 
-  new_column->priv->model = g_object_ref (model);
   new_column->priv->tree_view = tv;
   new_column->priv->panarea = panarea;
   new_column->priv->filter = filter;
@@ -985,6 +1114,215 @@ hildon_touch_selector_column_init (HildonTouchSelectorColumn *column)
   column->priv->last_activated = NULL;
   column->priv->realize_handler = 0;
   column->priv->initial_path = NULL;
+  column->priv->norm_cache = NULL;
+  column->priv->norm_cache_idle_id = 0;
+}
+
+/*
+ * IMPLEMENTATION NOTES:
+ * Normalizing a string (see hildon_helper_normalize_string()) is far
+ * too expensive to be done for every row on every keystroke of the
+ * live search. The normalized contents of the text column are then
+ * kept in an array indexed by row position, built when the live search
+ * gets a model and kept in sync with the model signals. It is built
+ * from a low priority idle, or at the latest by the refilter handler,
+ * but never from the visible function: that one runs in the middle of
+ * a filter pass, possibly a chunked one. Only flat models
+ * (%GTK_TREE_MODEL_LIST_ONLY) are cached, other models normalize on
+ * the fly as before.
+ */
+static gchar *
+hildon_touch_selector_column_normalize_row (HildonTouchSelectorColumn *column,
+                                            GtkTreeModel *model,
+                                            GtkTreeIter *iter)
+{
+  gchar *string, *string_ascii = NULL;
+
+  gtk_tree_model_get (model, iter, column->priv->text_column, &string, -1);
+  if (string != NULL) {
+    string_ascii = hildon_helper_normalize_string (string);
+    g_free (string);
+  }
+
+  return string_ascii;
+}
+
+static void
+hildon_touch_selector_column_free_norm_cache (HildonTouchSelectorColumn *column)
+{
+  if (column->priv->norm_cache_idle_id != 0) {
+    g_source_remove (column->priv->norm_cache_idle_id);
+    column->priv->norm_cache_idle_id = 0;
+  }
+
+  if (column->priv->norm_cache != NULL) {
+    g_ptr_array_unref (column->priv->norm_cache);
+    column->priv->norm_cache = NULL;
+  }
+}
+
+static void
+hildon_touch_selector_column_build_norm_cache (HildonTouchSelectorColumn *column)
+{
+  GtkTreeModel *model = column->priv->model;
+  GtkTreeIter iter;
+  gboolean valid;
+
+  hildon_touch_selector_column_free_norm_cache (column);
+
+  if (model == NULL ||
+      column->priv->livesearch == NULL ||
+      column->priv->text_column < 0)
+    return;
+
+  if (!(gtk_tree_model_get_flags (model) & GTK_TREE_MODEL_LIST_ONLY))
+    return;
+
+  column->priv->norm_cache =
+    g_ptr_array_new_full (gtk_tree_model_iter_n_children (model, NULL), g_free);
+
+  for (valid = gtk_tree_model_get_iter_first (model, &iter);
+       valid;
+       valid = gtk_tree_model_iter_next (model, &iter)) {
+    g_ptr_array_add (column->priv->norm_cache,
+                     hildon_touch_selector_column_normalize_row (column, model, &iter));
+  }
+}
+
+static gboolean
+on_norm_cache_idle (gpointer userdata)
+{
+  HildonTouchSelectorColumn *column = HILDON_TOUCH_SELECTOR_COLUMN (userdata);
+
+  column->priv->norm_cache_idle_id = 0;
+  hildon_touch_selector_column_build_norm_cache (column);
+
+  return FALSE;
+}
+
+/* Built from an idle rather than right away, so that creating a column
+   with a large model doesn't walk all of it */
+static void
+hildon_touch_selector_column_queue_norm_cache (HildonTouchSelectorColumn *column)
+{
+  if (column->priv->norm_cache != NULL ||
+      column->priv->norm_cache_idle_id != 0 ||
+      column->priv->livesearch == NULL ||
+      column->priv->text_column < 0)
+    return;
+
+  column->priv->norm_cache_idle_id =
+    gdk_threads_add_idle_full (G_PRIORITY_LOW, on_norm_cache_idle, column, NULL);
+}
+
+static void
+on_norm_cache_row_inserted (GtkTreeModel *model,
+                            GtkTreePath *path,
+                            GtkTreeIter *iter,
+                            gpointer userdata)
+{
+  HildonTouchSelectorColumn *column = HILDON_TOUCH_SELECTOR_COLUMN (userdata);
+  GPtrArray *cache = column->priv->norm_cache;
+  gint index;
+
+  if (cache == NULL)
+    return;
+
+  index = gtk_tree_path_get_indices (path)[0];
+  if ((guint) index > cache->len) {
+    /* Out of sync, stop caching */
+    hildon_touch_selector_column_free_norm_cache (column);
+    return;
+  }
+
+  g_ptr_array_insert (cache, index,
+                      hildon_touch_selector_column_normalize_row (column, model, iter));
+}
+
+static void
+on_norm_cache_row_changed (GtkTreeModel *model,
+                           GtkTreePath *path,
+                           GtkTreeIter *iter,
+                           gpointer userdata)
+{
+  HildonTouchSelectorColumn *column = HILDON_TOUCH_SELECTOR_COLUMN (userdata);
+  GPtrArray *cache = column->priv->norm_cache;
+  gint index;
+
+  if (cache == NULL)
+    return;
+
+  index = gtk_tree_path_get_indices (path)[0];
+  if ((guint) index >= cache->len) {
+    hildon_touch_selector_column_free_norm_cache (column);
+    return;
+  }
+
+  g_free (g_ptr_array_index (cache, index));
+  g_ptr_array_index (cache, index) =
+    hildon_touch_selector_column_normalize_row (column, model, iter);
+}
+
+static void
+on_norm_cache_row_deleted (GtkTreeModel *model,
+                           GtkTreePath *path,
+                           gpointer userdata)
+{
+  HildonTouchSelectorColumn *column = HILDON_TOUCH_SELECTOR_COLUMN (userdata);
+  GPtrArray *cache = column->priv->norm_cache;
+  gint index;
+
+  if (cache == NULL)
+    return;
+
+  index = gtk_tree_path_get_indices (path)[0];
+  if ((guint) index >= cache->len) {
+    hildon_touch_selector_column_free_norm_cache (column);
+    return;
+  }
+
+  g_ptr_array_remove_index (cache, index);
+}
+
+static void
+on_norm_cache_rows_reordered (GtkTreeModel *model,
+                              GtkTreePath *path,
+                              GtkTreeIter *iter,
+                              gint *new_order,
+                              gpointer userdata)
+{
+  HildonTouchSelectorColumn *column = HILDON_TOUCH_SELECTOR_COLUMN (userdata);
+  GPtrArray *cache = column->priv->norm_cache;
+  GPtrArray *reordered;
+  guint i;
+
+  if (cache == NULL)
+    return;
+
+  reordered = g_ptr_array_new_full (cache->len, g_free);
+  for (i = 0; i < cache->len; i++) {
+    g_ptr_array_add (reordered, g_ptr_array_index (cache, new_order[i]));
+  }
+
+  /* The strings now belong to the reordered array */
+  g_ptr_array_set_free_func (cache, NULL);
+  g_ptr_array_unref (cache);
+  column->priv->norm_cache = reordered;
+}
+
+static void
+hildon_touch_selector_column_connect_norm_cache (HildonTouchSelectorColumn *column)
+{
+  GtkTreeModel *model = column->priv->model;
+
+  g_signal_connect (model, "row-inserted",
+                    G_CALLBACK (on_norm_cache_row_inserted), column);
+  g_signal_connect (model, "row-changed",
+                    G_CALLBACK (on_norm_cache_row_changed), column);
+  g_signal_connect (model, "row-deleted",
+                    G_CALLBACK (on_norm_cache_row_deleted), column);
+  g_signal_connect (model, "rows-reordered",
+                    G_CALLBACK (on_norm_cache_rows_reordered), column);
 }
 
 static gboolean
@@ -994,17 +1332,37 @@ hildon_live_search_visible_func (GtkTreeModel *model,
                                  gpointer userdata)
 {
   gboolean visible = TRUE;
-  gchar *string, *string_ascii;
+  const gchar *string_ascii = NULL;
+  gchar *normalized = NULL;
+  gboolean cached = FALSE;
   GSList *list_iter;
   HildonTouchSelectorColumn *col;
   HildonTouchSelector *selector;
 
   col = HILDON_TOUCH_SELECTOR_COLUMN (userdata);
   selector = col->priv->parent;
-  gint text_column = GPOINTER_TO_INT (col->priv->text_column);
 
-  gtk_tree_model_get (model, iter, text_column, &string, -1);
-  string_ascii = hildon_helper_normalize_string (string);
+  /* Nothing to match against: don't normalize the rows while the
+     column is shown for the first time */
+  if (selector->priv->norm_tokens == NULL)
+    return TRUE;
+
+  if (col->priv->norm_cache != NULL && model == col->priv->model) {
+    GtkTreePath *path = gtk_tree_model_get_path (model, iter);
+    gint index = gtk_tree_path_get_indices (path)[0];
+
+    if ((guint) index < col->priv->norm_cache->len) {
+      string_ascii = g_ptr_array_index (col->priv->norm_cache, index);
+      cached = TRUE;
+    }
+    gtk_tree_path_free (path);
+  }
+
+  if (!cached) {
+    normalized = hildon_touch_selector_column_normalize_row (col, model, iter);
+    string_ascii = normalized;
+  }
+
   list_iter = selector->priv->norm_tokens;
   while (visible && list_iter) {
     visible = (string_ascii != NULL &&
@@ -1013,8 +1371,7 @@ hildon_live_search_visible_func (GtkTreeModel *model,
     list_iter = list_iter->next;
   }
 
-  g_free (string);
-  g_free (string_ascii);
+  g_free (normalized);
 
   return visible;
 }
@@ -1027,6 +1384,7 @@ on_live_search_refilter (HildonLiveSearch *livesearch,
 
     gchar **tokens = g_strsplit (hildon_live_search_get_text (livesearch), " ", -1);
     gchar *token;
+    GSList *iter;
     gint i;
 
     if (selector->priv->norm_tokens != NULL) {
@@ -1044,6 +1402,17 @@ on_live_search_refilter (HildonLiveSearch *livesearch,
 
     g_strfreev (tokens);
 
+    /* Don't leave the cache to be built by the filter pass about to
+       start */
+    for (iter = selector->priv->columns; iter; iter = g_slist_next (iter)) {
+        HildonTouchSelectorColumn *col = HILDON_TOUCH_SELECTOR_COLUMN (iter->data);
+
+        if (col->priv->livesearch == GTK_WIDGET (livesearch) &&
+            col->priv->norm_cache == NULL &&
+            selector->priv->norm_tokens != NULL)
+            hildon_touch_selector_column_build_norm_cache (col);
+    }
+
     return FALSE;
 }
 
@@ -1069,10 +1438,12 @@ hildon_touch_selector_column_set_text_column (HildonTouchSelectorColumn *column,
   column->priv->text_column = text_column;
 
   if (column->priv->livesearch) {
+    hildon_touch_selector_column_free_norm_cache (column);
     hildon_live_search_set_visible_func (HILDON_LIVE_SEARCH (column->priv->livesearch),
                                          hildon_live_search_visible_func,
                                          column,
                                          NULL);
+    hildon_touch_selector_column_queue_norm_cache (column);
   }
 
   g_object_notify (G_OBJECT (column), "text-column");
@@ -1130,7 +1501,10 @@ hildon_touch_selector_column_dispose      (GObject *object)
   HildonTouchSelectorColumnPrivate *priv =
       HILDON_TOUCH_SELECTOR_COLUMN (object)->priv;
 
+  hildon_touch_selector_column_free_norm_cache (HILDON_TOUCH_SELECTOR_COLUMN (object));
+
   if (priv->model != NULL) {
+      g_signal_handlers_disconnect_by_data (priv->model, object);
       g_object_unref (priv->model);
       priv->model = NULL;
   }
@@ -1322,6 +1696,10 @@ hildon_touch_selector_new (void)
  * can be populated conveniently through hildon_touch_selector_append_text(),
  * hildon_touch_selector_prepend_text(), hildon_touch_selector_insert_text().
  *
+ * If none of the texts spans several lines, call
+ * hildon_touch_selector_set_fixed_row_height() on the new selector to
+ * keep it fast to show with many rows.
+ *
  * Returns: A new #HildonTouchSelector
  *
  * Since: 2.2
@@ -1434,6 +1812,12 @@ hildon_touch_selector_add_live_search (HildonTouchSelector *selector,
     gint text_column;
 
     column->priv->livesearch = hildon_live_search_new ();
+    /* Each search token only matches word prefixes, so appending text
+       to the live search can only hide rows */
+    hildon_live_search_set_incremental (HILDON_LIVE_SEARCH (column->priv->livesearch),
+                                        TRUE);
+    hildon_live_search_set_chunked (HILDON_LIVE_SEARCH (column->priv->livesearch),
+                                    TRUE);
     hildon_live_search_set_filter (HILDON_LIVE_SEARCH (column->priv->livesearch),
                                    GTK_TREE_MODEL_FILTER (column->priv->filter));
     g_signal_connect (column->priv->livesearch, "refilter",
@@ -1446,10 +1830,12 @@ hildon_touch_selector_add_live_search (HildonTouchSelector *selector,
                                     GTK_WIDGET (column->priv->tree_view));
     text_column = hildon_touch_selector_column_get_text_column (column);
     if (text_column > -1) {
+      hildon_touch_selector_column_free_norm_cache (column);
       hildon_live_search_set_visible_func (HILDON_LIVE_SEARCH (column->priv->livesearch),
                                            hildon_live_search_visible_func,
                                            column,
                                            NULL);
+      hildon_touch_selector_column_queue_norm_cache (column);
     }
   }
 }
@@ -1469,6 +1855,7 @@ hildon_touch_selector_remove_live_search (HildonTouchSelector *selector)
     hildon_live_search_widget_unhook (HILDON_LIVE_SEARCH (col->priv->livesearch));
     gtk_widget_destroy (col->priv->livesearch);
     col->priv->livesearch = NULL;
+    hildon_touch_selector_column_free_norm_cache (col);
   }
 
   selector->priv->has_live_search = FALSE;
@@ -2253,6 +2640,12 @@ hildon_touch_selector_get_selected_rows (HildonTouchSelector * selector,
  *
  * Gets the model of a column of @selector.
  *
+ * The columns of #HildonDateSelector and #HildonTimeSelector share
+ * their rows with the other selectors of the same kind. Since 3.0,
+ * their models are then a #GtkTreeModelFilter of their own over the
+ * shared model, which gtk_tree_model_filter_get_model() returns. The
+ * shared model must not be changed.
+ *
  * Returns: the #GtkTreeModel for the column @column of @selector.
  *
  * Since: 2.2
@@ -2349,10 +2742,13 @@ _hildon_touch_selector_set_model (HildonTouchSelector * selector,
                                           on_row_changed, selector);
     g_signal_handlers_disconnect_by_func (current_column->priv->model,
                                           on_row_deleted, selector);
+    g_signal_handlers_disconnect_by_data (current_column->priv->model,
+                                          current_column);
     g_object_unref (current_column->priv->model);
   }
 
   current_column->priv->model = g_object_ref (model);
+  hildon_touch_selector_column_connect_norm_cache (current_column);
 
   if (current_column->priv->filter) {
     g_object_unref (current_column->priv->filter);
@@ -2366,6 +2762,9 @@ _hildon_touch_selector_set_model (HildonTouchSelector * selector,
                     G_CALLBACK (on_row_changed), selector);
   g_signal_connect_after (model, "row-deleted",
                           G_CALLBACK (on_row_deleted), selector);
+
+  hildon_touch_selector_column_free_norm_cache (current_column);
+  hildon_touch_selector_column_queue_norm_cache (current_column);
 }
 
 /**
@@ -2979,3 +3378,58 @@ hildon_touch_selector_get_live_search (HildonTouchSelector *selector)
 
   return selector->priv->has_live_search;
 }
+
+/**
+ * hildon_touch_selector_set_fixed_row_height:
+ * @selector: a #HildonTouchSelector
+ * @fixed_row_height: whether all the rows have the same height
+ *
+ * Sets the #HildonTouchSelector:fixed-row-height property. Only set
+ * it when every row of every column of @selector has the same height,
+ * like in the selectors with a single line of text per row. Columns
+ * then measure only their first row and render only the rows in view,
+ * which keeps large models fast to show.
+ *
+ * Since: 3.0
+ **/
+void
+hildon_touch_selector_set_fixed_row_height (HildonTouchSelector *selector,
+                                            gboolean fixed_row_height)
+{
+  GSList *iter;
+
+  g_return_if_fail (HILDON_IS_TOUCH_SELECTOR (selector));
+
+  fixed_row_height = fixed_row_height ? TRUE : FALSE;
+  if (selector->priv->fixed_row_height == fixed_row_height)
+    return;
+
+  selector->priv->fixed_row_height = fixed_row_height;
+
+  for (iter = selector->priv->columns; iter; iter = g_slist_next (iter)) {
+    HildonTouchSelectorColumn *column = HILDON_TOUCH_SELECTOR_COLUMN (iter->data);
+
+    _set_tree_view_fixed_row_height (column->priv->tree_view, fixed_row_height);
+  }
+
+  g_object_notify (G_OBJECT (selector), "fixed-row-height");
+}
+
+/**
+ * hildon_touch_selector_get_fixed_row_height:
+ * @selector: a #HildonTouchSelector
+ *
+ * Gets the value of the #HildonTouchSelector:fixed-row-height property.
+ *
+ * Returns: %TRUE if the rows of @selector are assumed to have the
+ * same height, %FALSE otherwise
+ *
+ * Since: 3.0
+ **/
+gboolean
+hildon_touch_selector_get_fixed_row_height (HildonTouchSelector *selector)
+{
+  g_return_val_if_fail (HILDON_IS_TOUCH_SELECTOR (selector), FALSE);
+
+  return selector->priv->fixed_row_height;
+}
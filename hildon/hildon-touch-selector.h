@@ -240,6 +240,13 @@ hildon_touch_selector_set_live_search           (HildonTouchSelector *selector,
 gboolean
 hildon_touch_selector_get_live_search           (HildonTouchSelector *selector);
 
+void
+hildon_touch_selector_set_fixed_row_height      (HildonTouchSelector *selector,
+                                                 gboolean fixed_row_height);
+
+gboolean
+hildon_touch_selector_get_fixed_row_height      (HildonTouchSelector *selector);
+
 G_END_DECLS
 
 #endif /* __HILDON_TOUCH_SELECTOR_H__ */
@@ -0,0 +1,194 @@
+/*
+ * This file is a part of hildon tests
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+/*
+ * Benchmark of the HildonAnimationActor protocol against the mock
+ * compositor. A number of actors are moved, rotated, scaled and faded
+ * from a tick callback of their parent window, as an application
+ * animation would, with the messages sent right away, grouped with
+ * hildon_animation_actor_freeze_updates() or synchronized to the frame
+ * clock.
+ *
+ * For each way, it reports the messages the compositor received per
+ * frame, and the latency from the frame an actor was moved in to the
+ * arrival of its position message.
+ *
+ * It needs a display, use xvfb-run to run it headless.
+ *
+ * Usage: bench-hildon-animation-actor [actors] [frames]
+ */
+
+#include <stdlib.h>
+#include <gtk/gtk.h>
+#include <hildon/hildon.h>
+
+#include "mock-compositor.h"
+
+#define POSITION_MESSAGE "_HILDON_ANIMATION_CLIENT_MESSAGE_POSITION"
+
+typedef enum {
+  MODE_IMMEDIATE,
+  MODE_FROZEN,
+  MODE_FRAME_SYNC
+} Mode;
+
+typedef struct {
+  MockCompositor *mc;
+  GtkWidget **actors;
+  guint n_actors;
+  guint n_frames;
+  guint frame;
+  Mode mode;
+  gint64 *frame_times;
+  GMainLoop *loop;
+} Bench;
+
+static gboolean
+animate (GtkWidget *window, GdkFrameClock *clock, gpointer data)
+{
+  Bench *bench = data;
+  guint i;
+
+  if (bench->frame == bench->n_frames)
+    {
+      g_main_loop_quit (bench->loop);
+      return G_SOURCE_REMOVE;
+    }
+
+  bench->frame_times[bench->frame] = g_get_monotonic_time ();
+
+  for (i = 0; i < bench->n_actors; i++)
+    {
+      HildonAnimationActor *actor = HILDON_ANIMATION_ACTOR (bench->actors[i]);
+
+      if (bench->mode == MODE_FROZEN)
+        hildon_animation_actor_freeze_updates (actor);
+
+      /* The frame is recovered from the X coordinate on arrival */
+      hildon_animation_actor_set_position (actor, bench->frame, i);
+      hildon_animation_actor_set_depth (actor, -(gint) (bench->frame % 10));
+      hildon_animation_actor_set_rotation (actor, HILDON_AA_Z_AXIS,
+                                           bench->frame % 360, 0, 0, 0);
+      hildon_animation_actor_set_scale (actor, 1 + (bench->frame % 10) / 10.0,
+                                        1 + (bench->frame % 10) / 10.0);
+      hildon_animation_actor_set_opacity (actor, bench->frame % 256);
+
+      if (bench->mode == MODE_FROZEN)
+        hildon_animation_actor_thaw_updates (actor);
+    }
+
+  bench->frame++;
+
+  return G_SOURCE_CONTINUE;
+}
+
+static void
+run (Bench *bench, GtkWidget *window, Mode mode, const gchar *name)
+{
+  Atom position;
+  gint64 latency = 0, max_latency = 0;
+  guint i, n_positions = 0;
+
+  for (i = 0; i < bench->n_actors; i++)
+    hildon_animation_actor_set_frame_sync (HILDON_ANIMATION_ACTOR (bench->actors[i]),
+                                           mode == MODE_FRAME_SYNC);
+
+  mock_compositor_settle (bench->mc);
+  mock_compositor_clear (bench->mc);
+
+  bench->mode = mode;
+  bench->frame = 0;
+  gtk_widget_add_tick_callback (window, animate, bench, NULL);
+  g_main_loop_run (bench->loop);
+
+  mock_compositor_settle (bench->mc);
+
+  position = XInternAtom (bench->mc->display, POSITION_MESSAGE, False);
+  for (i = 0; i < bench->mc->messages->len; i++)
+    {
+      const MockMessage *message = &g_array_index (bench->mc->messages,
+                                                   MockMessage, i);
+      gint64 elapsed;
+
+      if (message->type != position ||
+          message->l[0] < 0 || message->l[0] >= (long) bench->n_frames)
+        continue;
+
+      elapsed = message->time - bench->frame_times[message->l[0]];
+      latency += elapsed;
+      max_latency = MAX (max_latency, elapsed);
+      n_positions++;
+    }
+
+  g_print ("%-12s %8.2f messages/frame, latency mean %8.2f us, max %8.2f us\n",
+           name,
+           (gdouble) mock_compositor_count (bench->mc, NULL) / bench->n_frames,
+           (gdouble) latency / MAX (n_positions, 1),
+           (gdouble) max_latency);
+}
+
+int
+main (int argc, char **argv)
+{
+  Bench bench = { 0, };
+  GtkWidget *window;
+  guint i;
+
+  if (!gtk_init_check (&argc, &argv) ||
+      (bench.mc = mock_compositor_new ()) == NULL) {
+    g_printerr ("No display, run under xvfb-run\n");
+    return 77;
+  }
+
+  bench.n_actors = argc > 1 ? atoi (argv[1]) : 16;
+  bench.n_frames = argc > 2 ? atoi (argv[2]) : 300;
+  bench.frame_times = g_new0 (gint64, bench.n_frames);
+  bench.actors = g_new0 (GtkWidget *, bench.n_actors);
+  bench.loop = g_main_loop_new (NULL, FALSE);
+
+  window = hildon_window_new ();
+  gtk_widget_show (window);
+
+  for (i = 0; i < bench.n_actors; i++)
+    {
+      bench.actors[i] = hildon_animation_actor_new ();
+      mock_compositor_manage (bench.mc, bench.actors[i]);
+      hildon_animation_actor_set_parent (HILDON_ANIMATION_ACTOR (bench.actors[i]),
+                                         GTK_WINDOW (window));
+      gtk_widget_show (bench.actors[i]);
+      mock_compositor_set_ready (bench.mc, bench.actors[i],
+                                 MOCK_ANIMATION_ACTOR_READY);
+    }
+
+  g_print ("%u actors, %u frames\n", bench.n_actors, bench.n_frames);
+  run (&bench, window, MODE_IMMEDIATE, "immediate:");
+  run (&bench, window, MODE_FROZEN, "frozen:");
+  run (&bench, window, MODE_FRAME_SYNC, "frame sync:");
+
+  for (i = 0; i < bench.n_actors; i++)
+    gtk_widget_destroy (bench.actors[i]);
+  gtk_widget_destroy (window);
+  mock_compositor_free (bench.mc);
+  g_main_loop_unref (bench.loop);
+  g_free (bench.actors);
+  g_free (bench.frame_times);
+
+  return 0;
+}
@@ -0,0 +1,136 @@
+/*
+ * This file is a part of hildon tests
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+/*
+ * Benchmark of the month changes of HildonCalendar. The calendar is
+ * moved forward through a number of months, as the arrow buttons and
+ * calendar_timer() do, then back and forth over the same months. Each
+ * month change is followed by a size request and a draw of the whole
+ * calendar into an image surface.
+ *
+ * The month names, day names and digits come from the locale, run it
+ * with LC_ALL set to compare locales.
+ *
+ * It still needs a display, use xvfb-run to run it headless.
+ *
+ * Usage: bench-hildon-calendar [months] [passes]
+ */
+
+#include <stdlib.h>
+#include <locale.h>
+#include <gtk/gtk.h>
+#include <hildon/hildon.h>
+
+#define START_YEAR 2009
+
+typedef struct {
+  gint64 total;
+  gint64 max;
+  guint n;
+} Timing;
+
+static void
+timing_add (Timing *timing, gint64 elapsed)
+{
+  timing->total += elapsed;
+  timing->max = MAX (timing->max, elapsed);
+  timing->n++;
+}
+
+static void
+flip (GtkWidget *calendar, cairo_t *cr, guint month, Timing *timing)
+{
+  GtkRequisition requisition;
+  gint64 start;
+
+  start = g_get_monotonic_time ();
+
+  hildon_calendar_select_month (HILDON_CALENDAR (calendar),
+                                month % 12, START_YEAR + month / 12);
+  gtk_widget_queue_resize (calendar);
+  gtk_widget_get_preferred_size (calendar, &requisition, NULL);
+  gtk_widget_draw (calendar, cr);
+
+  timing_add (timing, g_get_monotonic_time () - start);
+}
+
+static void
+report (const gchar *name, const Timing *timing)
+{
+  g_print ("%-24s %6u flips, mean %7.2f us, max %8.2f us\n", name, timing->n,
+           (gdouble) timing->total / MAX (timing->n, 1),
+           (gdouble) timing->max);
+}
+
+int
+main (int argc, char **argv)
+{
+  guint n_months, n_passes, i, pass;
+  Timing first = { 0, }, again = { 0, };
+  GtkWidget *window, *calendar;
+  GtkAllocation allocation;
+  cairo_surface_t *surface;
+  cairo_t *cr;
+
+  setlocale (LC_ALL, "");
+
+  if (!gtk_init_check (&argc, &argv)) {
+    g_printerr ("No display, run under xvfb-run\n");
+    return 77;
+  }
+
+  n_months = argc > 1 ? atoi (argv[1]) : 120;
+  n_passes = argc > 2 ? atoi (argv[2]) : 20;
+
+  window = gtk_offscreen_window_new ();
+  calendar = hildon_calendar_new ();
+  hildon_calendar_set_display_options (HILDON_CALENDAR (calendar),
+                                       HILDON_CALENDAR_SHOW_HEADING |
+                                       HILDON_CALENDAR_SHOW_DAY_NAMES |
+                                       HILDON_CALENDAR_SHOW_WEEK_NUMBERS);
+  gtk_container_add (GTK_CONTAINER (window), calendar);
+  gtk_widget_show_all (window);
+
+  gtk_widget_get_allocation (calendar, &allocation);
+  surface = cairo_image_surface_create (CAIRO_FORMAT_RGB24,
+                                        MAX (allocation.width, 1),
+                                        MAX (allocation.height, 1));
+  cr = cairo_create (surface);
+
+  /* Months not shown before */
+  for (i = 0; i < n_months; i++)
+    flip (calendar, cr, i, &first);
+
+  /* Back and forth around the last one, as the arrows and the
+     calendar_timer() spin do */
+  for (pass = 0; pass < n_passes; pass++)
+    for (i = 0; i < 8; i++)
+      flip (calendar, cr, n_months - 1 - (i < 4 ? i : 7 - i), &again);
+
+  g_print ("locale: %s\n", setlocale (LC_TIME, NULL));
+  report ("new months:", &first);
+  report ("months shown before:", &again);
+
+  cairo_destroy (cr);
+  cairo_surface_destroy (surface);
+  gtk_widget_destroy (window);
+
+  return 0;
+}
@@ -0,0 +1,308 @@
+/*
+ * This file is a part of hildon tests
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+/*
+ * Micro-benchmark of the string matching helpers used by the live
+ * search of HildonTouchSelector and friends. Each needle is matched
+ * against a list of contact-like names, with the current helpers and
+ * with copies of their byte-at-a-time implementations, which are also
+ * used to check that both give the same results.
+ *
+ * Usage: bench-hildon-helper [number of names] [rounds]
+ */
+
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+#include <hildon/hildon-helper.h>
+
+static const gchar *first_names[] = {
+  "John", "Mary", "Peter", "Anna", "Michael", "Laura", "David", "Sofia",
+  "Jos\xc3\xa9", "Mar\xc3\xad" "a", "J\xc3\xbcrgen", "Ren\xc3\xa9" "e",
+  "\xc3\x81ngel", "Fran\xc3\xa7ois", "Bj\xc3\xb6rn", "Zo\xc3\xab",
+  "Thomas", "Emma", "Daniel", "Olivia", "Mat\xc4\x9bj", "Ji\xc5\x99\xc3\xad",
+  "Carlos", "Eva", "Hiroshi", "Ingrid", "Pekka", "Aino", "Lucas", "Chloe"
+};
+
+static const gchar *last_names[] = {
+  "Smith", "Johnson", "Williams", "Brown", "Garc\xc3\xad" "a", "M\xc3\xbcller",
+  "Virtanen", "Korhonen", "Dupont", "Martin", "Rossi", "Fern\xc3\xa1ndez",
+  "Nov\xc3\xa1k", "Svoboda", "Nakamura", "Andersson", "O'Brien", "Van der Berg",
+  "Lef\xc3\xa8vre", "Nieminen", "Schmidt", "Kowalski", "Silva", "Dvo\xc5\x99\xc3\xa1k"
+};
+
+static const gchar *needles[] = {
+  "j", "jo", "mar", "smi", "garc", "muller", "van", "ber", "nov", "xyz"
+};
+
+/* Copy of hildon_helper_smart_match() without the fast path */
+static gchar *
+reference_smart_match (const gchar *haystack, const gchar *needle)
+{
+  if (haystack == NULL) return NULL;
+  if (needle == NULL) return NULL;
+  if (strlen (haystack) == 0) return NULL;
+
+  if (g_ascii_isalnum (needle[0])) {
+    gint i = 0;
+    while (haystack[i] != '\0') {
+      while (haystack[i] != '\0' && !g_ascii_isalnum (haystack[i]))
+        i++;
+      if (g_ascii_strncasecmp (haystack + i, needle, strlen (needle)) == 0)
+        return (gchar *) haystack + i;
+      while (g_ascii_isalnum (haystack[i]))
+        i++;
+    }
+  } else {
+    return strcasestr (haystack, needle);
+  }
+
+  return NULL;
+}
+
+/* Copies of hildon_helper_utf8_strstrcasedecomp_needle_stripped()
+   and its helpers without the fast path */
+static gunichar
+reference_stripped_char (gunichar ch)
+{
+  gunichar decomp[4];
+  GUnicodeType utype;
+
+  utype = g_unichar_type (ch);
+
+  switch (utype) {
+  case G_UNICODE_CONTROL:
+  case G_UNICODE_FORMAT:
+  case G_UNICODE_UNASSIGNED:
+  case G_UNICODE_COMBINING_MARK:
+    return 0;
+  default:
+    ch = g_unichar_tolower (ch);
+  case G_UNICODE_LOWERCASE_LETTER:
+    if (g_unichar_fully_decompose (ch, FALSE, decomp, 4))
+      return decomp[0];
+    break;
+  }
+
+  return 0;
+}
+
+static const gchar *
+reference_get_utf8 (const gchar *text, gunichar *out)
+{
+  *out = g_utf8_get_char (text);
+  return (*out == (gunichar) -1) ? NULL : g_utf8_next_char (text);
+}
+
+static const gchar *
+reference_get_next (const gchar *p, const gchar **o, gunichar *out, gboolean separators)
+{
+  gunichar utf8;
+
+  if (separators) {
+    do {
+      *o = p;
+      p = reference_get_utf8 (p, &utf8);
+      *out = reference_stripped_char (utf8);
+    } while (p && utf8 && !g_unichar_isalnum (*out));
+  } else {
+    *o = p;
+    p = reference_get_utf8 (p, &utf8);
+    *out = reference_stripped_char (utf8);
+  }
+
+  return p;
+}
+
+static const gchar *
+reference_strstrcasedecomp (const gchar *haystack, const gunichar *nuni)
+{
+  gunichar unival;
+  gint nlen = 0;
+  const gchar *o, *p;
+  gunichar sc;
+
+  if (haystack == NULL) return NULL;
+  if (nuni == NULL) return NULL;
+  if (strlen (haystack) == 0) return NULL;
+  while (nuni[nlen] != 0) nlen++;
+
+  if (nlen < 1) return haystack;
+
+  for (p = reference_get_next (haystack, &o, &sc, g_unichar_isalnum (nuni[0]));
+       p && sc;
+       p = reference_get_next (p, &o, &sc, g_unichar_isalnum (nuni[0]))) {
+    if (sc == nuni[0]) {
+      const gchar *q = p;
+      gint npos = 1;
+      while (npos < nlen) {
+        q = reference_get_utf8 (q, &unival);
+        if (!q || !unival) return NULL;
+        sc = reference_stripped_char (unival);
+        if ((!sc) || (sc != nuni[npos])) break;
+        npos++;
+      }
+      if (npos == nlen)
+        return o;
+    }
+    while (p) {
+      sc = g_utf8_get_char (p);
+      if (!g_unichar_isalnum (sc))
+        break;
+      p = g_utf8_next_char (p);
+    }
+  }
+
+  return NULL;
+}
+
+typedef gconstpointer (*MatchFunc) (const gchar *haystack, gconstpointer needle);
+
+static gconstpointer
+match_smart (const gchar *haystack, gconstpointer needle)
+{
+  return hildon_helper_smart_match (haystack, needle);
+}
+
+static gconstpointer
+match_smart_reference (const gchar *haystack, gconstpointer needle)
+{
+  return reference_smart_match (haystack, needle);
+}
+
+static gconstpointer
+match_decomp (const gchar *haystack, gconstpointer needle)
+{
+  return hildon_helper_utf8_strstrcasedecomp_needle_stripped (haystack, needle);
+}
+
+static gconstpointer
+match_decomp_reference (const gchar *haystack, gconstpointer needle)
+{
+  return reference_strstrcasedecomp (haystack, needle);
+}
+
+/* Returns the time taken in milliseconds, and the matches in @count */
+static gdouble
+run (MatchFunc func, gchar **names, guint n_names,
+     gpointer *needles, guint n_needles, guint rounds, guint *count)
+{
+  gint64 start = g_get_monotonic_time ();
+  guint r, i, j;
+
+  *count = 0;
+  for (r = 0; r < rounds; r++)
+    for (j = 0; j < n_needles; j++)
+      for (i = 0; i < n_names; i++)
+        if (func (names[i], needles[j]) != NULL)
+          (*count)++;
+
+  return (g_get_monotonic_time () - start) / 1000.0;
+}
+
+static gboolean
+check (MatchFunc func, MatchFunc reference, gchar **names, guint n_names,
+       gpointer *needles, guint n_needles)
+{
+  guint i, j;
+
+  for (j = 0; j < n_needles; j++)
+    for (i = 0; i < n_names; i++)
+      if (func (names[i], needles[j]) != reference (names[i], needles[j])) {
+        g_printerr ("Different results for \"%s\"\n", names[i]);
+        return FALSE;
+      }
+
+  return TRUE;
+}
+
+static void
+report (const gchar *name, MatchFunc func, MatchFunc reference,
+        gchar **names, guint n_names, gpointer *needles, guint n_needles,
+        guint rounds)
+{
+  gdouble fast, slow;
+  guint fast_count, slow_count;
+
+  slow = run (reference, names, n_names, needles, n_needles, rounds, &slow_count);
+  fast = run (func, names, n_names, needles, n_needles, rounds, &fast_count);
+
+  g_print ("%-52s %10.1f ms %10.1f ms %6.2fx %s\n", name, slow, fast,
+           fast > 0 ? slow / fast : 0.0,
+           fast_count == slow_count ? "" : "(different matches!)");
+}
+
+int
+main (int argc, char **argv)
+{
+  guint n_names = argc > 1 ? atoi (argv[1]) : 20000;
+  guint rounds = argc > 2 ? atoi (argv[2]) : 10;
+  guint n_needles = G_N_ELEMENTS (needles);
+  gchar **names, **normalized;
+  gpointer stripped[G_N_ELEMENTS (needles)];
+  gpointer plain[G_N_ELEMENTS (needles)];
+  GRand *rand;
+  guint i;
+  gint status = 0;
+
+  rand = g_rand_new_with_seed (0);
+  names = g_new (gchar *, n_names);
+  normalized = g_new (gchar *, n_names);
+
+  for (i = 0; i < n_names; i++) {
+    names[i] = g_strdup_printf ("%s %s",
+                                first_names[g_rand_int_range (rand, 0, G_N_ELEMENTS (first_names))],
+                                last_names[g_rand_int_range (rand, 0, G_N_ELEMENTS (last_names))]);
+    normalized[i] = hildon_helper_normalize_string (names[i]);
+    if (normalized[i] == NULL)
+      normalized[i] = g_strdup (names[i]);
+  }
+
+  for (i = 0; i < n_needles; i++) {
+    plain[i] = (gpointer) needles[i];
+    stripped[i] = hildon_helper_strip_string (needles[i]);
+  }
+
+  if (!check (match_smart, match_smart_reference, normalized, n_names, plain, n_needles) ||
+      !check (match_decomp, match_decomp_reference, names, n_names, stripped, n_needles))
+    status = 1;
+
+  g_print ("%u names, %u needles, %u rounds\n", n_names, n_needles, rounds);
+  g_print ("%-52s %13s %13s\n", "", "reference", "current");
+  report ("hildon_helper_smart_match",
+          match_smart, match_smart_reference,
+          normalized, n_names, plain, n_needles, rounds);
+  report ("hildon_helper_utf8_strstrcasedecomp_needle_stripped",
+          match_decomp, match_decomp_reference,
+          names, n_names, stripped, n_needles, rounds);
+
+  for (i = 0; i < n_needles; i++)
+    g_free (stripped[i]);
+  for (i = 0; i < n_names; i++) {
+    g_free (names[i]);
+    g_free (normalized[i]);
+  }
+  g_free (names);
+  g_free (normalized);
+  g_rand_free (rand);
+
+  return status;
+}
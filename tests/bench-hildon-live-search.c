@@ -0,0 +1,284 @@
+/*
+ * This file is a part of hildon tests
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+/*
+ * Benchmark of the filtering of HildonLiveSearch while typing. A list
+ * of rows is put in an offscreen window, and a query is typed one
+ * character every KEY_INTERVAL milliseconds. The intervals between the
+ * frames of the list are measured until the filter shows the rows
+ * matching the whole query.
+ *
+ * The mode is one of:
+ *   chunked   filter in time slices (HildonLiveSearch:chunked)
+ *   threaded  match in worker threads (HildonLiveSearch:match-column)
+ *   blocking  filter all the rows at once, from an idle
+ *
+ * There are 100000 rows by default, and 200000 in threaded mode.
+ *
+ * It still needs a display, use xvfb-run to run it headless.
+ *
+ * Usage: bench-hildon-live-search [number of rows] [mode]
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <gtk/gtk.h>
+#include <hildon/hildon.h>
+
+#define QUERY "Row 4242"
+#define KEY_INTERVAL 150
+#define TIMEOUT 120
+
+typedef struct {
+  HildonLiveSearch *livesearch;
+  GtkTreeModel *filter;
+  gint n_expected;
+  guint n_typed;
+  gint64 last_frame;
+  gint64 last_key;
+  gint64 done;
+  GArray *intervals;
+  gboolean failed;
+} Bench;
+
+static GtkListStore *
+create_store (guint n_rows)
+{
+  GtkListStore *store;
+  guint i;
+
+  store = gtk_list_store_new (1, G_TYPE_STRING);
+  for (i = 0; i < n_rows; i++) {
+    gchar *str = g_strdup_printf ("Row %u", i);
+
+    gtk_list_store_insert_with_values (store, NULL, i, 0, str, -1);
+    g_free (str);
+  }
+
+  return store;
+}
+
+static gint
+count_matching (GtkTreeModel *model, const gchar *prefix)
+{
+  GtkTreeIter iter;
+  gboolean valid;
+  gint n = 0;
+
+  for (valid = gtk_tree_model_get_iter_first (model, &iter);
+       valid;
+       valid = gtk_tree_model_iter_next (model, &iter)) {
+    gchar *str;
+
+    gtk_tree_model_get (model, &iter, 0, &str, -1);
+    if (g_str_has_prefix (str, prefix))
+      n++;
+    g_free (str);
+  }
+
+  return n;
+}
+
+static gboolean
+tick (GtkWidget *widget, GdkFrameClock *clock, gpointer data)
+{
+  Bench *bench = data;
+  gint64 now = g_get_monotonic_time ();
+
+  if (bench->last_frame != 0 && bench->n_typed > 0 && bench->done == 0) {
+    gint64 interval = now - bench->last_frame;
+
+    g_array_append_val (bench->intervals, interval);
+  }
+  bench->last_frame = now;
+
+  return G_SOURCE_CONTINUE;
+}
+
+static gboolean
+check_done (gpointer data)
+{
+  Bench *bench = data;
+
+  if (gtk_tree_model_iter_n_children (bench->filter, NULL) != bench->n_expected)
+    return G_SOURCE_CONTINUE;
+
+  bench->done = g_get_monotonic_time ();
+  gtk_main_quit ();
+
+  return G_SOURCE_REMOVE;
+}
+
+static gboolean
+type_key (gpointer data)
+{
+  Bench *bench = data;
+  gchar key[2] = { QUERY[bench->n_typed], '\0' };
+
+  hildon_live_search_append_text (bench->livesearch, key);
+  bench->last_key = g_get_monotonic_time ();
+  bench->n_typed++;
+
+  if (bench->n_typed < strlen (QUERY))
+    return G_SOURCE_CONTINUE;
+
+  g_timeout_add (5, check_done, bench);
+
+  return G_SOURCE_REMOVE;
+}
+
+static gboolean
+start (gpointer data)
+{
+  g_timeout_add (KEY_INTERVAL, type_key, data);
+  return FALSE;
+}
+
+static gboolean
+timeout (gpointer data)
+{
+  Bench *bench = data;
+
+  g_printerr ("Timed out after typing %u characters\n", bench->n_typed);
+  bench->failed = TRUE;
+  gtk_main_quit ();
+
+  return FALSE;
+}
+
+static gint
+compare_intervals (gconstpointer a, gconstpointer b)
+{
+  gint64 x = *(const gint64 *) a;
+  gint64 y = *(const gint64 *) b;
+
+  return x < y ? -1 : x > y;
+}
+
+static gdouble
+percentile (GArray *sorted, guint p)
+{
+  guint i = (sorted->len - 1) * p / 100;
+
+  return g_array_index (sorted, gint64, i) / 1000.0;
+}
+
+static void
+report (Bench *bench)
+{
+  GArray *intervals = bench->intervals;
+  gint64 total = 0;
+  guint n_long = 0;
+  guint i;
+
+  g_print ("frames:                 %u\n", intervals->len);
+  if (intervals->len == 0)
+    return;
+
+  g_array_sort (intervals, compare_intervals);
+  for (i = 0; i < intervals->len; i++) {
+    gint64 interval = g_array_index (intervals, gint64, i);
+
+    total += interval;
+    if (interval > 2 * 16667)
+      n_long++;
+  }
+
+  g_print ("frame interval:         mean %6.2f ms, p50 %6.2f ms, p90 %6.2f ms, "
+           "p99 %6.2f ms, max %6.2f ms\n",
+           total / 1000.0 / intervals->len,
+           percentile (intervals, 50), percentile (intervals, 90),
+           percentile (intervals, 99),
+           g_array_index (intervals, gint64, intervals->len - 1) / 1000.0);
+  g_print ("frames over 33 ms:      %u (%.1f%%)\n", n_long,
+           100.0 * n_long / intervals->len);
+  g_print ("last key to results:    %.2f ms\n",
+           (bench->done - bench->last_key) / 1000.0);
+}
+
+int
+main (int argc, char **argv)
+{
+  const gchar *mode = argc > 2 ? argv[2] : "chunked";
+  guint n_rows = argc > 1 ? atoi (argv[1]) :
+    strcmp (mode, "threaded") == 0 ? 200000 : 100000;
+  Bench bench = { 0, };
+  GtkListStore *store;
+  GtkWidget *window, *scrolled_window, *tree_view;
+
+  if (!gtk_init_check (&argc, &argv)) {
+    g_printerr ("No display, run under xvfb-run\n");
+    return 77;
+  }
+
+  store = create_store (n_rows);
+  bench.filter = gtk_tree_model_filter_new (GTK_TREE_MODEL (store), NULL);
+  bench.n_expected = count_matching (GTK_TREE_MODEL (store), QUERY);
+  bench.intervals = g_array_new (FALSE, FALSE, sizeof (gint64));
+
+  bench.livesearch = HILDON_LIVE_SEARCH (hildon_live_search_new ());
+  g_object_ref_sink (bench.livesearch);
+  hildon_live_search_set_filter (bench.livesearch,
+                                 GTK_TREE_MODEL_FILTER (bench.filter));
+  hildon_live_search_set_text_column (bench.livesearch, 0);
+
+  if (strcmp (mode, "chunked") == 0) {
+    hildon_live_search_set_chunked (bench.livesearch, TRUE);
+  } else if (strcmp (mode, "threaded") == 0) {
+    hildon_live_search_set_match_column (bench.livesearch, 0);
+  } else if (strcmp (mode, "blocking") != 0) {
+    g_printerr ("Unknown mode %s\n", mode);
+    return 1;
+  }
+
+  window = gtk_offscreen_window_new ();
+  scrolled_window = gtk_scrolled_window_new (NULL, NULL);
+  tree_view = gtk_tree_view_new_with_model (bench.filter);
+  gtk_tree_view_insert_column_with_attributes (GTK_TREE_VIEW (tree_view),
+                                               0, "Column 0",
+                                               gtk_cell_renderer_text_new (),
+                                               "text", 0,
+                                               NULL);
+  gtk_widget_set_size_request (scrolled_window, 480, 800);
+  gtk_container_add (GTK_CONTAINER (scrolled_window), tree_view);
+  gtk_container_add (GTK_CONTAINER (window), scrolled_window);
+  gtk_widget_show_all (window);
+
+  gtk_widget_add_tick_callback (tree_view, tick, &bench, NULL);
+
+  /* Let the window be drawn once before typing */
+  g_timeout_add (500, start, &bench);
+  g_timeout_add_seconds (TIMEOUT, timeout, &bench);
+
+  gtk_main ();
+
+  g_print ("%u rows, %s, query \"%s\", %d rows found\n",
+           n_rows, mode, QUERY, bench.n_expected);
+  report (&bench);
+
+  gtk_widget_destroy (window);
+  gtk_widget_destroy (GTK_WIDGET (bench.livesearch));
+  g_object_unref (bench.livesearch);
+  g_object_unref (bench.filter);
+  g_object_unref (store);
+  g_array_free (bench.intervals, TRUE);
+
+  return bench.failed || bench.done == 0;
+}
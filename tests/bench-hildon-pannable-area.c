@@ -0,0 +1,274 @@
+/*
+ * This file is a part of hildon tests
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+/*
+ * Benchmark of the panning of HildonPannableArea. A list like the one
+ * of hildon-pannable-area-touch-list-example is put in an offscreen
+ * window, and flung up and down with synthesized pointer events. The
+ * timings of the frames are then read with
+ * hildon_pannable_area_get_stats().
+ *
+ * It still needs a display, use xvfb-run to run it headless.
+ *
+ * Usage: bench-hildon-pannable-area [number of rows] [flings]
+ */
+
+#include <stdlib.h>
+#include <gtk/gtk.h>
+#include <hildon/hildon.h>
+
+/* A fling is a press, FLING_MOTIONS motions FLING_STEP pixels apart
+   every FLING_INTERVAL milliseconds, and a release */
+#define FLING_MOTIONS 6
+#define FLING_STEP 50
+#define FLING_INTERVAL 16
+#define FLING_X 240
+#define FLING_Y 400
+#define TIMEOUT 120
+
+typedef struct {
+  GtkWidget *area;
+  GtkWidget *tree_view;
+  guint n_flings;
+  guint fling;
+  gint step;
+  gint direction;
+  gboolean released;
+  gboolean failed;
+} Bench;
+
+static GtkWidget *
+create_tree_view (guint n_rows)
+{
+  GtkWidget *tree_view;
+  GtkCellRenderer *renderer;
+  GtkListStore *store;
+  guint i;
+
+  store = gtk_list_store_new (1, G_TYPE_STRING);
+  for (i = 0; i < n_rows; i++) {
+    gchar *str = g_strdup_printf ("\nRow %u\n", i);
+
+    gtk_list_store_insert_with_values (store, NULL, i, 0, str, -1);
+    g_free (str);
+  }
+
+  tree_view = gtk_tree_view_new_with_model (GTK_TREE_MODEL (store));
+  g_object_unref (store);
+
+  renderer = gtk_cell_renderer_text_new ();
+  g_object_set (renderer,
+                "xalign", 0.5,
+                "weight", PANGO_WEIGHT_BOLD,
+                NULL);
+  gtk_tree_view_insert_column_with_attributes (GTK_TREE_VIEW (tree_view),
+                                               0, "Column 0",
+                                               renderer,
+                                               "text", 0,
+                                               NULL);
+
+  return tree_view;
+}
+
+/* Sends an event at (@x, @y) of the area, to the window of the tree
+   view below it, as the windowing system would */
+static void
+send_event (Bench *bench, GdkEventType type, gdouble x, gdouble y)
+{
+  GdkWindow *window, *toplevel, *parent;
+  GdkDevice *pointer;
+  GdkEvent *event;
+  gdouble wx = x, wy = y;
+
+  window = gtk_tree_view_get_bin_window (GTK_TREE_VIEW (bench->tree_view));
+  toplevel = gtk_widget_get_window (gtk_widget_get_toplevel (bench->area));
+  for (parent = window; parent && parent != toplevel; parent = gdk_window_get_parent (parent)) {
+    gint px, py;
+
+    gdk_window_get_position (parent, &px, &py);
+    wx -= px;
+    wy -= py;
+  }
+
+  pointer = gdk_seat_get_pointer (gdk_display_get_default_seat (gdk_display_get_default ()));
+
+  event = gdk_event_new (type);
+  if (type == GDK_MOTION_NOTIFY) {
+    event->motion.window = g_object_ref (window);
+    event->motion.time = g_get_monotonic_time () / 1000;
+    event->motion.x = wx;
+    event->motion.y = wy;
+    event->motion.x_root = x;
+    event->motion.y_root = y;
+    event->motion.state = GDK_BUTTON1_MASK;
+  } else {
+    event->button.window = g_object_ref (window);
+    event->button.time = g_get_monotonic_time () / 1000;
+    event->button.x = wx;
+    event->button.y = wy;
+    event->button.x_root = x;
+    event->button.y_root = y;
+    event->button.button = 1;
+    event->button.state = type == GDK_BUTTON_RELEASE ? GDK_BUTTON1_MASK : 0;
+  }
+  gdk_event_set_device (event, pointer);
+  gdk_event_set_source_device (event, pointer);
+
+  gtk_main_do_event (event);
+  gdk_event_free (event);
+}
+
+static gboolean
+fling_step (gpointer data)
+{
+  Bench *bench = data;
+  gdouble y;
+
+  if (bench->step == 0) {
+    GtkAdjustment *vadj = gtk_scrolled_window_get_vadjustment (GTK_SCROLLED_WINDOW (bench->area));
+
+    /* Fling back up from the lower half of the list */
+    bench->direction = gtk_adjustment_get_value (vadj) >
+      (gtk_adjustment_get_upper (vadj) - gtk_adjustment_get_page_size (vadj)) / 2 ? 1 : -1;
+    bench->released = FALSE;
+    send_event (bench, GDK_BUTTON_PRESS, FLING_X, FLING_Y);
+    bench->step++;
+    return TRUE;
+  }
+
+  y = FLING_Y + bench->direction * MIN (bench->step, FLING_MOTIONS) * FLING_STEP;
+
+  if (bench->step <= FLING_MOTIONS) {
+    send_event (bench, GDK_MOTION_NOTIFY, FLING_X, y);
+    bench->step++;
+    return TRUE;
+  }
+
+  bench->released = TRUE;
+  send_event (bench, GDK_BUTTON_RELEASE, FLING_X, y);
+
+  /* The release might not start any movement */
+  if (!hildon_pannable_area_get_is_panning (HILDON_PANNABLE_AREA (bench->area))) {
+    g_printerr ("Fling %u did not move the area\n", bench->fling);
+    bench->failed = TRUE;
+    gtk_main_quit ();
+  }
+
+  return FALSE;
+}
+
+static void
+panning_finished (HildonPannableArea *area, Bench *bench)
+{
+  if (!bench->released)
+    return;
+
+  bench->released = FALSE;
+  bench->fling++;
+  bench->step = 0;
+
+  if (bench->fling < bench->n_flings)
+    g_timeout_add (FLING_INTERVAL, fling_step, bench);
+  else
+    gtk_main_quit ();
+}
+
+static gboolean
+start (gpointer data)
+{
+  g_timeout_add (FLING_INTERVAL, fling_step, data);
+  return FALSE;
+}
+
+static gboolean
+timeout (gpointer data)
+{
+  Bench *bench = data;
+
+  g_printerr ("Timed out after %u flings\n", bench->fling);
+  bench->failed = TRUE;
+  gtk_main_quit ();
+
+  return FALSE;
+}
+
+static void
+report (const HildonPannableAreaStats *stats)
+{
+  guint n = MAX (stats->n_frames, 1);
+
+  g_print ("frames:                 %u\n", stats->n_frames);
+  g_print ("dropped frames:         %u (%.1f%%)\n", stats->n_dropped_frames,
+           100.0 * stats->n_dropped_frames / (n + stats->n_dropped_frames));
+  g_print ("frame interval:         mean %6.2f ms, p50 %3" G_GINT64_FORMAT
+           " ms, p90 %3" G_GINT64_FORMAT " ms, p99 %3" G_GINT64_FORMAT
+           " ms, max %6.2f ms\n",
+           stats->total_frame_interval / 1000.0 / n,
+           hildon_pannable_area_stats_get_frame_interval_percentile (stats, 50) / 1000,
+           hildon_pannable_area_stats_get_frame_interval_percentile (stats, 90) / 1000,
+           hildon_pannable_area_stats_get_frame_interval_percentile (stats, 99) / 1000,
+           stats->max_frame_interval / 1000.0);
+  g_print ("adjustment updates:     total %7.2f ms, max %6.2f ms\n",
+           stats->total_update_time / 1000.0, stats->max_update_time / 1000.0);
+  g_print ("draws:                  mean %6.2f ms, max %6.2f ms\n",
+           stats->total_draw_time / 1000.0 / n, stats->max_draw_time / 1000.0);
+}
+
+int
+main (int argc, char **argv)
+{
+  guint n_rows = argc > 1 ? atoi (argv[1]) : 1000;
+  Bench bench = { 0, };
+  HildonPannableAreaStats stats;
+  GtkWidget *window;
+
+  if (!gtk_init_check (&argc, &argv)) {
+    g_printerr ("No display, run under xvfb-run\n");
+    return 77;
+  }
+
+  bench.n_flings = argc > 2 ? atoi (argv[2]) : 20;
+
+  window = gtk_offscreen_window_new ();
+  bench.area = hildon_pannable_area_new ();
+  bench.tree_view = create_tree_view (n_rows);
+  gtk_widget_set_size_request (bench.area, 480, 800);
+  gtk_container_add (GTK_CONTAINER (bench.area), bench.tree_view);
+  gtk_container_add (GTK_CONTAINER (window), bench.area);
+  gtk_widget_show_all (window);
+
+  g_signal_connect (bench.area, "panning-finished",
+                    G_CALLBACK (panning_finished), &bench);
+
+  /* Let the window be drawn once before the first fling */
+  g_timeout_add (500, start, &bench);
+  g_timeout_add_seconds (TIMEOUT, timeout, &bench);
+
+  gtk_main ();
+
+  hildon_pannable_area_get_stats (HILDON_PANNABLE_AREA (bench.area), &stats);
+
+  g_print ("%u rows, %u flings\n", n_rows, bench.fling);
+  report (&stats);
+
+  gtk_widget_destroy (window);
+
+  return bench.failed || stats.n_frames == 0;
+}
@@ -0,0 +1,431 @@
+/*
+ * This file is a part of hildon tests
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+#include <stdlib.h>
+#include <check.h>
+#include "test_suites.h"
+#include "check_utils.h"
+#include "mock-compositor.h"
+#include <hildon/hildon.h>
+
+#define POSITION_MESSAGE "_HILDON_ANIMATION_CLIENT_MESSAGE_POSITION"
+#define ROTATION_MESSAGE "_HILDON_ANIMATION_CLIENT_MESSAGE_ROTATION"
+#define SCALE_MESSAGE    "_HILDON_ANIMATION_CLIENT_MESSAGE_SCALE"
+#define ANCHOR_MESSAGE   "_HILDON_ANIMATION_CLIENT_MESSAGE_ANCHOR"
+#define PARENT_MESSAGE   "_HILDON_ANIMATION_CLIENT_MESSAGE_PARENT"
+#define SHOW_MESSAGE     "_HILDON_ANIMATION_CLIENT_MESSAGE_SHOW"
+
+/* Long enough for a few frames and a remap under a loaded Xvfb */
+#define WAIT_MSECS 2000
+
+static MockCompositor *mc = NULL;
+static GtkWidget *window = NULL;
+static HildonAnimationActor *actor = NULL;
+
+static void
+fx_setup ()
+{
+    int argc = 0;
+
+    gtk_init (&argc, NULL);
+
+    mc = mock_compositor_new ();
+    fail_if (mc == NULL,
+             "hildon-animation-actor: Could not connect the mock compositor");
+
+    window = create_test_window ();
+    show_test_window (window);
+
+    actor = HILDON_ANIMATION_ACTOR (hildon_animation_actor_new ());
+    mock_compositor_manage (mc, GTK_WIDGET (actor));
+    hildon_animation_actor_set_parent (actor, GTK_WINDOW (window));
+    gtk_widget_show (GTK_WIDGET (actor));
+
+    mock_compositor_settle (mc);
+}
+
+static void
+fx_teardown ()
+{
+    gtk_widget_destroy (GTK_WIDGET (actor));
+    gtk_widget_destroy (window);
+    mock_compositor_free (mc);
+}
+
+/* Makes the actor ready and waits for the pending messages */
+static void
+make_ready ()
+{
+    mock_compositor_set_ready (mc, GTK_WIDGET (actor), MOCK_ANIMATION_ACTOR_READY);
+    fail_if (!mock_compositor_wait (mc, PARENT_MESSAGE, 1, WAIT_MSECS),
+             "hildon-animation-actor: The actor was not parented once ready");
+    mock_compositor_settle (mc);
+    mock_compositor_clear (mc);
+}
+
+static void
+on_timeline_finished (HildonAnimationActor *actor, gpointer data)
+{
+    guint *n_finished = data;
+
+    (*n_finished)++;
+}
+
+/* Runs the main loop until the timeline finished and its last
+   messages were received */
+static gboolean
+wait_finished (guint *n_finished)
+{
+    gint64 end = g_get_monotonic_time () + (gint64) WAIT_MSECS * 1000;
+
+    while (*n_finished == 0)
+      {
+        if (g_get_monotonic_time () > end)
+          return FALSE;
+
+        if (!g_main_context_iteration (NULL, FALSE))
+          g_usleep (1000);
+      }
+
+    mock_compositor_settle (mc);
+
+    return TRUE;
+}
+
+/**
+   Purpose: test that the messages are held back until the compositor
+   sets the ready property, and sent then.
+
+   Checks for:
+
+   - No message is sent before the window is ready.
+   - Once ready, the position set before is sent, along with the parent.
+*/
+START_TEST (test_hildon_animation_actor_ready)
+{
+    const MockMessage *message;
+
+    hildon_animation_actor_set_position (actor, 10, 20);
+    mock_compositor_settle (mc);
+
+    fail_if (mock_compositor_count (mc, NULL) != 0,
+             "hildon-animation-actor: %u messages sent before the actor was ready",
+             mock_compositor_count (mc, NULL));
+
+    mock_compositor_set_ready (mc, GTK_WIDGET (actor), MOCK_ANIMATION_ACTOR_READY);
+    fail_if (!mock_compositor_wait (mc, POSITION_MESSAGE, 1, WAIT_MSECS),
+             "hildon-animation-actor: The position was not sent once ready");
+    fail_if (!mock_compositor_wait (mc, PARENT_MESSAGE, 1, WAIT_MSECS),
+             "hildon-animation-actor: The parent was not sent once ready");
+
+    message = mock_compositor_last (mc, POSITION_MESSAGE);
+    fail_if (message->l[0] != 10 || message->l[1] != 20,
+             "hildon-animation-actor: Position sent as (%ld, %ld) instead of (10, 20)",
+             message->l[0], message->l[1]);
+}
+END_TEST
+
+/**
+   Purpose: test that updates made while frozen are sent once each.
+
+   Checks for:
+
+   - Nothing is sent while frozen.
+   - On thaw, one position message with the last position, and one
+     scale and one rotation message.
+   - The messages sent counter matches what the compositor received.
+*/
+START_TEST (test_hildon_animation_actor_freeze)
+{
+    const MockMessage *message;
+    guint sent;
+    gint i;
+
+    make_ready ();
+    sent = hildon_animation_actor_get_messages_sent (actor);
+
+    hildon_animation_actor_freeze_updates (actor);
+    for (i = 0; i < 5; i++)
+      {
+        hildon_animation_actor_set_position (actor, i, i * 2);
+        hildon_animation_actor_set_scale (actor, 1 + i, 1 + i);
+        hildon_animation_actor_set_rotation (actor, HILDON_AA_Z_AXIS, i, 0, 0, 0);
+      }
+    mock_compositor_settle (mc);
+
+    fail_if (mock_compositor_count (mc, NULL) != 0,
+             "hildon-animation-actor: %u messages sent while frozen",
+             mock_compositor_count (mc, NULL));
+
+    hildon_animation_actor_thaw_updates (actor);
+    mock_compositor_settle (mc);
+
+    fail_if (mock_compositor_count (mc, POSITION_MESSAGE) != 1 ||
+             mock_compositor_count (mc, SCALE_MESSAGE) != 1 ||
+             mock_compositor_count (mc, ROTATION_MESSAGE) != 1,
+             "hildon-animation-actor: Sent %u position, %u scale and %u rotation "
+             "messages instead of one each",
+             mock_compositor_count (mc, POSITION_MESSAGE),
+             mock_compositor_count (mc, SCALE_MESSAGE),
+             mock_compositor_count (mc, ROTATION_MESSAGE));
+
+    message = mock_compositor_last (mc, POSITION_MESSAGE);
+    fail_if (message->l[0] != 4 || message->l[1] != 8,
+             "hildon-animation-actor: Position sent as (%ld, %ld) instead of (4, 8)",
+             message->l[0], message->l[1]);
+
+    fail_if (hildon_animation_actor_get_messages_sent (actor) - sent !=
+             mock_compositor_count (mc, NULL),
+             "hildon-animation-actor: Counted %u messages, the compositor got %u",
+             hildon_animation_actor_get_messages_sent (actor) - sent,
+             mock_compositor_count (mc, NULL));
+}
+END_TEST
+
+/**
+   Purpose: test that the whole state is sent again when the compositor
+   restarts.
+
+   Checks for:
+
+   - After the ready property is set again, the anchor, position,
+     rotations, scale, parent and visibility are all sent.
+*/
+START_TEST (test_hildon_animation_actor_restart)
+{
+    const gchar *types[] = { ANCHOR_MESSAGE, POSITION_MESSAGE, ROTATION_MESSAGE,
+                             SCALE_MESSAGE, PARENT_MESSAGE, SHOW_MESSAGE };
+    guint i;
+
+    make_ready ();
+
+    mock_compositor_restart (mc, GTK_WIDGET (actor), MOCK_ANIMATION_ACTOR_READY);
+    fail_if (!mock_compositor_wait (mc, SHOW_MESSAGE, 1, WAIT_MSECS),
+             "hildon-animation-actor: Nothing was sent after a restart");
+    mock_compositor_settle (mc);
+
+    for (i = 0; i < G_N_ELEMENTS (types); i++)
+      fail_if (mock_compositor_count (mc, types[i]) == 0,
+               "hildon-animation-actor: %s was not sent after a restart", types[i]);
+
+    fail_if (mock_compositor_count (mc, ROTATION_MESSAGE) != 3,
+             "hildon-animation-actor: %u rotations sent after a restart instead of 3",
+             mock_compositor_count (mc, ROTATION_MESSAGE));
+}
+END_TEST
+
+/**
+   Purpose: test that in frame sync mode, the updates of a frame are
+   sent together on the next frame.
+
+   Checks for:
+
+   - Nothing is sent before the next frame.
+   - One position message with the last position is sent then.
+*/
+START_TEST (test_hildon_animation_actor_frame_sync)
+{
+    const MockMessage *message;
+    gint i;
+
+    make_ready ();
+    hildon_animation_actor_set_frame_sync (actor, TRUE);
+
+    for (i = 0; i < 5; i++)
+      hildon_animation_actor_set_position (actor, i, 0);
+
+    gdk_display_sync (gdk_display_get_default ());
+    XSync (mc->display, False);
+    mock_compositor_process (mc);
+    fail_if (mock_compositor_count (mc, NULL) != 0,
+             "hildon-animation-actor: Sent before the next frame");
+
+    fail_if (!mock_compositor_wait (mc, POSITION_MESSAGE, 1, WAIT_MSECS),
+             "hildon-animation-actor: The position was not sent on the next frame");
+    mock_compositor_settle (mc);
+
+    fail_if (mock_compositor_count (mc, POSITION_MESSAGE) != 1,
+             "hildon-animation-actor: %u position messages sent instead of one",
+             mock_compositor_count (mc, POSITION_MESSAGE));
+
+    message = mock_compositor_last (mc, POSITION_MESSAGE);
+    fail_if (message->l[0] != 4,
+             "hildon-animation-actor: X sent as %ld instead of 4", message->l[0]);
+}
+END_TEST
+
+/**
+   Purpose: test that the timeline sends the values of the easing curve
+   between two keyframes, and tells when it is done.
+
+   Checks for:
+
+   - X is sent growing from 0 to 500, never ahead of the quadratic
+     ease in curve for the time elapsed since the start, and with some
+     values between the keyframes.
+   - Y, which has no keyframes, is left alone.
+   - The timeline-finished signal is emitted once, after the last
+     keyframe was sent.
+*/
+START_TEST (test_hildon_animation_actor_timeline_easing)
+{
+    Atom position;
+    guint n_finished = 0;
+    guint n_between = 0;
+    glong last = 0;
+    gint64 start;
+    guint i;
+
+    make_ready ();
+    position = XInternAtom (mc->display, POSITION_MESSAGE, False);
+    g_signal_connect (actor, "timeline-finished",
+                      G_CALLBACK (on_timeline_finished), &n_finished);
+
+    hildon_animation_actor_add_keyframe (actor, HILDON_AA_PARAM_X, 500, 500,
+                                         HILDON_AA_EASE_IN_QUAD);
+    start = g_get_monotonic_time ();
+    hildon_animation_actor_start_timeline (actor, FALSE);
+
+    fail_if (!wait_finished (&n_finished),
+             "hildon-animation-actor: timeline-finished was not emitted");
+
+    for (i = 0; i < mc->messages->len; i++)
+      {
+        const MockMessage *message = &g_array_index (mc->messages, MockMessage, i);
+        gdouble elapsed = (message->time - start) / 1000.0;
+
+        if (message->type != position)
+          continue;
+
+        fail_if (message->l[0] < last,
+                 "hildon-animation-actor: X went back from %ld to %ld",
+                 last, message->l[0]);
+        fail_if (message->l[0] > elapsed * elapsed / 500 + 1,
+                 "hildon-animation-actor: X was %ld after %.0f ms, ahead of the curve",
+                 message->l[0], elapsed);
+        fail_if (message->l[1] != 0,
+                 "hildon-animation-actor: Y sent as %ld instead of 0", message->l[1]);
+
+        if (message->l[0] > 0 && message->l[0] < 500)
+          n_between++;
+        last = message->l[0];
+      }
+
+    fail_if (n_between == 0,
+             "hildon-animation-actor: No value between the keyframes was sent");
+    fail_if (last != 500,
+             "hildon-animation-actor: X ended at %ld instead of 500", last);
+    fail_if (n_finished != 1,
+             "hildon-animation-actor: timeline-finished emitted %u times instead of once",
+             n_finished);
+}
+END_TEST
+
+/**
+   Purpose: test that keyframes added while the timeline plays are only
+   used from the next start.
+
+   Checks for:
+
+   - A keyframe added before the one being played towards does not
+     change the running timeline: X grows to 300 and it finishes.
+   - Started again, the timeline goes through the added keyframe.
+*/
+START_TEST (test_hildon_animation_actor_timeline_add_while_playing)
+{
+    Atom position;
+    guint n_finished = 0;
+    glong last = 0;
+    glong lowest = G_MAXLONG;
+    guint i;
+
+    make_ready ();
+    position = XInternAtom (mc->display, POSITION_MESSAGE, False);
+    g_signal_connect (actor, "timeline-finished",
+                      G_CALLBACK (on_timeline_finished), &n_finished);
+
+    hildon_animation_actor_add_keyframe (actor, HILDON_AA_PARAM_X, 300, 300,
+                                         HILDON_AA_EASE_LINEAR);
+    hildon_animation_actor_start_timeline (actor, FALSE);
+    hildon_animation_actor_add_keyframe (actor, HILDON_AA_PARAM_X, 150, 0,
+                                         HILDON_AA_EASE_LINEAR);
+
+    fail_if (!wait_finished (&n_finished),
+             "hildon-animation-actor: timeline-finished was not emitted");
+
+    for (i = 0; i < mc->messages->len; i++)
+      {
+        const MockMessage *message = &g_array_index (mc->messages, MockMessage, i);
+
+        if (message->type != position)
+          continue;
+
+        fail_if (message->l[0] < last,
+                 "hildon-animation-actor: X went back from %ld to %ld "
+                 "for a keyframe added while playing", last, message->l[0]);
+        last = message->l[0];
+      }
+
+    fail_if (last != 300,
+             "hildon-animation-actor: X ended at %ld instead of 300", last);
+
+    mock_compositor_clear (mc);
+    n_finished = 0;
+    hildon_animation_actor_start_timeline (actor, FALSE);
+
+    fail_if (!wait_finished (&n_finished),
+             "hildon-animation-actor: timeline-finished was not emitted again");
+
+    for (i = 0; i < mc->messages->len; i++)
+      {
+        const MockMessage *message = &g_array_index (mc->messages, MockMessage, i);
+
+        if (message->type == position)
+          lowest = MIN (lowest, message->l[0]);
+      }
+
+    fail_if (lowest >= 300,
+             "hildon-animation-actor: The keyframe added while playing was not "
+             "used when started again");
+}
+END_TEST
+
+/* ---------- Suite creation ---------- */
+
+Suite *create_hildon_animation_actor_suite (void)
+{
+    Suite *s = suite_create ("HildonAnimationActor");
+
+    TCase *tc1 = tcase_create ("hildon_animation_actor_protocol");
+    tcase_add_checked_fixture (tc1, fx_setup, fx_teardown);
+    tcase_add_test (tc1, test_hildon_animation_actor_ready);
+    tcase_add_test (tc1, test_hildon_animation_actor_freeze);
+    tcase_add_test (tc1, test_hildon_animation_actor_restart);
+    tcase_add_test (tc1, test_hildon_animation_actor_frame_sync);
+    suite_add_tcase (s, tc1);
+
+    TCase *tc2 = tcase_create ("hildon_animation_actor_timeline");
+    tcase_add_checked_fixture (tc2, fx_setup, fx_teardown);
+    tcase_add_test (tc2, test_hildon_animation_actor_timeline_easing);
+    tcase_add_test (tc2, test_hildon_animation_actor_timeline_add_while_playing);
+    suite_add_tcase (s, tc2);
+
+    return s;
+}
@@ -0,0 +1,369 @@
+/*
+ * This file is a part of hildon tests
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <check.h>
+#include "test_suites.h"
+#include "check_utils.h"
+#include <hildon/hildon.h>
+
+/* The date arithmetic is internal to the library, check_test links
+   its convenience library */
+#include <hildon/hildon-calendar-dates.h>
+
+/* April 2009 starts on a Wednesday, so that March and May are shown
+   whatever the first day of the week */
+#define START_YEAR  2009
+#define START_MONTH 3
+
+static GtkWidget *window = NULL;
+static HildonCalendar *calendar = NULL;
+
+/* The months asked for, as "year-month", separated by commas */
+static GString *requests = NULL;
+
+static void
+details_request_func (HildonCalendar *calendar,
+                      guint           year,
+                      guint           month,
+                      gpointer        user_data)
+{
+    g_string_append_printf (requests, "%s%u-%u",
+                            requests->len ? "," : "", year, month);
+}
+
+static void
+fx_setup ()
+{
+    int argc = 0;
+
+    gtk_init (&argc, NULL);
+
+    requests = g_string_new (NULL);
+
+    window = gtk_offscreen_window_new ();
+    calendar = HILDON_CALENDAR (hildon_calendar_new ());
+    hildon_calendar_set_display_options (calendar,
+                                         HILDON_CALENDAR_SHOW_HEADING |
+                                         HILDON_CALENDAR_SHOW_DAY_NAMES |
+                                         HILDON_CALENDAR_SHOW_DETAILS);
+    hildon_calendar_select_month (calendar, START_MONTH, START_YEAR);
+    hildon_calendar_set_details_request_func (calendar, details_request_func,
+                                              NULL, NULL);
+    gtk_container_add (GTK_CONTAINER (window), GTK_WIDGET (calendar));
+    gtk_widget_show_all (window);
+}
+
+static void
+fx_teardown ()
+{
+    gtk_widget_destroy (window);
+    g_string_free (requests, TRUE);
+}
+
+static void
+run_pending ()
+{
+    guint i;
+
+    for (i = 0; i < 10000 && g_main_context_pending (NULL); i++)
+        g_main_context_iteration (NULL, FALSE);
+}
+
+/* Measures and draws the calendar, which asks for the details of the
+   days shown, then runs the requests queued. Returns the drawing. */
+static cairo_surface_t *
+render ()
+{
+    GtkAllocation allocation;
+    GtkRequisition requisition;
+    cairo_surface_t *surface;
+    cairo_t *cr;
+
+    run_pending ();
+
+    gtk_widget_get_preferred_size (GTK_WIDGET (calendar), &requisition, NULL);
+    gtk_widget_get_allocation (GTK_WIDGET (calendar), &allocation);
+    surface = cairo_image_surface_create (CAIRO_FORMAT_RGB24,
+                                          MAX (allocation.width, 1),
+                                          MAX (allocation.height, 1));
+    cr = cairo_create (surface);
+    gtk_widget_draw (GTK_WIDGET (calendar), cr);
+    cairo_destroy (cr);
+    cairo_surface_flush (surface);
+
+    run_pending ();
+
+    return surface;
+}
+
+static gboolean
+same_drawing (cairo_surface_t *a, cairo_surface_t *b)
+{
+    gint height = cairo_image_surface_get_height (a);
+
+    if (cairo_image_surface_get_width (a) != cairo_image_surface_get_width (b) ||
+        height != cairo_image_surface_get_height (b))
+        return FALSE;
+
+    return memcmp (cairo_image_surface_get_data (a),
+                   cairo_image_surface_get_data (b),
+                   cairo_image_surface_get_stride (a) * height) == 0;
+}
+
+static void
+check_requests (const gchar *what, const gchar *expected)
+{
+    fail_if (strcmp (requests->str, expected) != 0,
+             "hildon-calendar: Asked for %s %s instead of %s",
+             requests->str, what, expected);
+    g_string_truncate (requests, 0);
+}
+
+/* Gives the details of the months around START_MONTH, with a detail
+   for the first day of the current one if @detail is not NULL */
+static void
+answer_shown (const gchar *detail)
+{
+    const gchar *details[] = { detail };
+
+    hildon_calendar_set_month_details (calendar, START_YEAR, START_MONTH - 1, NULL, 0);
+    hildon_calendar_set_month_details (calendar, START_YEAR, START_MONTH,
+                                       details, detail ? 1 : 0);
+    hildon_calendar_set_month_details (calendar, START_YEAR, START_MONTH + 1, NULL, 0);
+}
+
+/**
+   Purpose: test that the days of a month whose details are on their
+   way show a placeholder, and the details once given.
+
+   Checks for:
+
+   - Once shown, the details of the previous, current and next months
+     are asked for, once each.
+   - Answering without details removes the placeholders.
+   - A detail given for a day is drawn.
+   - Months answered are not asked for again.
+*/
+START_TEST (test_hildon_calendar_details_placeholder)
+{
+    cairo_surface_t *pending, *empty, *detail;
+
+    pending = render ();
+    check_requests ("once shown", "2009-2,2009-3,2009-4");
+
+    answer_shown (NULL);
+    empty = render ();
+    fail_if (same_drawing (pending, empty),
+             "hildon-calendar: Nothing changed once the details were given");
+
+    answer_shown ("<b>Meeting</b>");
+    detail = render ();
+    fail_if (same_drawing (empty, detail),
+             "hildon-calendar: The detail given for a day was not drawn");
+
+    check_requests ("once answered", "");
+
+    cairo_surface_destroy (pending);
+    cairo_surface_destroy (empty);
+    cairo_surface_destroy (detail);
+}
+END_TEST
+
+/**
+   Purpose: test that invalidating days asks for their months again,
+   once for all the days invalidated together.
+
+   Checks for:
+
+   - Several days of two months invalidated at once make one request
+     for each month.
+   - Days of months not shown are not asked for.
+   - The old details are drawn until the new ones are given.
+*/
+START_TEST (test_hildon_calendar_details_batching)
+{
+    cairo_surface_t *before, *stale;
+
+    cairo_surface_destroy (render ());
+    answer_shown ("<b>Meeting</b>");
+    before = render ();
+    g_string_truncate (requests, 0);
+
+    hildon_calendar_invalidate_detail (calendar, START_YEAR, START_MONTH, 1);
+    hildon_calendar_invalidate_detail (calendar, START_YEAR, START_MONTH, 2);
+    hildon_calendar_invalidate_detail (calendar, START_YEAR, START_MONTH, 15);
+    hildon_calendar_invalidate_detail (calendar, START_YEAR, START_MONTH + 1, 2);
+    hildon_calendar_invalidate_detail (calendar, START_YEAR - 1, 0, 1);
+
+    stale = render ();
+    check_requests ("after invalidating days", "2009-3,2009-4");
+    fail_if (!same_drawing (before, stale),
+             "hildon-calendar: The old details were not drawn while asked again");
+
+    cairo_surface_destroy (before);
+    cairo_surface_destroy (stale);
+}
+END_TEST
+
+/**
+   Purpose: test that a month invalidated while its details are on
+   their way is asked for again once they arrive.
+
+   Checks for:
+
+   - The month is not asked for twice at the same time.
+   - It is asked for again once the first answer is given.
+*/
+START_TEST (test_hildon_calendar_details_stale_request)
+{
+    cairo_surface_destroy (render ());
+    check_requests ("once shown", "2009-2,2009-3,2009-4");
+
+    hildon_calendar_invalidate_detail (calendar, START_YEAR, START_MONTH, 10);
+    cairo_surface_destroy (render ());
+    check_requests ("while the details are on their way", "");
+
+    answer_shown (NULL);
+    cairo_surface_destroy (render ());
+    check_requests ("after the first answer", "2009-3");
+}
+END_TEST
+
+/**
+   Purpose: test that the details of months not shown for a while are
+   forgotten, even if they were never given.
+
+   Checks for:
+
+   - After going through 15 months without answering, details given
+     for the first months shown are ignored.
+   - Those months are asked for again when shown again.
+*/
+START_TEST (test_hildon_calendar_details_eviction)
+{
+    guint i;
+
+    for (i = 0; i < 15; i++)
+      {
+        hildon_calendar_select_month (calendar, (START_MONTH + i) % 12,
+                                      START_YEAR + (START_MONTH + i) / 12);
+        cairo_surface_destroy (render ());
+      }
+
+    fail_if (strncmp (requests->str, "2009-2,2009-3,2009-4,2009-5,", 28) != 0,
+             "hildon-calendar: Asked for %s while going through the months",
+             requests->str);
+    g_string_truncate (requests, 0);
+
+    /* Late answers for months already forgotten */
+    answer_shown ("<b>Meeting</b>");
+
+    hildon_calendar_select_month (calendar, START_MONTH, START_YEAR);
+    cairo_surface_destroy (render ());
+    check_requests ("when shown again", "2009-2,2009-3,2009-4");
+}
+END_TEST
+
+/* Compares the date arithmetic with GDateTime for @year-@mm-@dd */
+static void
+check_date (guint year, guint mm, guint dd)
+{
+    GDateTime *date = g_date_time_new_utc (year, mm, dd, 0, 0, 0);
+    gint64 days = g_date_time_to_unix (date) / (24 * 60 * 60);
+
+    fail_if (hildon_calendar_days_from_civil (year, mm, dd) != days,
+             "hildon-calendar: %u-%02u-%02u is %" G_GINT64_FORMAT
+             " days from the epoch instead of %" G_GINT64_FORMAT,
+             year, mm, dd, hildon_calendar_days_from_civil (year, mm, dd), days);
+    fail_if (hildon_calendar_day_of_week (year, mm, dd) !=
+             (guint) g_date_time_get_day_of_week (date),
+             "hildon-calendar: %u-%02u-%02u is day %u of the week instead of %d",
+             year, mm, dd, hildon_calendar_day_of_week (year, mm, dd),
+             g_date_time_get_day_of_week (date));
+    fail_if (hildon_calendar_week_of_year (year, mm, dd) !=
+             (guint) g_date_time_get_week_of_year (date),
+             "hildon-calendar: %u-%02u-%02u is in week %u instead of %d",
+             year, mm, dd, hildon_calendar_week_of_year (year, mm, dd),
+             g_date_time_get_week_of_year (date));
+
+    g_date_time_unref (date);
+}
+
+/**
+   Purpose: test that the days and weeks computed by the calendar are
+   the ones of GDateTime around the start of each year.
+
+   Checks for:
+
+   - From 1900 to 2100, the days from December 20 to January 10 are
+     as many days from the epoch, on the same day of the week and in
+     the same ISO 8601 week as GDateTime says.
+   - Week 53 ends in the next year, and January 1 to 3 can be in the
+     last week of the previous year or the first of the year.
+*/
+START_TEST (test_hildon_calendar_week_of_year)
+{
+    guint year, dd;
+
+    for (year = 1900; year < 2100; year++)
+      {
+        for (dd = 20; dd <= 31; dd++)
+          check_date (year, 12, dd);
+        for (dd = 1; dd <= 10; dd++)
+          check_date (year + 1, 1, dd);
+      }
+
+    /* 2020 has 53 weeks, the last one ending on January 3 */
+    fail_if (hildon_calendar_week_of_year (2020, 12, 31) != 53 ||
+             hildon_calendar_week_of_year (2021, 1, 3) != 53 ||
+             hildon_calendar_week_of_year (2021, 1, 4) != 1,
+             "hildon-calendar: Wrong weeks around the week 53 of 2020");
+
+    /* 2015 starts on a Thursday, in week 1, and 2008 ends in week 1 of
+       2009 */
+    fail_if (hildon_calendar_week_of_year (2015, 1, 1) != 1 ||
+             hildon_calendar_week_of_year (2008, 12, 29) != 1 ||
+             hildon_calendar_week_of_year (2010, 1, 1) != 53,
+             "hildon-calendar: Wrong weeks for the first days of a year");
+}
+END_TEST
+
+/* ---------- Suite creation ---------- */
+
+Suite *create_hildon_calendar_suite (void)
+{
+    Suite *s = suite_create ("HildonCalendar");
+
+    TCase *tc1 = tcase_create ("hildon_calendar_details_request");
+    tcase_add_checked_fixture (tc1, fx_setup, fx_teardown);
+    tcase_add_test (tc1, test_hildon_calendar_details_placeholder);
+    tcase_add_test (tc1, test_hildon_calendar_details_batching);
+    tcase_add_test (tc1, test_hildon_calendar_details_stale_request);
+    tcase_add_test (tc1, test_hildon_calendar_details_eviction);
+    suite_add_tcase (s, tc1);
+
+    TCase *tc2 = tcase_create ("hildon_calendar_dates");
+    tcase_add_test (tc2, test_hildon_calendar_week_of_year);
+    suite_add_tcase (s, tc2);
+
+    return s;
+}
@@ -0,0 +1,105 @@
+/*
+ * This file is a part of hildon tests
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+/* The color chooser is always built into the library, only its
+   header is hidden when deprecated widgets are disabled */
+#undef HILDON_DISABLE_DEPRECATED
+
+#include <stdlib.h>
+#include <string.h>
+#include <check.h>
+#include "test_suites.h"
+
+/* The rasterizers are internal to the library, check_test links
+   their convenience library */
+#include <hildon/hildon-color-chooser-private.h>
+
+/* ----- Test case for the SV plane rasterizer -----*/
+
+/* A pure hue, in the 24 bit channels of inline_h2rgb() */
+static void
+hue_to_rgb (guint hue, unsigned long *rgb)
+{
+  unsigned long ramp = (hue % 10922) * 6 * 256;
+
+  switch (hue / 10922) {
+  case 0: case 6: rgb[0] = 0xffffff; rgb[1] = ramp; rgb[2] = 0; break;
+  case 1: rgb[0] = 0xffffff - ramp; rgb[1] = 0xffffff; rgb[2] = 0; break;
+  case 2: rgb[0] = 0; rgb[1] = 0xffffff; rgb[2] = ramp; break;
+  case 3: rgb[0] = 0; rgb[1] = 0xffffff - ramp; rgb[2] = 0xffffff; break;
+  case 4: rgb[0] = ramp; rgb[1] = 0; rgb[2] = 0xffffff; break;
+  default: rgb[0] = 0xffffff; rgb[1] = 0; rgb[2] = 0xffffff - ramp; break;
+  }
+}
+
+/**
+ * Purpose: Check that the SIMD rasterizer of the SV plane gives the
+ * pixels of the scalar one
+ * Cases considered:
+ *    - Planes of 1x1, widths that are not a multiple of 4, and the size
+ *      of the large chooser, for hues all around the bar.
+ */
+START_TEST (test_sv_plane_raster_regular)
+{
+  static const gint sizes[][2] = { { 1, 1 }, { 3, 2 }, { 7, 9 }, { 64, 64 },
+                                   { 301, 199 }, { 460, 300 } };
+  guint i, hue;
+
+  for (i = 0; i < G_N_ELEMENTS (sizes); i++) {
+    gint w = sizes[i][0], h = sizes[i][1];
+    gint stride = cairo_format_stride_for_width (CAIRO_FORMAT_RGB24, w);
+    guchar *scalar = g_malloc0 (stride * h);
+    guchar *simd = g_malloc0 (stride * h);
+
+    for (hue = 0; hue < 0x10000; hue += 1021) {
+      unsigned long rgb[3];
+
+      hue_to_rgb (hue, rgb);
+
+      hildon_color_chooser_raster_sv_plane_scalar (rgb, scalar, stride, w, h);
+      hildon_color_chooser_raster_sv_plane (rgb, simd, stride, w, h);
+
+      fail_if (memcmp (scalar, simd, stride * h) != 0,
+               "hildon-color-chooser: The %ix%i SV plane of hue %u differs from the scalar one",
+               w, h, hue);
+
+      /* Black on the left, the top left pixel included */
+      fail_if ((((guint32 *) scalar)[0] & 0xffffff) != 0,
+               "hildon-color-chooser: The left of the SV plane of hue %u is not black", hue);
+    }
+
+    g_free (scalar);
+    g_free (simd);
+  }
+}
+END_TEST
+
+/* ---------- Suite creation ---------- */
+
+Suite *create_hildon_color_chooser_raster_suite (void)
+{
+  Suite *s = suite_create ("HildonColorChooserRaster");
+
+  TCase *tc1 = tcase_create ("sv_plane_raster");
+  tcase_add_test (tc1, test_sv_plane_raster_regular);
+  suite_add_tcase (s, tc1);
+
+  return s;
+}
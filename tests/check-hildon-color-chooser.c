@@ -254,7 +254,6 @@ START_TEST (test_set_color_invalid)
 }
 END_TEST
 
-
 /* ---------- Suite creation ---------- */
 
 Suite *create_hildon_color_chooser_suite()
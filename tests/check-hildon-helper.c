@@ -160,6 +160,146 @@ START_TEST (test_hildon_helper_set_logical_color_invalid)
 END_TEST
 
 
+/* ----- Test case for hildon_helper_smart_match -----*/
+
+/**
+ * Purpose: test matching the start of words in ASCII strings
+ * Cases considered:
+ *    - Match a word in the middle of the haystack, ignoring case
+ *    - Don't match in the middle of a word
+ *    - Match after punctuation and after non-ASCII characters
+ *    - Match past the first 16 bytes, and at the very end
+ *    - Don't match a needle longer than the rest of the haystack
+ *    - Match a needle starting with punctuation anywhere
+ */
+START_TEST (test_hildon_helper_smart_match_regular)
+{
+  const gchar *haystack;
+  const gchar *long_haystack = "Aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa Bcd Efgh";
+
+  haystack = "John Smith";
+  fail_if (hildon_helper_smart_match (haystack, "smi") != haystack + 5,
+           "hildon-helper: \"smi\" should match \"Smith\"");
+  fail_if (hildon_helper_smart_match ("Johnsmith", "smi") != NULL,
+           "hildon-helper: \"smi\" should not match in the middle of a word");
+
+  haystack = "A tool (abacus)";
+  fail_if (hildon_helper_smart_match (haystack, "ABA") != haystack + 8,
+           "hildon-helper: \"ABA\" should match \"abacus\"");
+  haystack = "Jos\xc3\xa9maria";
+  fail_if (hildon_helper_smart_match (haystack, "maria") != haystack + 5,
+           "hildon-helper: non-ASCII bytes should separate words");
+
+  fail_if (hildon_helper_smart_match (long_haystack, "bc") != long_haystack + 33,
+           "hildon-helper: \"bc\" should match past the first 16 bytes");
+  fail_if (hildon_helper_smart_match (long_haystack, "efgh") != long_haystack + 37,
+           "hildon-helper: \"efgh\" should match at the end");
+  fail_if (hildon_helper_smart_match (long_haystack, "efghi") != NULL,
+           "hildon-helper: \"efghi\" should not match");
+
+  haystack = "a-b";
+  fail_if (hildon_helper_smart_match (haystack, "-b") != haystack + 1,
+           "hildon-helper: \"-b\" should match anywhere");
+}
+END_TEST
+
+/**
+ * Purpose: test matching with invalid parameters
+ * Cases considered:
+ *    - NULL haystack, NULL needle, empty haystack
+ */
+START_TEST (test_hildon_helper_smart_match_invalid)
+{
+  fail_if (hildon_helper_smart_match (NULL, "a") != NULL,
+           "hildon-helper: a NULL haystack should not match");
+  fail_if (hildon_helper_smart_match ("a", NULL) != NULL,
+           "hildon-helper: a NULL needle should not match");
+  fail_if (hildon_helper_smart_match ("", "a") != NULL,
+           "hildon-helper: an empty haystack should not match");
+}
+END_TEST
+
+/* ----- Test case for hildon_helper_utf8_strstrcasedecomp_needle_stripped -----*/
+
+static const gchar *
+strstrcasedecomp (const gchar *haystack, const gchar *needle)
+{
+  gunichar *nuni = hildon_helper_strip_string (needle);
+  const gchar *result;
+
+  result = hildon_helper_utf8_strstrcasedecomp_needle_stripped (haystack, nuni);
+  g_free (nuni);
+
+  return result;
+}
+
+/**
+ * Purpose: test matching the start of words regardless of case and accents
+ * Cases considered:
+ *    - Match accented words with an ASCII needle
+ *    - Match ASCII words after non-ASCII characters
+ *    - Don't match in the middle of a word containing accents
+ *    - Match a word in a long ASCII haystack
+ *    - Match a word starting right after the ASCII characters
+ */
+START_TEST (test_hildon_helper_strstrcasedecomp_regular)
+{
+  const gchar *haystack;
+
+  haystack = "\xc3\x81ngel Garc\xc3\xad" "a";
+  fail_if (strstrcasedecomp (haystack, "garc") != haystack + 7,
+           "hildon-helper: \"garc\" should match \"Garc\303\255a\"");
+  fail_if (strstrcasedecomp (haystack, "ANGEL") != haystack,
+           "hildon-helper: \"ANGEL\" should match \"\303\201ngel\"");
+
+  haystack = "Ren\xc3\xa9" "e Smith";
+  fail_if (strstrcasedecomp (haystack, "smith") != haystack + 7,
+           "hildon-helper: \"smith\" should match after accents");
+  fail_if (strstrcasedecomp ("Jos\xc3\xa9" "fina", "fina") != NULL,
+           "hildon-helper: \"fina\" should not match in the middle of a word");
+
+  haystack = "Some quite long contact name: Zimmermann";
+  fail_if (strstrcasedecomp (haystack, "zimm") != haystack + 30,
+           "hildon-helper: \"zimm\" should match \"Zimmermann\"");
+
+  haystack = "Ann \xc3\x89va";
+  fail_if (strstrcasedecomp (haystack, "eva") != haystack + 4,
+           "hildon-helper: \"eva\" should match \"\303\211va\"");
+}
+END_TEST
+
+
+/**
+ * Purpose: test stripping case and accents from a string
+ * Cases considered:
+ *    - Strip Latin, Greek and Cyrillic letters, keeping spaces and digits
+ *    - Strip a string twice, to use the cached stripped characters
+ */
+START_TEST (test_hildon_helper_strip_string_regular)
+{
+  /* "Ángel Ωμέγα Ёж 42" */
+  const gchar *string = "\xc3\x81ngel \xce\xa9\xce\xbc\xce\xad\xce\xb3\xce\xb1 \xd0\x81\xd0\xb6 42";
+  const gunichar expected[] = { 'a', 'n', 'g', 'e', 'l', ' ',
+                                0x3c9, 0x3bc, 0x3b5, 0x3b3, 0x3b1, ' ',
+                                0x435, 0x436, ' ', '4', '2', 0 };
+  gint round, i;
+
+  for (round = 0; round < 2; round++) {
+    gunichar *stripped = hildon_helper_strip_string (string);
+
+    for (i = 0; expected[i] != 0; i++)
+      fail_if (stripped[i] != expected[i],
+               "hildon-helper: character %d was stripped to U+%04X instead of U+%04X",
+               i, stripped[i], expected[i]);
+    fail_if (stripped[i] != 0,
+             "hildon-helper: the stripped string is too long");
+
+    g_free (stripped);
+  }
+}
+END_TEST
+
+
 
 /* ---------- Suite creation ---------- */
 
@@ -171,6 +311,9 @@ Suite *create_hildon_helper_suite()
   /* Create test cases */
   TCase *tc1 = tcase_create("hildon_helper_set_logical_font");
   TCase *tc2 = tcase_create("hildon_helper_set_logical_color");
+  TCase *tc3 = tcase_create("hildon_helper_smart_match");
+  TCase *tc4 = tcase_create("hildon_helper_utf8_strstrcasedecomp_needle_stripped");
+  TCase *tc5 = tcase_create("hildon_helper_strip_string");
 
   /* Create test case for set_logical_font and add it to the suite */
   tcase_add_checked_fixture(tc1, fx_setup_default_helper, fx_teardown_default_helper);
@@ -184,6 +327,22 @@ Suite *create_hildon_helper_suite()
   tcase_add_test(tc2, test_hildon_helper_set_logical_color_invalid);
   suite_add_tcase (s, tc2);
 
+  /* Create test case for smart_match and add it to the suite */
+  tcase_add_checked_fixture(tc3, fx_setup_default_helper, fx_teardown_default_helper);
+  tcase_add_test(tc3, test_hildon_helper_smart_match_regular);
+  tcase_add_test(tc3, test_hildon_helper_smart_match_invalid);
+  suite_add_tcase (s, tc3);
+
+  /* Create test case for utf8_strstrcasedecomp_needle_stripped and add it to the suite */
+  tcase_add_checked_fixture(tc4, fx_setup_default_helper, fx_teardown_default_helper);
+  tcase_add_test(tc4, test_hildon_helper_strstrcasedecomp_regular);
+  suite_add_tcase (s, tc4);
+
+  /* Create test case for strip_string and add it to the suite */
+  tcase_add_checked_fixture(tc5, fx_setup_default_helper, fx_teardown_default_helper);
+  tcase_add_test(tc5, test_hildon_helper_strip_string_regular);
+  suite_add_tcase (s, tc5);
+
   /* Return created suite */
   return s;             
 }
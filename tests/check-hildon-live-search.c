@@ -0,0 +1,924 @@
+/*
+ * This file is a part of hildon tests
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <check.h>
+#include "test_suites.h"
+#include "check_utils.h"
+#include <hildon/hildon.h>
+
+/* Rows are "apple N", "avocado N" and "banana N", in turn */
+#define N_ROWS 3000
+
+/* Long enough for a threaded match under a loaded machine */
+#define WAIT_MSECS 5000
+
+static HildonLiveSearch *livesearch = NULL;
+static GtkListStore *store = NULL;
+static GtkTreeModel *filter = NULL;
+
+/* Matches on the main thread, for comparison */
+static HildonLiveSearch *reference = NULL;
+static GtkTreeModel *reference_filter = NULL;
+
+static GtkWidget *tree_view = NULL;
+
+static guint n_tested = 0;
+static guint n_store_changed = 0;
+static guint n_filter_deleted = 0;
+static gchar *tested_text = NULL;
+static guint n_tested_texts = 0;
+
+static const gchar *fruits[] = { "apple", "avocado", "banana" };
+
+/* Rows for the ranked tests, none in the order of their match of
+   "note" */
+static const gchar *notes[] = {
+    "Banana",           /* no match */
+    "Nute light",       /* typo */
+    "Northern tale",    /* subsequence */
+    "Keynote",          /* in the middle of a word */
+    "My notes",         /* at the start of a word */
+    "Notepad",          /* at the start */
+    "Notebook"          /* at the start, after an equal match */
+};
+
+#define NOTE_RANKED "Notepad,Notebook,My notes,Keynote,Northern tale,Nute light"
+
+static void
+fx_setup ()
+{
+    int argc = 0;
+    guint i;
+
+    gtk_init (&argc, NULL);
+
+    store = gtk_list_store_new (2, G_TYPE_STRING, G_TYPE_INT);
+    for (i = 0; i < N_ROWS; i++) {
+        gchar *name = g_strdup_printf ("%s %u", fruits[i % 3], i);
+
+        gtk_list_store_insert_with_values (store, NULL, i, 0, name, 1, i, -1);
+        g_free (name);
+    }
+
+    filter = gtk_tree_model_filter_new (GTK_TREE_MODEL (store), NULL);
+
+    livesearch = HILDON_LIVE_SEARCH (hildon_live_search_new ());
+    g_object_ref_sink (livesearch);
+    hildon_live_search_set_filter (livesearch, GTK_TREE_MODEL_FILTER (filter));
+
+    n_tested = 0;
+    n_store_changed = 0;
+    n_filter_deleted = 0;
+    tested_text = NULL;
+    n_tested_texts = 0;
+}
+
+static void
+fx_teardown ()
+{
+    gtk_widget_destroy (GTK_WIDGET (livesearch));
+    g_object_unref (livesearch);
+    g_object_unref (filter);
+    g_object_unref (store);
+    g_free (tested_text);
+}
+
+static void
+fx_setup_ranked ()
+{
+    int argc = 0;
+    guint i;
+
+    gtk_init (&argc, NULL);
+
+    store = gtk_list_store_new (2, G_TYPE_STRING, G_TYPE_INT);
+    for (i = 0; i < G_N_ELEMENTS (notes); i++)
+        gtk_list_store_insert_with_values (store, NULL, i, 0, notes[i], 1, i, -1);
+
+    filter = gtk_tree_model_filter_new (GTK_TREE_MODEL (store), NULL);
+
+    livesearch = HILDON_LIVE_SEARCH (hildon_live_search_new ());
+    g_object_ref_sink (livesearch);
+    hildon_live_search_set_filter (livesearch, GTK_TREE_MODEL_FILTER (filter));
+    hildon_live_search_set_match_column (livesearch, 0);
+    hildon_live_search_set_ranked (livesearch, TRUE);
+
+    tested_text = NULL;
+}
+
+static void
+fx_setup_threaded ()
+{
+    fx_setup ();
+
+    hildon_live_search_set_match_column (livesearch, 0);
+    hildon_live_search_set_match_threads (livesearch, 4);
+
+    reference_filter = gtk_tree_model_filter_new (GTK_TREE_MODEL (store), NULL);
+    reference = HILDON_LIVE_SEARCH (hildon_live_search_new ());
+    g_object_ref_sink (reference);
+    hildon_live_search_set_filter (reference,
+                                   GTK_TREE_MODEL_FILTER (reference_filter));
+    hildon_live_search_set_match_column (reference, 0);
+}
+
+static void
+fx_teardown_threaded ()
+{
+    gtk_widget_destroy (GTK_WIDGET (reference));
+    g_object_unref (reference);
+    g_object_unref (reference_filter);
+
+    fx_teardown ();
+}
+
+/* Prefix test on the name, slow enough for a pass over N_ROWS rows
+   to take several slices */
+static gboolean
+slow_visible_func (GtkTreeModel *model,
+                   GtkTreeIter  *iter,
+                   gchar        *text,
+                   gpointer      data)
+{
+    gchar *name;
+    gboolean visible;
+
+    n_tested++;
+    if (tested_text == NULL || strcmp (tested_text, text) != 0) {
+        g_free (tested_text);
+        tested_text = g_strdup (text);
+        n_tested_texts++;
+    }
+
+    g_usleep (10);
+
+    gtk_tree_model_get (model, iter, 0, &name, -1);
+    visible = g_str_has_prefix (name, text);
+    g_free (name);
+
+    return visible;
+}
+
+static void
+on_store_row_changed (GtkTreeModel *model,
+                      GtkTreePath  *path,
+                      GtkTreeIter  *iter,
+                      gpointer      data)
+{
+    n_store_changed++;
+}
+
+static void
+on_filter_row_deleted (GtkTreeModel *model,
+                       GtkTreePath  *path,
+                       gpointer      data)
+{
+    n_filter_deleted++;
+}
+
+static gint
+count_visible ()
+{
+    return gtk_tree_model_iter_n_children (filter, NULL);
+}
+
+/* Returns whether every visible row starts with @prefix */
+static gboolean
+all_visible_start_with (const gchar *prefix)
+{
+    GtkTreeIter iter;
+    gboolean valid;
+
+    for (valid = gtk_tree_model_get_iter_first (filter, &iter);
+         valid;
+         valid = gtk_tree_model_iter_next (filter, &iter)) {
+        gchar *name;
+        gboolean match;
+
+        gtk_tree_model_get (filter, &iter, 0, &name, -1);
+        match = g_str_has_prefix (name, prefix);
+        g_free (name);
+
+        if (!match)
+            return FALSE;
+    }
+
+    return TRUE;
+}
+
+/* Runs the main loop until at least one more row was tested */
+static void
+run_slice ()
+{
+    guint n = n_tested;
+    guint i;
+
+    for (i = 0; i < 1000 && n_tested == n; i++)
+        g_main_context_iteration (NULL, TRUE);
+}
+
+static void
+run_pending ()
+{
+    guint i;
+
+    /* Bounded, so that a pass which never ends shows as a failure
+       rather than a hang */
+    for (i = 0; i < 10000 && g_main_context_pending (NULL); i++)
+        g_main_context_iteration (NULL, FALSE);
+}
+
+static void
+setup_chunked ()
+{
+    hildon_live_search_set_visible_func (livesearch, slow_visible_func,
+                                         NULL, NULL);
+    hildon_live_search_set_chunked (livesearch, TRUE);
+
+    g_signal_connect (store, "row-changed",
+                      G_CALLBACK (on_store_row_changed), NULL);
+    g_signal_connect (filter, "row-deleted",
+                      G_CALLBACK (on_filter_row_deleted), NULL);
+
+    fail_if (count_visible () != N_ROWS,
+             "hildon-live-search: %d rows visible without text instead of %d",
+             count_visible (), N_ROWS);
+}
+
+/**
+   Purpose: test that a chunked refilter shows the results of each
+   slice as soon as it is done.
+
+   Checks for:
+
+   - Typing a character doesn't filter anything right away.
+   - After the first slice, only some of the rows are tested, and the
+     rows found hidden so far are removed from the filter.
+   - Once done, exactly the rows matching the text are visible.
+   - Nothing else listening to the child model sees the rows being
+     published.
+*/
+START_TEST (test_hildon_live_search_chunked_partial_results)
+{
+    setup_chunked ();
+
+    hildon_live_search_append_text (livesearch, "a");
+    fail_if (n_tested != 0,
+             "hildon-live-search: %u rows tested before the first slice",
+             n_tested);
+
+    run_slice ();
+    fail_if (n_tested == 0 || n_tested >= N_ROWS,
+             "hildon-live-search: %u rows tested by the first slice", n_tested);
+    fail_if (n_filter_deleted == 0,
+             "hildon-live-search: Nothing published by the first slice");
+    fail_if (n_filter_deleted >= N_ROWS / 3,
+             "hildon-live-search: %u rows hidden by the first slice",
+             n_filter_deleted);
+    fail_if (count_visible () != N_ROWS - (gint) n_filter_deleted,
+             "hildon-live-search: %d rows visible after hiding %u",
+             count_visible (), n_filter_deleted);
+
+    run_pending ();
+    fail_if (count_visible () != 2 * N_ROWS / 3,
+             "hildon-live-search: %d rows visible for \"a\" instead of %d",
+             count_visible (), 2 * N_ROWS / 3);
+    fail_if (!all_visible_start_with ("a"),
+             "hildon-live-search: A row not matching \"a\" is visible");
+    fail_if (n_store_changed != 0,
+             "hildon-live-search: %u row-changed seen on the child model",
+             n_store_changed);
+}
+END_TEST
+
+/**
+   Purpose: test that more text cancels the chunked refilter in
+   progress.
+
+   Checks for:
+
+   - No row is tested for the previous text once the new one is typed.
+   - The rows published for the cancelled text are filtered again, so
+     that once done, exactly the rows matching the new text are visible.
+*/
+START_TEST (test_hildon_live_search_chunked_cancel)
+{
+    setup_chunked ();
+
+    hildon_live_search_append_text (livesearch, "a");
+    run_slice ();
+    fail_if (n_filter_deleted == 0,
+             "hildon-live-search: Nothing published by the first slice");
+
+    hildon_live_search_append_text (livesearch, "v");
+    run_pending ();
+    fail_if (n_tested_texts != 2 || strcmp (tested_text, "av") != 0,
+             "hildon-live-search: Rows tested for \"a\" after typing \"av\"");
+    fail_if (count_visible () != N_ROWS / 3,
+             "hildon-live-search: %d rows visible for \"av\" instead of %d",
+             count_visible (), N_ROWS / 3);
+    fail_if (!all_visible_start_with ("avocado"),
+             "hildon-live-search: A row not matching \"av\" is visible");
+}
+END_TEST
+
+/* Returns the ids of the rows visible in @model, separated by commas */
+static gchar *
+get_visible_ids (GtkTreeModel *model)
+{
+    GString *ids = g_string_new (NULL);
+    GtkTreeIter iter;
+    gboolean valid;
+
+    for (valid = gtk_tree_model_get_iter_first (model, &iter);
+         valid;
+         valid = gtk_tree_model_iter_next (model, &iter)) {
+        gint id;
+
+        gtk_tree_model_get (model, &iter, 1, &id, -1);
+        g_string_append_printf (ids, "%d,", id);
+    }
+
+    return g_string_free (ids, FALSE);
+}
+
+/* Returns whether the filter shows the rows that @text shows when
+   matched on the main thread */
+static gboolean
+same_as_reference (const gchar *text)
+{
+    gchar *ids, *expected;
+    gboolean same;
+
+    hildon_live_search_set_text (reference, text);
+
+    ids = get_visible_ids (filter);
+    expected = get_visible_ids (reference_filter);
+    same = strcmp (ids, expected) == 0;
+    g_free (ids);
+    g_free (expected);
+
+    return same;
+}
+
+/* Runs the main loop until the filter shows the rows of @text, or
+   for WAIT_MSECS */
+static gboolean
+wait_matched (const gchar *text)
+{
+    gint64 end = g_get_monotonic_time () + WAIT_MSECS * 1000;
+
+    while (!same_as_reference (text) && g_get_monotonic_time () < end) {
+        run_pending ();
+        g_usleep (1000);
+    }
+
+    return same_as_reference (text);
+}
+
+/* Runs the main loop for @msecs, letting the worker threads finish */
+static void
+run_for (guint msecs)
+{
+    gint64 end = g_get_monotonic_time () + msecs * 1000;
+
+    while (g_get_monotonic_time () < end) {
+        run_pending ();
+        g_usleep (1000);
+    }
+}
+
+/**
+   Purpose: test that matching in worker threads shows the same rows as
+   matching on the main thread.
+
+   Checks for:
+
+   - Nothing is filtered until the job is handed back to the main loop.
+   - Once done, each text shows the rows that a synchronous live search
+     shows for it, including when the text grows and only the rows
+     visible before are matched again.
+*/
+START_TEST (test_hildon_live_search_threaded_matches)
+{
+    const gchar *texts[] = { "a", "av", "avocado 1", "avocado 12 b" };
+    GString *text = g_string_new (NULL);
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS (texts); i++) {
+        hildon_live_search_append_text (livesearch, texts[i] + text->len);
+        g_string_assign (text, texts[i]);
+
+        if (i == 0)
+            fail_if (count_visible () != N_ROWS,
+                     "hildon-live-search: Rows hidden before the threads were done");
+
+        fail_if (!wait_matched (text->str),
+                 "hildon-live-search: \"%s\" shows other rows than when matched "
+                 "on the main thread", text->str);
+    }
+
+    g_string_free (text, TRUE);
+}
+END_TEST
+
+/**
+   Purpose: test that changing the text cancels the threaded match in
+   progress.
+
+   Checks for:
+
+   - After "b" is typed, then replaced by "a", only the rows matching
+     "a" are visible, even once the threads matching "b" are done.
+*/
+START_TEST (test_hildon_live_search_threaded_cancel)
+{
+    hildon_live_search_append_text (livesearch, "b");
+    hildon_live_search_set_text (livesearch, "a");
+    run_for (200);
+
+    fail_if (!same_as_reference ("a"),
+             "hildon-live-search: The match of a replaced text was shown");
+    fail_if (!all_visible_start_with ("a"),
+             "hildon-live-search: A row not matching \"a\" is visible");
+}
+END_TEST
+
+/**
+   Purpose: test that rows changed while the worker threads match are
+   matched with their new contents.
+
+   Checks for:
+
+   - Rows changed, inserted and removed after the text is typed, but
+     before the threads are done, show as a synchronous live search
+     shows them.
+*/
+START_TEST (test_hildon_live_search_threaded_model_changes)
+{
+    GtkTreeIter iter;
+
+    hildon_live_search_append_text (livesearch, "a");
+
+    /* "apple 0" and "banana 2" swap their fruits */
+    gtk_tree_model_iter_nth_child (GTK_TREE_MODEL (store), &iter, NULL, 0);
+    gtk_list_store_set (store, &iter, 0, "banana 0", -1);
+    gtk_tree_model_iter_nth_child (GTK_TREE_MODEL (store), &iter, NULL, 2);
+    gtk_list_store_set (store, &iter, 0, "apple 2", -1);
+
+    gtk_list_store_insert_with_values (store, NULL, 10,
+                                       0, "avocado new", 1, N_ROWS, -1);
+    gtk_list_store_insert_with_values (store, NULL, 20,
+                                       0, "banana new", 1, N_ROWS + 1, -1);
+
+    gtk_tree_model_iter_nth_child (GTK_TREE_MODEL (store), &iter, NULL, 4);
+    gtk_list_store_remove (store, &iter);
+
+    fail_if (!wait_matched ("a"),
+             "hildon-live-search: Rows changed while matching shown as before "
+             "the change");
+}
+END_TEST
+
+/* Returns the names of the rows of @model, separated by commas */
+static gchar *
+get_rows (GtkTreeModel *model)
+{
+    GString *rows = g_string_new (NULL);
+    GtkTreeIter iter;
+    gboolean valid;
+
+    for (valid = gtk_tree_model_get_iter_first (model, &iter);
+         valid;
+         valid = gtk_tree_model_iter_next (model, &iter)) {
+        gchar *name;
+
+        gtk_tree_model_get (model, &iter, 0, &name, -1);
+        if (rows->len > 0)
+            g_string_append (rows, ",");
+        g_string_append (rows, name);
+        g_free (name);
+    }
+
+    return g_string_free (rows, FALSE);
+}
+
+static void
+check_rows (GtkTreeModel *model, const gchar *text, const gchar *expected)
+{
+    gchar *rows = get_rows (model);
+
+    fail_if (strcmp (rows, expected) != 0,
+             "hildon-live-search: \"%s\" shows \"%s\" instead of \"%s\"",
+             text, rows, expected);
+    g_free (rows);
+}
+
+/**
+   Purpose: test the order of the kinds of ranked matches.
+
+   Checks for:
+
+   - A match at the start of the row comes first, then at the start of
+     a word, in the middle of a word, with characters in between, and
+     last with a typo.
+   - Rows matching equally keep their order.
+   - Rows not matching at all are hidden.
+*/
+START_TEST (test_hildon_live_search_ranked_score_order)
+{
+    GtkTreeModel *ranked = hildon_live_search_get_ranked_model (livesearch);
+
+    hildon_live_search_set_text (livesearch, "note");
+    check_rows (ranked, "note", NOTE_RANKED);
+}
+END_TEST
+
+/**
+   Purpose: test that only words of 4 characters or more match with a
+   typo.
+
+   Checks for:
+
+   - "not" doesn't match "Nute light", but "note" does.
+*/
+START_TEST (test_hildon_live_search_ranked_typo_length)
+{
+    GtkTreeModel *ranked = hildon_live_search_get_ranked_model (livesearch);
+
+    hildon_live_search_set_text (livesearch, "not");
+    check_rows (ranked, "not", "Notepad,Notebook,My notes,Keynote,Northern tale");
+
+    hildon_live_search_set_text (livesearch, "note");
+    check_rows (ranked, "note", NOTE_RANKED);
+}
+END_TEST
+
+/**
+   Purpose: test that the ranked model sorts the rows matched in worker
+   threads, without changing the order of the filter.
+
+   Checks for:
+
+   - Once the threads are done, the ranked model has the best matches
+     first.
+   - The filter keeps the order of the child model.
+   - Clearing the text shows all the rows in the order of the child
+     model again.
+*/
+START_TEST (test_hildon_live_search_ranked_model_order)
+{
+    GtkTreeModel *ranked = hildon_live_search_get_ranked_model (livesearch);
+    gint64 end = g_get_monotonic_time () + WAIT_MSECS * 1000;
+    gchar *rows = NULL;
+
+    hildon_live_search_append_text (livesearch, "note");
+    do {
+        g_free (rows);
+        run_pending ();
+        g_usleep (1000);
+        rows = get_rows (ranked);
+    } while (strcmp (rows, NOTE_RANKED) != 0 && g_get_monotonic_time () < end);
+    g_free (rows);
+
+    check_rows (ranked, "note", NOTE_RANKED);
+    check_rows (filter, "note",
+                "Nute light,Northern tale,Keynote,My notes,Notepad,Notebook");
+
+    hildon_live_search_set_text (livesearch, "");
+    check_rows (ranked, "",
+                "Banana,Nute light,Northern tale,Keynote,My notes,Notepad,Notebook");
+}
+END_TEST
+
+/* Sets @text and returns the number of rows tested for it */
+static guint
+count_tested (const gchar *text)
+{
+    n_tested = 0;
+    hildon_live_search_set_text (livesearch, text);
+
+    return n_tested;
+}
+
+static void
+fx_setup_incremental ()
+{
+    fx_setup ();
+
+    hildon_live_search_set_visible_func (livesearch, slow_visible_func,
+                                         NULL, NULL);
+    hildon_live_search_set_incremental (livesearch, TRUE);
+}
+
+/**
+   Purpose: test that appending text only tests again the rows that
+   were visible.
+
+   Checks for:
+
+   - The first text tests every row.
+   - Each character typed after it only tests the rows visible for the
+     previous text, and the rows matching the new one are visible.
+   - A row changed while hidden is tested again.
+*/
+START_TEST (test_hildon_live_search_incremental_append)
+{
+    GtkTreeIter iter;
+    guint n;
+
+    n = count_tested ("a");
+    fail_if (n != N_ROWS,
+             "hildon-live-search: %u rows tested for \"a\" instead of %d",
+             n, N_ROWS);
+
+    n = count_tested ("av");
+    fail_if (n != 2 * N_ROWS / 3,
+             "hildon-live-search: %u rows tested for \"av\" instead of the %d "
+             "visible for \"a\"", n, 2 * N_ROWS / 3);
+    fail_if (count_visible () != N_ROWS / 3 || !all_visible_start_with ("avocado"),
+             "hildon-live-search: Wrong rows visible for \"av\"");
+
+    n = count_tested ("avo");
+    fail_if (n != N_ROWS / 3,
+             "hildon-live-search: %u rows tested for \"avo\" instead of the %d "
+             "visible for \"av\"", n, N_ROWS / 3);
+
+    /* "apple 0", hidden since "av" */
+    gtk_tree_model_get_iter_first (GTK_TREE_MODEL (store), &iter);
+    gtk_list_store_set (store, &iter, 0, "avocado 0", -1);
+
+    n = count_tested ("avoc");
+    fail_if (n != N_ROWS / 3 + 1,
+             "hildon-live-search: %u rows tested for \"avoc\" instead of %d",
+             n, N_ROWS / 3 + 1);
+    fail_if (count_visible () != N_ROWS / 3 + 1,
+             "hildon-live-search: %d rows visible for \"avoc\" instead of %d",
+             count_visible (), N_ROWS / 3 + 1);
+}
+END_TEST
+
+/**
+   Purpose: test that text which doesn't extend the previous one tests
+   every row again.
+
+   Checks for:
+
+   - Deleting a character tests every row, and shows the rows hidden
+     for the longer text again.
+   - So does replacing the text with one starting differently.
+*/
+START_TEST (test_hildon_live_search_incremental_delete)
+{
+    guint n;
+
+    count_tested ("a");
+    count_tested ("av");
+
+    n = count_tested ("a");
+    fail_if (n != N_ROWS,
+             "hildon-live-search: %u rows tested after deleting a character "
+             "instead of %d", n, N_ROWS);
+    fail_if (count_visible () != 2 * N_ROWS / 3,
+             "hildon-live-search: %d rows visible for \"a\" instead of %d",
+             count_visible (), 2 * N_ROWS / 3);
+
+    n = count_tested ("b");
+    fail_if (n != N_ROWS,
+             "hildon-live-search: %u rows tested for \"b\" instead of %d",
+             n, N_ROWS);
+    fail_if (count_visible () != N_ROWS / 3 || !all_visible_start_with ("banana"),
+             "hildon-live-search: Wrong rows visible for \"b\"");
+}
+END_TEST
+
+static void
+fx_setup_selection ()
+{
+    fx_setup ();
+
+    tree_view = gtk_tree_view_new_with_model (filter);
+    g_object_ref_sink (tree_view);
+    gtk_tree_selection_set_mode (gtk_tree_view_get_selection (GTK_TREE_VIEW (tree_view)),
+                                 GTK_SELECTION_MULTIPLE);
+
+    hildon_live_search_set_text_column (livesearch, 0);
+    hildon_live_search_widget_hook (livesearch, tree_view, tree_view);
+}
+
+static void
+fx_teardown_selection ()
+{
+    gtk_widget_destroy (tree_view);
+    g_object_unref (tree_view);
+
+    fx_teardown ();
+}
+
+/* Selects the visible row with the id @id */
+static void
+select_id (gint id)
+{
+    GtkTreeSelection *selection;
+    GtkTreeIter iter;
+    gboolean valid;
+
+    selection = gtk_tree_view_get_selection (GTK_TREE_VIEW (tree_view));
+
+    for (valid = gtk_tree_model_get_iter_first (filter, &iter);
+         valid;
+         valid = gtk_tree_model_iter_next (filter, &iter)) {
+        gint row_id;
+
+        gtk_tree_model_get (filter, &iter, 1, &row_id, -1);
+        if (row_id == id) {
+            gtk_tree_selection_select_iter (selection, &iter);
+            return;
+        }
+    }
+
+    fail ("hildon-live-search: No visible row with the id %d", id);
+}
+
+/* Returns the ids of the selected rows, separated by commas */
+static gchar *
+get_selected_ids ()
+{
+    GtkTreeSelection *selection;
+    GString *ids = g_string_new (NULL);
+    GtkTreeIter iter;
+    gboolean valid;
+
+    selection = gtk_tree_view_get_selection (GTK_TREE_VIEW (tree_view));
+
+    for (valid = gtk_tree_model_get_iter_first (filter, &iter);
+         valid;
+         valid = gtk_tree_model_iter_next (filter, &iter)) {
+        gint id;
+
+        if (!gtk_tree_selection_iter_is_selected (selection, &iter))
+            continue;
+
+        gtk_tree_model_get (filter, &iter, 1, &id, -1);
+        g_string_append_printf (ids, "%s%d", ids->len ? "," : "", id);
+    }
+
+    return g_string_free (ids, FALSE);
+}
+
+static void
+check_selected (const gchar *text, const gchar *expected)
+{
+    gchar *ids = get_selected_ids ();
+
+    fail_if (strcmp (ids, expected) != 0,
+             "hildon-live-search: Rows %s selected for \"%s\" instead of %s",
+             ids, text, expected);
+    g_free (ids);
+}
+
+/**
+   Purpose: test that the rows selected are selected again when they
+   are shown after a refilter.
+
+   Checks for:
+
+   - Selected rows hidden by the text are selected again once the text
+     is cleared, along with the ones which stayed visible.
+   - Rows unselected while others were hidden stay unselected.
+*/
+START_TEST (test_hildon_live_search_selection_restore)
+{
+    select_id (0);
+    select_id (2);
+    select_id (5);
+
+    hildon_live_search_set_text (livesearch, "b");
+    check_selected ("b", "2,5");
+
+    gtk_tree_selection_unselect_all (gtk_tree_view_get_selection (GTK_TREE_VIEW (tree_view)));
+    select_id (5);
+
+    hildon_live_search_set_text (livesearch, "");
+    check_selected ("", "0,5");
+}
+END_TEST
+
+/**
+   Purpose: test that rows are kept selected by the value of the id
+   column.
+
+   Checks for:
+
+   - Setting the id column while selected rows are hidden keeps them
+     in the selection.
+   - Hidden rows moved in the child model are selected again where
+     they are once shown.
+*/
+START_TEST (test_hildon_live_search_selection_id_column)
+{
+    GtkTreeIter first, iter;
+
+    select_id (0);
+    select_id (3);
+
+    hildon_live_search_set_text (livesearch, "b");
+    hildon_live_search_set_id_column (livesearch, 1);
+
+    /* Put "apple 3" first, and "apple 0" last */
+    gtk_tree_model_iter_nth_child (GTK_TREE_MODEL (store), &first, NULL, 0);
+    gtk_tree_model_iter_nth_child (GTK_TREE_MODEL (store), &iter, NULL, 3);
+    gtk_list_store_move_before (store, &iter, &first);
+    gtk_list_store_move_before (store, &first, NULL);
+
+    hildon_live_search_set_text (livesearch, "");
+    check_selected ("", "3,0");
+}
+END_TEST
+
+/**
+   Purpose: test that a selected row deleted while hidden doesn't
+   select a row added after it.
+
+   Checks for:
+
+   - A row added where a selected row was deleted, whose iter may be
+     the one of the deleted row, is not selected once shown.
+*/
+START_TEST (test_hildon_live_search_selection_deleted_row)
+{
+    GtkTreeIter iter;
+
+    select_id (0);
+
+    hildon_live_search_set_text (livesearch, "b");
+
+    gtk_tree_model_get_iter_first (GTK_TREE_MODEL (store), &iter);
+    gtk_list_store_remove (store, &iter);
+    gtk_list_store_insert_with_values (store, NULL, 0, 0, "apple new", 1, N_ROWS, -1);
+
+    hildon_live_search_set_text (livesearch, "");
+    check_selected ("", "");
+}
+END_TEST
+
+/* ---------- Suite creation ---------- */
+
+Suite *create_hildon_live_search_suite (void)
+{
+    Suite *s = suite_create ("HildonLiveSearch");
+
+    TCase *tc1 = tcase_create ("hildon_live_search_chunked");
+    tcase_add_checked_fixture (tc1, fx_setup, fx_teardown);
+    tcase_add_test (tc1, test_hildon_live_search_chunked_partial_results);
+    tcase_add_test (tc1, test_hildon_live_search_chunked_cancel);
+    suite_add_tcase (s, tc1);
+
+    TCase *tc2 = tcase_create ("hildon_live_search_threaded");
+    tcase_add_checked_fixture (tc2, fx_setup_threaded, fx_teardown_threaded);
+    tcase_add_test (tc2, test_hildon_live_search_threaded_matches);
+    tcase_add_test (tc2, test_hildon_live_search_threaded_cancel);
+    tcase_add_test (tc2, test_hildon_live_search_threaded_model_changes);
+    suite_add_tcase (s, tc2);
+
+    TCase *tc3 = tcase_create ("hildon_live_search_ranked");
+    tcase_add_checked_fixture (tc3, fx_setup_ranked, fx_teardown);
+    tcase_add_test (tc3, test_hildon_live_search_ranked_score_order);
+    tcase_add_test (tc3, test_hildon_live_search_ranked_typo_length);
+    tcase_add_test (tc3, test_hildon_live_search_ranked_model_order);
+    suite_add_tcase (s, tc3);
+
+    TCase *tc4 = tcase_create ("hildon_live_search_incremental");
+    tcase_add_checked_fixture (tc4, fx_setup_incremental, fx_teardown);
+    tcase_add_test (tc4, test_hildon_live_search_incremental_append);
+    tcase_add_test (tc4, test_hildon_live_search_incremental_delete);
+    suite_add_tcase (s, tc4);
+
+    TCase *tc5 = tcase_create ("hildon_live_search_selection");
+    tcase_add_checked_fixture (tc5, fx_setup_selection, fx_teardown_selection);
+    tcase_add_test (tc5, test_hildon_live_search_selection_restore);
+    tcase_add_test (tc5, test_hildon_live_search_selection_id_column);
+    tcase_add_test (tc5, test_hildon_live_search_selection_deleted_row);
+    suite_add_tcase (s, tc5);
+
+    return s;
+}
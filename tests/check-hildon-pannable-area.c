@@ -0,0 +1,593 @@
+/*
+ * This file is a part of hildon tests
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <check.h>
+#include "test_suites.h"
+#include "check_utils.h"
+#include <hildon/hildon.h>
+
+/* Size of the area, and of the content panned in it */
+#define AREA_WIDTH 200
+#define AREA_HEIGHT 400
+#define CONTENT_HEIGHT 3000
+
+/* Long enough for a fling or a bounce under a loaded Xvfb */
+#define WAIT_MSECS 5000
+
+static GtkWidget *label = NULL;
+static guint n_calls = 0;
+static guint n_notifies = 0;
+
+static GtkWidget *window = NULL;
+static HildonPannableArea *area = NULL;
+static GtkWidget *viewport = NULL;
+static gint viewport_y = 0;
+static GArray *samples = NULL;
+static guint32 event_time = 0;
+static GString *events = NULL;
+
+static void
+fx_setup ()
+{
+    int argc = 0;
+
+    gtk_init (&argc, NULL);
+
+    label = gtk_label_new ("Outside of any pannable area");
+    g_object_ref_sink (label);
+
+    n_calls = 0;
+    n_notifies = 0;
+}
+
+static void
+fx_teardown ()
+{
+    gtk_widget_destroy (label);
+    g_object_unref (label);
+}
+
+/* How far the viewport is moved from where the area puts it */
+static gint
+get_child_offset ()
+{
+    GtkAllocation area_allocation, allocation;
+
+    gtk_widget_get_allocation (GTK_WIDGET (area), &area_allocation);
+    gtk_widget_get_allocation (viewport, &allocation);
+
+    return allocation.y - area_allocation.y - viewport_y;
+}
+
+static void
+fx_setup_kinetic ()
+{
+    int argc = 0;
+    GtkWidget *content;
+    gint64 end;
+
+    gtk_init (&argc, NULL);
+
+    window = create_test_window ();
+
+    area = HILDON_PANNABLE_AREA (hildon_pannable_area_new ());
+    gtk_widget_set_size_request (GTK_WIDGET (area), AREA_WIDTH, AREA_HEIGHT);
+    content = gtk_drawing_area_new ();
+    gtk_widget_set_size_request (content, AREA_WIDTH, CONTENT_HEIGHT);
+    hildon_pannable_area_add_with_viewport (area, content);
+    viewport = gtk_bin_get_child (GTK_BIN (area));
+
+    gtk_container_add (GTK_CONTAINER (window), GTK_WIDGET (area));
+    show_all_test_window (window);
+
+    /* The frame clock lays the window out */
+    end = g_get_monotonic_time () + WAIT_MSECS * 1000;
+    while (gtk_widget_get_allocated_height (GTK_WIDGET (area)) < AREA_HEIGHT &&
+           g_get_monotonic_time () < end)
+      g_main_context_iteration (NULL, TRUE);
+
+    viewport_y = 0;
+    viewport_y = get_child_offset ();
+    samples = g_array_new (FALSE, FALSE, sizeof (gdouble));
+    event_time = 0;
+    events = g_string_new (NULL);
+
+    n_calls = 0;
+    n_notifies = 0;
+}
+
+static void
+fx_teardown_kinetic ()
+{
+    if (window != NULL)
+        gtk_widget_destroy (window);
+    g_array_free (samples, TRUE);
+    g_string_free (events, TRUE);
+}
+
+/* Asks to be called again, which must not happen */
+static gboolean
+deferred_call (gpointer data)
+{
+    n_calls++;
+
+    return TRUE;
+}
+
+static void
+deferred_notify (gpointer data)
+{
+    n_notifies++;
+}
+
+static void
+run_idles ()
+{
+    guint i;
+
+    /* Bounded, so that an idle which keeps running shows as a failure
+       rather than a hang */
+    for (i = 0; i < 100; i++)
+      g_main_context_iteration (NULL, FALSE);
+}
+
+/* Sends an event at (@x, @y) of the area, to the window of the
+   viewport below it, as the windowing system would */
+static void
+send_event (GdkEventType type, gdouble x, gdouble y, guint32 time)
+{
+    GdkWindow *bin_window, *toplevel, *parent;
+    GdkDevice *pointer;
+    GdkEvent *event;
+    GtkAllocation allocation;
+    gdouble wx, wy;
+
+    /* The area has no window of its own */
+    gtk_widget_get_allocation (GTK_WIDGET (area), &allocation);
+    wx = allocation.x + x;
+    wy = allocation.y + y;
+
+    bin_window = gtk_viewport_get_bin_window (GTK_VIEWPORT (viewport));
+    toplevel = gtk_widget_get_window (window);
+    for (parent = bin_window; parent && parent != toplevel;
+         parent = gdk_window_get_parent (parent)) {
+        gint px, py;
+
+        gdk_window_get_position (parent, &px, &py);
+        wx -= px;
+        wy -= py;
+    }
+
+    pointer = gdk_seat_get_pointer (gdk_display_get_default_seat (gdk_display_get_default ()));
+
+    event = gdk_event_new (type);
+    if (type == GDK_MOTION_NOTIFY) {
+        event->motion.window = g_object_ref (bin_window);
+        event->motion.time = time;
+        event->motion.x = wx;
+        event->motion.y = wy;
+        event->motion.x_root = x;
+        event->motion.y_root = y;
+        event->motion.state = GDK_BUTTON1_MASK;
+    } else {
+        event->button.window = g_object_ref (bin_window);
+        event->button.time = time;
+        event->button.x = wx;
+        event->button.y = wy;
+        event->button.x_root = x;
+        event->button.y_root = y;
+        event->button.button = 1;
+        event->button.state = type == GDK_BUTTON_RELEASE ? GDK_BUTTON1_MASK : 0;
+    }
+    gdk_event_set_device (event, pointer);
+    gdk_event_set_source_device (event, pointer);
+
+    gtk_main_do_event (event);
+    gdk_event_free (event);
+}
+
+/* Drags from (100, @from_y) to (100, @to_y) of the area, in steps of
+   20 pixels 10 milliseconds apart, a second after the previous drag.
+   Returns the time of the last motion */
+static guint32
+drag (gdouble from_y, gdouble to_y)
+{
+    guint32 time = event_time + 1000;
+    gdouble step = to_y > from_y ? 20 : -20;
+    gdouble y = from_y;
+
+    send_event (GDK_BUTTON_PRESS, 100, from_y, time);
+    while (y != to_y) {
+        y = ABS (to_y - y) > ABS (step) ? y + step : to_y;
+        time += 10;
+        send_event (GDK_MOTION_NOTIFY, 100, y, time);
+    }
+
+    event_time = time;
+
+    return time;
+}
+
+/* Runs the main loop until the area stops panning */
+static gboolean
+wait_settled ()
+{
+    gint64 end = g_get_monotonic_time () + WAIT_MSECS * 1000;
+
+    while (hildon_pannable_area_get_is_panning (area) &&
+           g_get_monotonic_time () < end)
+      g_main_context_iteration (NULL, TRUE);
+
+    return !hildon_pannable_area_get_is_panning (area);
+}
+
+static gdouble
+get_value ()
+{
+    return gtk_adjustment_get_value (hildon_pannable_area_get_vadjustment (area));
+}
+
+static void
+on_scroll_velocity (GObject *object, GParamSpec *pspec, gpointer data)
+{
+    gdouble velocity = ABS (hildon_pannable_area_get_scroll_velocity (area));
+
+    g_array_append_val (samples, velocity);
+}
+
+static void
+on_viewport_size_allocate (GtkWidget *widget, GtkAllocation *allocation,
+                           gpointer data)
+{
+    gdouble offset = get_child_offset ();
+
+    g_array_append_val (samples, offset);
+}
+
+/* Returns whether the samples never grow */
+static gboolean
+samples_decrease ()
+{
+    guint i;
+
+    for (i = 1; i < samples->len; i++)
+      if (g_array_index (samples, gdouble, i) > g_array_index (samples, gdouble, i - 1))
+        return FALSE;
+
+    return TRUE;
+}
+
+/* Records the panning signals as S and F, and the notifications of
+   is-panning as N */
+static gboolean
+on_panning_started (HildonPannableArea *area, gpointer data)
+{
+    g_string_append_c (events, 'S');
+
+    return FALSE;
+}
+
+static void
+on_panning_finished (HildonPannableArea *area, gpointer data)
+{
+    g_string_append_c (events, 'F');
+}
+
+static void
+on_is_panning (GObject *object, GParamSpec *pspec, gpointer data)
+{
+    g_string_append_c (events, 'N');
+}
+
+/* Records the call, named by @data */
+static gboolean
+deferred_record (gpointer data)
+{
+    g_string_append (events, data);
+
+    return FALSE;
+}
+
+/* Destroys the window, and the area with it */
+static gboolean
+deferred_destroy (gpointer data)
+{
+    gtk_widget_destroy (window);
+    window = NULL;
+
+    return FALSE;
+}
+
+/**
+   Purpose: test that a call deferred for a widget that is not inside
+   a HildonPannableArea runs once, whatever it returns.
+
+   Checks for:
+
+   - A callback returning TRUE is called exactly once.
+   - The notify function is called once after it.
+*/
+START_TEST (test_hildon_pannable_area_defer_no_area)
+{
+    hildon_pannable_area_defer_until_settled (label, deferred_call,
+                                              NULL, deferred_notify);
+    run_idles ();
+
+    fail_if (n_calls != 1,
+             "hildon-pannable-area: Deferred call run %u times instead of once",
+             n_calls);
+    fail_if (n_notifies != 1,
+             "hildon-pannable-area: Notify called %u times instead of once",
+             n_notifies);
+}
+END_TEST
+
+/**
+   Purpose: test that a fling keeps scrolling after the release, slowing
+   down until it stops.
+
+   Checks for:
+
+   - The area is panning after the release.
+   - The content keeps moving the way it was flung.
+   - The velocity decreases on every frame, and the area stops panning
+     with a velocity of 0.
+*/
+START_TEST (test_hildon_pannable_area_fling_deceleration)
+{
+    guint32 time;
+    gdouble released_value;
+
+    time = drag (300, 100);
+    send_event (GDK_BUTTON_RELEASE, 100, 100, time);
+    released_value = get_value ();
+
+    fail_if (!hildon_pannable_area_get_is_panning (area),
+             "hildon-pannable-area: Not panning after a fling");
+
+    g_signal_connect (area, "notify::scroll-velocity",
+                      G_CALLBACK (on_scroll_velocity), NULL);
+    fail_if (!wait_settled (),
+             "hildon-pannable-area: The fling did not stop");
+
+    fail_if (get_value () <= released_value,
+             "hildon-pannable-area: Flung up, but scrolled from %f to %f",
+             released_value, get_value ());
+    fail_if (samples->len < 2,
+             "hildon-pannable-area: Only %u velocity changes during the fling",
+             samples->len);
+    fail_if (!samples_decrease (),
+             "hildon-pannable-area: The velocity grew during the fling");
+    fail_if (hildon_pannable_area_get_scroll_velocity (area) != 0,
+             "hildon-pannable-area: Stopped with a velocity of %f",
+             hildon_pannable_area_get_scroll_velocity (area));
+}
+END_TEST
+
+/**
+   Purpose: test that dragging past the edge moves the child past it,
+   half the distance.
+
+   Checks for:
+
+   - The adjustment stays at its lower bound.
+   - The child is allocated 50 pixels down when dragged 100 pixels
+     down past the top edge, so that children with their own window
+     follow.
+*/
+START_TEST (test_hildon_pannable_area_overshoot)
+{
+    fail_if (get_value () != 0 || get_child_offset () != 0,
+             "hildon-pannable-area: Not at the top before dragging");
+
+    drag (100, 200);
+
+    fail_if (get_value () != 0,
+             "hildon-pannable-area: Dragged past the top, but scrolled to %f",
+             get_value ());
+    fail_if (get_child_offset () != 50,
+             "hildon-pannable-area: The child was moved %d pixels instead of 50",
+             get_child_offset ());
+}
+END_TEST
+
+/**
+   Purpose: test that the child moves back after being released past
+   the edge.
+
+   Checks for:
+
+   - Released after resting, the area is panning while it bounces.
+   - The child moves back to the edge without going away from it.
+   - Once the area stops panning, the child is back where the area
+     puts it, and the adjustment still at its lower bound.
+*/
+START_TEST (test_hildon_pannable_area_bounce_back)
+{
+    guint32 time;
+
+    time = drag (100, 200);
+    g_signal_connect (viewport, "size-allocate",
+                      G_CALLBACK (on_viewport_size_allocate), NULL);
+
+    /* Resting longer than the area waits for before stopping a fling */
+    send_event (GDK_BUTTON_RELEASE, 100, 200, time + 500);
+
+    fail_if (!hildon_pannable_area_get_is_panning (area),
+             "hildon-pannable-area: Not panning while bouncing back");
+    fail_if (!wait_settled (),
+             "hildon-pannable-area: The bounce did not stop");
+
+    fail_if (samples->len == 0,
+             "hildon-pannable-area: The child was not moved back");
+    fail_if (!samples_decrease (),
+             "hildon-pannable-area: The child moved away from the edge");
+    fail_if (get_child_offset () != 0,
+             "hildon-pannable-area: The child was left %d pixels past the edge",
+             get_child_offset ());
+    fail_if (get_value () != 0,
+             "hildon-pannable-area: Bounced back to %f", get_value ());
+}
+END_TEST
+
+/**
+   Purpose: test that calls deferred while the area pans wait for it
+   to stop.
+
+   Checks for:
+
+   - No call is run while the area is panning.
+   - Once it stops, the calls are run once each, in the order they were
+     deferred, and their notify functions are called.
+   - Deferring the same call twice runs it once.
+*/
+START_TEST (test_hildon_pannable_area_defer_while_panning)
+{
+    guint32 time;
+
+    time = drag (300, 100);
+    fail_if (!hildon_pannable_area_get_is_panning (area),
+             "hildon-pannable-area: Not panning while dragged");
+
+    hildon_pannable_area_defer_until_settled (viewport, deferred_record, "a", NULL);
+    hildon_pannable_area_defer_until_settled (viewport, deferred_record, "b", NULL);
+    hildon_pannable_area_defer_until_settled (viewport, deferred_call, NULL,
+                                              deferred_notify);
+    hildon_pannable_area_defer_until_settled (viewport, deferred_record, "c", NULL);
+    hildon_pannable_area_defer_until_settled (viewport, deferred_record, "a", NULL);
+    run_idles ();
+
+    fail_if (events->len != 0 || n_calls != 0,
+             "hildon-pannable-area: Deferred calls run while panning");
+
+    /* Resting first, so that the release doesn't fling */
+    send_event (GDK_BUTTON_RELEASE, 100, 100, time + 500);
+    fail_if (!wait_settled (),
+             "hildon-pannable-area: Still panning after the release");
+    run_idles ();
+
+    fail_if (strcmp (events->str, "abc") != 0,
+             "hildon-pannable-area: Deferred calls run as \"%s\" instead of \"abc\"",
+             events->str);
+    fail_if (n_calls != 1 || n_notifies != 1,
+             "hildon-pannable-area: Deferred call run %u times and notified %u "
+             "times instead of once", n_calls, n_notifies);
+}
+END_TEST
+
+/**
+   Purpose: test that a deferred call can destroy the area running it.
+
+   Checks for:
+
+   - The call destroying the area is run.
+   - The calls queued after it for widgets inside of the area are not
+     run, but their notify functions are called.
+*/
+START_TEST (test_hildon_pannable_area_defer_destroy_area)
+{
+    hildon_pannable_area_defer_until_settled (viewport, deferred_destroy, NULL, NULL);
+    hildon_pannable_area_defer_until_settled (viewport, deferred_call, NULL,
+                                              deferred_notify);
+    run_idles ();
+
+    fail_if (window != NULL,
+             "hildon-pannable-area: The call destroying the area was not run");
+    fail_if (n_calls != 0,
+             "hildon-pannable-area: A call for a destroyed widget was run");
+    fail_if (n_notifies != 1,
+             "hildon-pannable-area: Notify called %u times instead of once",
+             n_notifies);
+}
+END_TEST
+
+/**
+   Purpose: test that every panning-started is followed by one
+   panning-finished, and that is-panning is notified along with them.
+
+   Checks for:
+
+   - A fling which comes to rest emits panning-started, is-panning
+     twice, then panning-finished.
+   - A fling stopped by a press does the same, and so does the next
+     one.
+*/
+START_TEST (test_hildon_pannable_area_panning_signals)
+{
+    guint32 time;
+
+    g_signal_connect (area, "panning-started",
+                      G_CALLBACK (on_panning_started), NULL);
+    g_signal_connect (area, "panning-finished",
+                      G_CALLBACK (on_panning_finished), NULL);
+    g_signal_connect (area, "notify::is-panning",
+                      G_CALLBACK (on_is_panning), NULL);
+
+    time = drag (300, 100);
+    send_event (GDK_BUTTON_RELEASE, 100, 100, time);
+    fail_if (!wait_settled (),
+             "hildon-pannable-area: The fling did not stop");
+    fail_if (strcmp (events->str, "SNNF") != 0,
+             "hildon-pannable-area: Got \"%s\" for a fling instead of \"SNNF\"",
+             events->str);
+
+    time = drag (300, 100);
+    send_event (GDK_BUTTON_RELEASE, 100, 100, time);
+    send_event (GDK_BUTTON_PRESS, 100, 100, time + 20);
+    send_event (GDK_BUTTON_RELEASE, 100, 100, time + 40);
+    event_time = time + 40;
+    fail_if (hildon_pannable_area_get_is_panning (area),
+             "hildon-pannable-area: Still panning after a press");
+
+    time = drag (300, 100);
+    send_event (GDK_BUTTON_RELEASE, 100, 100, time);
+    fail_if (!wait_settled (),
+             "hildon-pannable-area: The last fling did not stop");
+    fail_if (strcmp (events->str, "SNNFSNNFSNNF") != 0,
+             "hildon-pannable-area: Got \"%s\" for three flings instead of "
+             "\"SNNFSNNFSNNF\"", events->str);
+}
+END_TEST
+
+/* ---------- Suite creation ---------- */
+
+Suite *create_hildon_pannable_area_suite (void)
+{
+    Suite *s = suite_create ("HildonPannableArea");
+
+    TCase *tc1 = tcase_create ("hildon_pannable_area_defer_until_settled");
+    tcase_add_checked_fixture (tc1, fx_setup, fx_teardown);
+    tcase_add_test (tc1, test_hildon_pannable_area_defer_no_area);
+    suite_add_tcase (s, tc1);
+
+    TCase *tc2 = tcase_create ("hildon_pannable_area_kinetic");
+    tcase_add_checked_fixture (tc2, fx_setup_kinetic, fx_teardown_kinetic);
+    tcase_add_test (tc2, test_hildon_pannable_area_fling_deceleration);
+    tcase_add_test (tc2, test_hildon_pannable_area_overshoot);
+    tcase_add_test (tc2, test_hildon_pannable_area_bounce_back);
+    tcase_add_test (tc2, test_hildon_pannable_area_defer_while_panning);
+    tcase_add_test (tc2, test_hildon_pannable_area_defer_destroy_area);
+    tcase_add_test (tc2, test_hildon_pannable_area_panning_signals);
+    suite_add_tcase (s, tc2);
+
+    return s;
+}
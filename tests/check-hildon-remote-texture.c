@@ -0,0 +1,228 @@
+/*
+ * This file is a part of hildon tests
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+#include <stdlib.h>
+#include <check.h>
+#include "test_suites.h"
+#include "check_utils.h"
+#include "mock-compositor.h"
+#include <hildon/hildon.h>
+
+#define SHM_MESSAGE    "_HILDON_TEXTURE_CLIENT_MESSAGE_SHM"
+#define DAMAGE_MESSAGE "_HILDON_TEXTURE_CLIENT_MESSAGE_DAMAGE"
+#define PARENT_MESSAGE "_HILDON_TEXTURE_CLIENT_MESSAGE_PARENT"
+
+/* Long enough for a few frames and a remap under a loaded Xvfb */
+#define WAIT_MSECS 2000
+
+static MockCompositor *mc = NULL;
+static GtkWidget *window = NULL;
+static HildonRemoteTexture *texture = NULL;
+
+static void
+fx_setup ()
+{
+    int argc = 0;
+
+    gtk_init (&argc, NULL);
+
+    mc = mock_compositor_new ();
+    fail_if (mc == NULL,
+             "hildon-remote-texture: Could not connect the mock compositor");
+
+    window = create_test_window ();
+    show_test_window (window);
+
+    texture = HILDON_REMOTE_TEXTURE (hildon_remote_texture_new ());
+    mock_compositor_manage (mc, GTK_WIDGET (texture));
+    hildon_remote_texture_set_parent (texture, GTK_WINDOW (window));
+    gtk_widget_show (GTK_WIDGET (texture));
+
+    /* Damage is only sent once ready and parented to a mapped window */
+    mock_compositor_set_ready (mc, GTK_WIDGET (texture), MOCK_REMOTE_TEXTURE_READY);
+    fail_if (!mock_compositor_wait (mc, PARENT_MESSAGE, 1, WAIT_MSECS),
+             "hildon-remote-texture: The texture was not parented once ready");
+    mock_compositor_settle (mc);
+    mock_compositor_clear (mc);
+}
+
+static void
+fx_teardown ()
+{
+    gtk_widget_destroy (GTK_WIDGET (texture));
+    gtk_widget_destroy (window);
+    mock_compositor_free (mc);
+}
+
+/* Returns whether a damage message for the rectangle was received */
+static gboolean
+damage_received (glong x, glong y, glong width, glong height)
+{
+    Atom damage = XInternAtom (mc->display, DAMAGE_MESSAGE, False);
+    guint i;
+
+    for (i = 0; i < mc->messages->len; i++)
+      {
+        const MockMessage *message = &g_array_index (mc->messages, MockMessage, i);
+
+        if (message->type == damage &&
+            message->l[0] == x && message->l[1] == y &&
+            message->l[2] == width && message->l[3] == height)
+          return TRUE;
+      }
+
+    return FALSE;
+}
+
+/**
+   Purpose: test that the areas damaged while frozen are sent as the
+   rectangles of their union.
+
+   Checks for:
+
+   - Nothing is sent while frozen.
+   - On thaw, an area damaged twice and an area inside of it are sent
+     once, along with a separate area, in two damage messages.
+*/
+START_TEST (test_hildon_remote_texture_damage_coalescing)
+{
+    hildon_remote_texture_freeze_updates (texture);
+    hildon_remote_texture_update_area (texture, 0, 0, 10, 10);
+    hildon_remote_texture_update_area (texture, 50, 50, 10, 10);
+    hildon_remote_texture_update_area (texture, 0, 0, 10, 10);
+    hildon_remote_texture_update_area (texture, 2, 2, 4, 4);
+    mock_compositor_settle (mc);
+
+    fail_if (mock_compositor_count (mc, NULL) != 0,
+             "hildon-remote-texture: %u messages sent while frozen",
+             mock_compositor_count (mc, NULL));
+
+    hildon_remote_texture_thaw_updates (texture);
+    mock_compositor_settle (mc);
+
+    fail_if (mock_compositor_count (mc, DAMAGE_MESSAGE) != 2,
+             "hildon-remote-texture: %u damage messages sent instead of 2",
+             mock_compositor_count (mc, DAMAGE_MESSAGE));
+    fail_if (!damage_received (0, 0, 10, 10) || !damage_received (50, 50, 10, 10),
+             "hildon-remote-texture: The damaged rectangles were not sent as given");
+}
+END_TEST
+
+/**
+   Purpose: test that damage made of too many rectangles is sent as its
+   bounding box.
+
+   Checks for:
+
+   - 17 separate areas, one more than can be sent as rectangles,
+     damaged while frozen are sent, on thaw, as a single damage message
+     covering all of them.
+*/
+START_TEST (test_hildon_remote_texture_damage_cap)
+{
+    gint i;
+
+    hildon_remote_texture_freeze_updates (texture);
+    for (i = 0; i < 17; i++)
+      hildon_remote_texture_update_area (texture, i * 20, i * 20, 10, 10);
+    hildon_remote_texture_thaw_updates (texture);
+    mock_compositor_settle (mc);
+
+    fail_if (mock_compositor_count (mc, DAMAGE_MESSAGE) != 1,
+             "hildon-remote-texture: %u damage messages sent instead of 1",
+             mock_compositor_count (mc, DAMAGE_MESSAGE));
+    fail_if (!damage_received (0, 0, 330, 330),
+             "hildon-remote-texture: The bounding box of the damage was not sent");
+}
+END_TEST
+
+/**
+   Purpose: test that swapping buffers tells the compositor about the
+   shared memory area shown.
+
+   Checks for:
+
+   - With two buffers, each swap sends the size and depth of the area.
+   - The key sent alternates between two areas.
+   - The first swap on each buffer damages all of it, and later ones
+     only the area given.
+*/
+START_TEST (test_hildon_remote_texture_swap_buffers)
+{
+    const cairo_rectangle_int_t damage = { 8, 4, 16, 8 };
+    const MockMessage *message;
+    glong keys[3];
+    gint i;
+
+    fail_if (!hildon_remote_texture_alloc_buffers (texture, 64, 32, 2),
+             "hildon-remote-texture: Could not allocate the buffers");
+
+    for (i = 0; i < 3; i++)
+      {
+        fail_if (hildon_remote_texture_get_buffer (texture) == NULL,
+                 "hildon-remote-texture: No buffer to draw into");
+
+        mock_compositor_clear (mc);
+        hildon_remote_texture_swap_buffers (texture, &damage);
+        fail_if (!mock_compositor_wait (mc, SHM_MESSAGE, 1, WAIT_MSECS),
+                 "hildon-remote-texture: Swap %d did not send the memory area", i);
+        mock_compositor_settle (mc);
+
+        message = mock_compositor_last (mc, SHM_MESSAGE);
+        fail_if (message->l[1] != 64 || message->l[2] != 32 || message->l[3] != 4,
+                 "hildon-remote-texture: Area sent as %ldx%ld, %ld bytes per pixel "
+                 "instead of 64x32, 4 bytes per pixel",
+                 message->l[1], message->l[2], message->l[3]);
+        keys[i] = message->l[0];
+
+        fail_if (mock_compositor_count (mc, DAMAGE_MESSAGE) != 1,
+                 "hildon-remote-texture: Swap %d sent %u damage messages instead of 1",
+                 i, mock_compositor_count (mc, DAMAGE_MESSAGE));
+        if (i < 2)
+          fail_if (!damage_received (0, 0, 64, 32),
+                   "hildon-remote-texture: Swap %d did not damage the whole area", i);
+        else
+          fail_if (!damage_received (8, 4, 16, 8),
+                   "hildon-remote-texture: Swap %d did not only damage the area given", i);
+      }
+
+    fail_if (keys[0] == keys[1],
+             "hildon-remote-texture: Both buffers were sent with the key %ld", keys[0]);
+    fail_if (keys[0] != keys[2],
+             "hildon-remote-texture: The third swap sent the key %ld instead of %ld",
+             keys[2], keys[0]);
+}
+END_TEST
+
+/* ---------- Suite creation ---------- */
+
+Suite *create_hildon_remote_texture_suite (void)
+{
+    Suite *s = suite_create ("HildonRemoteTexture");
+
+    TCase *tc1 = tcase_create ("hildon_remote_texture_protocol");
+    tcase_add_checked_fixture (tc1, fx_setup, fx_teardown);
+    tcase_add_test (tc1, test_hildon_remote_texture_damage_coalescing);
+    tcase_add_test (tc1, test_hildon_remote_texture_damage_cap);
+    tcase_add_test (tc1, test_hildon_remote_texture_swap_buffers);
+    suite_add_tcase (s, tc1);
+
+    return s;
+}
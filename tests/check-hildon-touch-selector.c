@@ -0,0 +1,358 @@
+/*
+ * This file is a part of hildon tests
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <check.h>
+#include "test_suites.h"
+#include "check_utils.h"
+#include <hildon/hildon.h>
+
+static GtkWidget *window = NULL;
+static HildonTouchSelector *selector = NULL;
+static HildonLiveSearch *livesearch = NULL;
+static GtkTreeView *tree_view = NULL;
+
+static const gchar *texts[] = { "Red apple", "Banana", "Green apple", "Apricot" };
+
+static void
+find_descendant (GtkWidget *widget, gpointer data)
+{
+    GtkWidget **found = data;
+
+    if (*found != NULL)
+        return;
+
+    if (G_TYPE_CHECK_INSTANCE_TYPE (widget, GPOINTER_TO_SIZE (found[1])))
+        *found = widget;
+    else if (GTK_IS_CONTAINER (widget))
+        gtk_container_forall (GTK_CONTAINER (widget), find_descendant, data);
+}
+
+/* Returns the first widget of type @type inside of @widget */
+static GtkWidget *
+get_descendant (GtkWidget *widget, GType type)
+{
+    gpointer found[2] = { NULL, GSIZE_TO_POINTER (type) };
+
+    gtk_container_forall (GTK_CONTAINER (widget), find_descendant, found);
+
+    return found[0];
+}
+
+static void
+fx_setup ()
+{
+    int argc = 0;
+    guint i;
+
+    gtk_init (&argc, NULL);
+
+    window = create_test_window ();
+
+    selector = HILDON_TOUCH_SELECTOR (hildon_touch_selector_new_text ());
+    for (i = 0; i < G_N_ELEMENTS (texts); i++)
+        hildon_touch_selector_append_text (selector, texts[i]);
+
+    gtk_container_add (GTK_CONTAINER (window), GTK_WIDGET (selector));
+
+    livesearch = HILDON_LIVE_SEARCH (get_descendant (GTK_WIDGET (selector),
+                                                     HILDON_TYPE_LIVE_SEARCH));
+    tree_view = GTK_TREE_VIEW (get_descendant (GTK_WIDGET (selector),
+                                               GTK_TYPE_TREE_VIEW));
+    fail_if (livesearch == NULL || tree_view == NULL,
+             "hildon-touch-selector: No live search in a text selector");
+}
+
+static void
+fx_teardown ()
+{
+    gtk_widget_destroy (window);
+}
+
+static void
+fx_setup_shared ()
+{
+    int argc = 0;
+
+    gtk_init (&argc, NULL);
+}
+
+static void
+run_pending ()
+{
+    guint i;
+
+    for (i = 0; i < 10000 && g_main_context_pending (NULL); i++)
+        g_main_context_iteration (NULL, FALSE);
+}
+
+/* Returns the rows shown by the column, separated by commas */
+static gchar *
+get_visible_rows ()
+{
+    GtkTreeModel *model = gtk_tree_view_get_model (tree_view);
+    GString *rows = g_string_new (NULL);
+    GtkTreeIter iter;
+    gboolean valid;
+
+    for (valid = gtk_tree_model_get_iter_first (model, &iter);
+         valid;
+         valid = gtk_tree_model_iter_next (model, &iter)) {
+        gchar *text;
+
+        gtk_tree_model_get (model, &iter, 0, &text, -1);
+        if (rows->len > 0)
+            g_string_append (rows, ",");
+        g_string_append (rows, text);
+        g_free (text);
+    }
+
+    return g_string_free (rows, FALSE);
+}
+
+static void
+check_search (const gchar *text, const gchar *expected)
+{
+    gchar *rows;
+
+    hildon_live_search_set_text (livesearch, text);
+    run_pending ();
+
+    rows = get_visible_rows ();
+    fail_if (strcmp (rows, expected) != 0,
+             "hildon-touch-selector: Searching \"%s\" shows \"%s\" instead of \"%s\"",
+             text, rows, expected);
+    g_free (rows);
+}
+
+/**
+   Purpose: test that searching right after the column is created finds
+   the same rows as once the selector has been idle.
+
+   Checks for:
+
+   - Searching before the main loop ran once matches the start of
+     every word of the rows, ignoring case.
+   - Searching again after that gives the same rows, and clearing the
+     text shows all of them.
+*/
+START_TEST (test_hildon_touch_selector_search_before_idle)
+{
+    check_search ("ap", "Red apple,Green apple,Apricot");
+    check_search ("ap", "Red apple,Green apple,Apricot");
+    check_search ("", "Red apple,Banana,Green apple,Apricot");
+}
+END_TEST
+
+/**
+   Purpose: test that the search follows the changes made to the model
+   after the column is created.
+
+   Checks for:
+
+   - Rows inserted, changed and removed are searched with their new
+     contents.
+*/
+START_TEST (test_hildon_touch_selector_search_model_changes)
+{
+    GtkListStore *store;
+    GtkTreeIter iter;
+
+    show_all_test_window (window);
+    run_pending ();
+
+    store = GTK_LIST_STORE (hildon_touch_selector_get_model (selector, 0));
+
+    hildon_touch_selector_prepend_text (selector, "Apple pie");
+    check_search ("ap", "Apple pie,Red apple,Green apple,Apricot");
+    check_search ("", "Apple pie,Red apple,Banana,Green apple,Apricot");
+
+    gtk_tree_model_iter_nth_child (GTK_TREE_MODEL (store), &iter, NULL, 3);
+    gtk_list_store_set (store, &iter, 0, "Blue banana", -1);
+    check_search ("ba", "Banana,Blue banana");
+    check_search ("", "Apple pie,Red apple,Banana,Blue banana,Apricot");
+
+    gtk_tree_model_iter_nth_child (GTK_TREE_MODEL (store), &iter, NULL, 0);
+    gtk_list_store_remove (store, &iter);
+    check_search ("ap", "Red apple,Apricot");
+}
+END_TEST
+
+/**
+   Purpose: test that the date and time selectors don't assume that all
+   their rows have the same height.
+
+   Checks for:
+
+   - HildonTouchSelector:fixed-row-height is %FALSE in a new
+     HildonDateSelector and a new HildonTimeSelector.
+*/
+START_TEST (test_hildon_touch_selector_date_time_row_height)
+{
+    GtkWidget *date_selector = hildon_date_selector_new ();
+    GtkWidget *time_selector = hildon_time_selector_new ();
+
+    g_object_ref_sink (date_selector);
+    g_object_ref_sink (time_selector);
+
+    fail_if (hildon_touch_selector_get_fixed_row_height (HILDON_TOUCH_SELECTOR (date_selector)),
+             "hildon-touch-selector: The date selector has a fixed row height");
+    fail_if (hildon_touch_selector_get_fixed_row_height (HILDON_TOUCH_SELECTOR (time_selector)),
+             "hildon-touch-selector: The time selector has a fixed row height");
+
+    gtk_widget_destroy (date_selector);
+    gtk_widget_destroy (time_selector);
+    g_object_unref (date_selector);
+    g_object_unref (time_selector);
+}
+END_TEST
+
+/* Checks that each column of @a and @b has a filter of its own over a
+   model that both share, and returns the position of the column with
+   @n_rows rows in the shared model, or -1 */
+static gint
+check_shared_columns (HildonTouchSelector *a, HildonTouchSelector *b,
+                      gint n_rows)
+{
+    gint i, found = -1;
+
+    fail_if (hildon_touch_selector_get_num_columns (a) !=
+             hildon_touch_selector_get_num_columns (b),
+             "hildon-touch-selector: Two selectors of the same kind have "
+             "different columns");
+
+    for (i = 0; i < hildon_touch_selector_get_num_columns (a); i++) {
+        GtkTreeModel *model_a = hildon_touch_selector_get_model (a, i);
+        GtkTreeModel *model_b = hildon_touch_selector_get_model (b, i);
+        GtkTreeModel *shared;
+
+        fail_if (!GTK_IS_TREE_MODEL_FILTER (model_a) ||
+                 !GTK_IS_TREE_MODEL_FILTER (model_b),
+                 "hildon-touch-selector: Column %d has no filter", i);
+        fail_if (model_a == model_b,
+                 "hildon-touch-selector: Column %d has the same filter in both "
+                 "selectors", i);
+
+        shared = gtk_tree_model_filter_get_model (GTK_TREE_MODEL_FILTER (model_a));
+        fail_if (shared != gtk_tree_model_filter_get_model (GTK_TREE_MODEL_FILTER (model_b)),
+                 "hildon-touch-selector: Column %d doesn't share its model", i);
+
+        if (gtk_tree_model_iter_n_children (shared, NULL) == n_rows)
+            found = i;
+    }
+
+    return found;
+}
+
+/**
+   Purpose: test that the date selectors share their rows, but each
+   shows them through a filter of its own.
+
+   Checks for:
+
+   - Each column of two date selectors is a different filter over the
+     same model.
+   - Showing February in one of them hides the last days of the month
+     from its day column only.
+*/
+START_TEST (test_hildon_touch_selector_shared_date_models)
+{
+    GtkWidget *a = hildon_date_selector_new_with_year_range (2000, 2020);
+    GtkWidget *b = hildon_date_selector_new_with_year_range (2000, 2020);
+    GtkTreeModel *days_a, *days_b;
+    gint day_column;
+
+    g_object_ref_sink (a);
+    g_object_ref_sink (b);
+
+    day_column = check_shared_columns (HILDON_TOUCH_SELECTOR (a),
+                                       HILDON_TOUCH_SELECTOR (b), 31);
+    fail_if (day_column < 0,
+             "hildon-touch-selector: No column with the 31 days");
+
+    hildon_date_selector_select_current_date (HILDON_DATE_SELECTOR (a), 2009, 1, 10);
+    hildon_date_selector_select_current_date (HILDON_DATE_SELECTOR (b), 2009, 0, 10);
+
+    days_a = hildon_touch_selector_get_model (HILDON_TOUCH_SELECTOR (a), day_column);
+    days_b = hildon_touch_selector_get_model (HILDON_TOUCH_SELECTOR (b), day_column);
+    fail_if (gtk_tree_model_iter_n_children (days_a, NULL) != 28,
+             "hildon-touch-selector: %d days shown for February 2009 instead of 28",
+             gtk_tree_model_iter_n_children (days_a, NULL));
+    fail_if (gtk_tree_model_iter_n_children (days_b, NULL) != 31,
+             "hildon-touch-selector: %d days shown for January 2009 instead of 31",
+             gtk_tree_model_iter_n_children (days_b, NULL));
+
+    gtk_widget_destroy (a);
+    gtk_widget_destroy (b);
+    g_object_unref (a);
+    g_object_unref (b);
+}
+END_TEST
+
+/**
+   Purpose: test that the time selectors share their rows, but each
+   shows them through a filter of its own.
+
+   Checks for:
+
+   - Each column of two time selectors is a different filter over the
+     same model, and one of them has the 60 minutes.
+*/
+START_TEST (test_hildon_touch_selector_shared_time_models)
+{
+    GtkWidget *a = hildon_time_selector_new ();
+    GtkWidget *b = hildon_time_selector_new ();
+
+    g_object_ref_sink (a);
+    g_object_ref_sink (b);
+
+    fail_if (check_shared_columns (HILDON_TOUCH_SELECTOR (a),
+                                   HILDON_TOUCH_SELECTOR (b), 60) < 0,
+             "hildon-touch-selector: No column with the 60 minutes");
+
+    gtk_widget_destroy (a);
+    gtk_widget_destroy (b);
+    g_object_unref (a);
+    g_object_unref (b);
+}
+END_TEST
+
+/* ---------- Suite creation ---------- */
+
+Suite *create_hildon_touch_selector_suite (void)
+{
+    Suite *s = suite_create ("HildonTouchSelector");
+
+    TCase *tc1 = tcase_create ("hildon_touch_selector_live_search");
+    tcase_add_checked_fixture (tc1, fx_setup, fx_teardown);
+    tcase_add_test (tc1, test_hildon_touch_selector_search_before_idle);
+    tcase_add_test (tc1, test_hildon_touch_selector_search_model_changes);
+    tcase_add_test (tc1, test_hildon_touch_selector_date_time_row_height);
+    suite_add_tcase (s, tc1);
+
+    TCase *tc2 = tcase_create ("hildon_touch_selector_shared_models");
+    tcase_add_checked_fixture (tc2, fx_setup_shared, NULL);
+    tcase_add_test (tc2, test_hildon_touch_selector_shared_date_models);
+    tcase_add_test (tc2, test_hildon_touch_selector_shared_time_models);
+    suite_add_tcase (s, tc2);
+
+    return s;
+}
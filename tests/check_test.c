@@ -87,6 +87,13 @@ configure_tests(gint environment)
   srunner_add_suite(sr, create_hildon_window_suite());
   srunner_add_suite(sr, create_hildon_helper_suite());
   srunner_add_suite(sr, create_hildon_picker_button_suite());
+  srunner_add_suite(sr, create_hildon_animation_actor_suite());
+  srunner_add_suite(sr, create_hildon_remote_texture_suite());
+  srunner_add_suite(sr, create_hildon_pannable_area_suite());
+  srunner_add_suite(sr, create_hildon_live_search_suite());
+  srunner_add_suite(sr, create_hildon_touch_selector_suite());
+  srunner_add_suite(sr, create_hildon_color_chooser_raster_suite());
+  srunner_add_suite(sr, create_hildon_calendar_suite());
 
   /* Disable tests that need maemo environment to be up if it is not running */
   if (environment != ENVIRONMENT_MAEMO_ERROR)
@@ -0,0 +1,259 @@
+/*
+ * This file is a part of hildon tests
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+/*
+ * A stand-in for the hildon-desktop side of the HildonAnimationActor
+ * and HildonRemoteTexture protocol, to run the tests and benchmarks
+ * under Xvfb without a device.
+ *
+ * It uses an X connection of its own, like a real compositor would.
+ * It sets the ready property on the windows it manages, and records
+ * the client messages sent to them with the time they arrived.
+ * Setting the ready property again while it is still set is what a
+ * restarted hildon-desktop does, so that is how a restart is emulated.
+ */
+
+#include <X11/Xatom.h>
+#include <gdk/gdkx.h>
+
+#include "mock-compositor.h"
+
+/* Polling step while waiting for messages */
+#define MOCK_POLL_USECS 1000
+
+/* How long nothing must arrive for mock_compositor_settle() to return */
+#define MOCK_SETTLE_MSECS 50
+
+static gboolean
+mock_compositor_io (GIOChannel *source, GIOCondition condition, gpointer data)
+{
+  mock_compositor_process (data);
+
+  return TRUE;
+}
+
+/**
+ * Opens a connection of its own to the X server. Returns NULL if there
+ * is no display.
+ */
+MockCompositor *
+mock_compositor_new (void)
+{
+  MockCompositor *mc;
+  Display *display;
+  GIOChannel *channel;
+
+  display = XOpenDisplay (NULL);
+  if (display == NULL)
+    return NULL;
+
+  mc = g_new0 (MockCompositor, 1);
+  mc->display = display;
+  mc->messages = g_array_new (FALSE, FALSE, sizeof (MockMessage));
+
+  /* Record the messages as they arrive while the main loop runs, so
+     that their time is the one they were received at */
+  channel = g_io_channel_unix_new (ConnectionNumber (display));
+  mc->watch_id = g_io_add_watch (channel, G_IO_IN, mock_compositor_io, mc);
+  g_io_channel_unref (channel);
+
+  return mc;
+}
+
+void
+mock_compositor_free (MockCompositor *mc)
+{
+  g_source_remove (mc->watch_id);
+  g_array_free (mc->messages, TRUE);
+  XCloseDisplay (mc->display);
+  g_free (mc);
+}
+
+/**
+ * Starts receiving the client messages sent to the window of @widget,
+ * realizing it if needed. The window is not ready yet.
+ */
+void
+mock_compositor_manage (MockCompositor *mc, GtkWidget *widget)
+{
+  gtk_widget_realize (widget);
+
+  XSelectInput (mc->display,
+                GDK_WINDOW_XID (gtk_widget_get_window (widget)),
+                StructureNotifyMask);
+  XSync (mc->display, False);
+}
+
+/**
+ * Sets the @ready property on the window of @widget, as hildon-desktop
+ * does once it has set up its side of the actor or texture.
+ */
+void
+mock_compositor_set_ready (MockCompositor *mc, GtkWidget *widget,
+                           const gchar *ready)
+{
+  Atom atom = XInternAtom (mc->display, ready, False);
+
+  XChangeProperty (mc->display,
+                   GDK_WINDOW_XID (gtk_widget_get_window (widget)),
+                   atom, XA_ATOM, 32, PropModeReplace,
+                   (unsigned char *) &atom, 1);
+  XSync (mc->display, False);
+}
+
+/**
+ * Emulates a restart of hildon-desktop: the new instance finds the
+ * ready property already set and sets it again. The client is then
+ * expected to remap the window and send all of its state anew.
+ */
+void
+mock_compositor_restart (MockCompositor *mc, GtkWidget *widget,
+                         const gchar *ready)
+{
+  mock_compositor_set_ready (mc, widget, ready);
+}
+
+/**
+ * Records the client messages received so far.
+ */
+void
+mock_compositor_process (MockCompositor *mc)
+{
+  while (XPending (mc->display))
+    {
+      XEvent event;
+
+      XNextEvent (mc->display, &event);
+
+      if (event.type == ClientMessage)
+        {
+          MockMessage message;
+          guint i;
+
+          message.window = event.xclient.window;
+          message.type = event.xclient.message_type;
+          for (i = 0; i < 5; i++)
+            message.l[i] = event.xclient.data.l[i];
+          message.time = g_get_monotonic_time ();
+
+          g_array_append_val (mc->messages, message);
+        }
+    }
+}
+
+/* Runs the main loop once and makes sure that whatever the client
+   sent has reached the compositor. Returns TRUE if anything happened. */
+static gboolean
+mock_compositor_iterate (MockCompositor *mc)
+{
+  guint before = mc->messages->len;
+  gboolean dispatched;
+
+  dispatched = g_main_context_iteration (NULL, FALSE);
+
+  gdk_display_sync (gdk_display_get_default ());
+  XSync (mc->display, False);
+  mock_compositor_process (mc);
+
+  return dispatched || mc->messages->len != before;
+}
+
+/**
+ * Runs the main loop until no more messages arrive.
+ */
+void
+mock_compositor_settle (MockCompositor *mc)
+{
+  gint64 quiet_since = g_get_monotonic_time ();
+
+  while (g_get_monotonic_time () - quiet_since < MOCK_SETTLE_MSECS * 1000)
+    {
+      if (mock_compositor_iterate (mc))
+        quiet_since = g_get_monotonic_time ();
+      else
+        g_usleep (MOCK_POLL_USECS);
+    }
+}
+
+/**
+ * Runs the main loop until @count messages of @type were received in
+ * total, or @timeout_ms passed. Returns whether they were received.
+ */
+gboolean
+mock_compositor_wait (MockCompositor *mc, const gchar *type, guint count,
+                      guint timeout_ms)
+{
+  gint64 end = g_get_monotonic_time () + (gint64) timeout_ms * 1000;
+
+  while (mock_compositor_count (mc, type) < count)
+    {
+      if (g_get_monotonic_time () > end)
+        return FALSE;
+
+      if (!mock_compositor_iterate (mc))
+        g_usleep (MOCK_POLL_USECS);
+    }
+
+  return TRUE;
+}
+
+/**
+ * Returns the number of messages of @type received, or of all the
+ * messages if @type is NULL.
+ */
+guint
+mock_compositor_count (MockCompositor *mc, const gchar *type)
+{
+  Atom atom;
+  guint i, n = 0;
+
+  if (type == NULL)
+    return mc->messages->len;
+
+  atom = XInternAtom (mc->display, type, False);
+
+  for (i = 0; i < mc->messages->len; i++)
+    if (g_array_index (mc->messages, MockMessage, i).type == atom)
+      n++;
+
+  return n;
+}
+
+/**
+ * Returns the last message of @type received, or NULL.
+ */
+const MockMessage *
+mock_compositor_last (MockCompositor *mc, const gchar *type)
+{
+  Atom atom = XInternAtom (mc->display, type, False);
+  guint i;
+
+  for (i = mc->messages->len; i > 0; i--)
+    if (g_array_index (mc->messages, MockMessage, i - 1).type == atom)
+      return &g_array_index (mc->messages, MockMessage, i - 1);
+
+  return NULL;
+}
+
+void
+mock_compositor_clear (MockCompositor *mc)
+{
+  g_array_set_size (mc->messages, 0);
+}
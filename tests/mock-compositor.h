@@ -0,0 +1,70 @@
+/*
+ * This file is a part of hildon tests
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+#ifndef _MOCK_COMPOSITOR_H_
+#define _MOCK_COMPOSITOR_H_
+
+#include <gtk/gtk.h>
+#include <X11/Xlib.h>
+
+#define MOCK_ANIMATION_ACTOR_READY "_HILDON_ANIMATION_CLIENT_READY"
+#define MOCK_REMOTE_TEXTURE_READY  "_HILDON_TEXTURE_CLIENT_READY"
+
+/* A client message as the compositor received it */
+typedef struct {
+  Window window;
+  Atom   type;
+  long   l[5];
+  gint64 time;
+} MockMessage;
+
+typedef struct {
+  Display *display;
+  GArray  *messages;
+  guint    watch_id;
+} MockCompositor;
+
+MockCompositor *mock_compositor_new     (void);
+void            mock_compositor_free    (MockCompositor *mc);
+
+void            mock_compositor_manage  (MockCompositor *mc,
+                                         GtkWidget      *widget);
+void            mock_compositor_set_ready (MockCompositor *mc,
+                                           GtkWidget      *widget,
+                                           const gchar    *ready);
+void            mock_compositor_restart (MockCompositor *mc,
+                                         GtkWidget      *widget,
+                                         const gchar    *ready);
+
+void            mock_compositor_process (MockCompositor *mc);
+void            mock_compositor_settle  (MockCompositor *mc);
+gboolean        mock_compositor_wait    (MockCompositor *mc,
+                                         const gchar    *type,
+                                         guint           count,
+                                         guint           timeout_ms);
+
+guint           mock_compositor_count   (MockCompositor *mc,
+                                         const gchar    *type);
+const MockMessage *
+                mock_compositor_last    (MockCompositor *mc,
+                                         const gchar    *type);
+void            mock_compositor_clear   (MockCompositor *mc);
+
+#endif
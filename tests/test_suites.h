@@ -63,5 +63,12 @@ Suite *create_hildon_window_suite(void);
 Suite *create_hildon_program_suite(void);
 Suite *create_hildon_composite_widget_suite(void);
 Suite *create_hildon_picker_button_suite (void);
+Suite *create_hildon_animation_actor_suite (void);
+Suite *create_hildon_pannable_area_suite (void);
+Suite *create_hildon_remote_texture_suite (void);
+Suite *create_hildon_live_search_suite (void);
+Suite *create_hildon_touch_selector_suite (void);
+Suite *create_hildon_color_chooser_raster_suite (void);
+Suite *create_hildon_calendar_suite (void);
 
 #endif